@@ -0,0 +1,148 @@
+// Burst capture: trigger placement, what arming and capturing add to a tick,
+// and tick times while another thread keeps reading captures out.
+//
+//   capture_bench [ticks]
+//
+// 1. An inline-4 at 3000 rpm and 80% load is stepped with capture off,
+//    armed on a threshold the signal never reaches, and rearmed on every
+//    rising crossing of the mean engine torque. The mean and worst step time
+//    of each case are printed.
+// 2. The same rearmed trigger runs while a reader thread keeps encoding
+//    the newest capture. Every frame read is checked: the trigger sample is
+//    the first one at or above the threshold, and samples are spaced one
+//    substep apart in crank angle.
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include "PhysicsEngine.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct TickTimes {
+    double meanUs = 0.0;
+    double worstUs = 0.0;
+};
+
+TickTimes run(TwinEngine& engine, int ticks) {
+    TickTimes t;
+    for (int i = 0; i < ticks; ++i) {
+        const auto start = Clock::now();
+        engine.step();
+        const double us = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+        t.meanUs += us;
+        t.worstUs = std::max(t.worstUs, us);
+    }
+    t.meanUs /= ticks;
+    return t;
+}
+
+protocol::CaptureTrigger torqueCrossing(float threshold, bool rearm) {
+    protocol::CaptureTrigger trigger;
+    trigger.kind = protocol::CaptureTrigger::Kind::Level;
+    trigger.edge = protocol::CaptureTrigger::Edge::Rising;
+    trigger.signal = protocol::CaptureSignal::EngineTorqueNm;
+    trigger.threshold = threshold;
+    trigger.preSamples = 1000;
+    trigger.postSamples = 1000;
+    trigger.rearm = rearm;
+    return trigger;
+}
+
+// Checks one frame from encode(); returns false and says why on a bad one.
+bool checkFrame(const std::vector<uint8_t>& frame, std::size_t len, float threshold, float dtS) {
+    uint32_t magic, count, triggerIndex;
+    std::memcpy(&magic, frame.data(), 4);
+    std::memcpy(&count, frame.data() + 8, 4);
+    std::memcpy(&triggerIndex, frame.data() + 12, 4);
+    if (magic != protocol::kCaptureFrameMagic || len != protocol::captureFrameBytes(count)) {
+        std::printf("  bad header\n");
+        return false;
+    }
+    if (count == 0) return true;
+    std::vector<protocol::CaptureSample> samples(count);
+    std::memcpy(samples.data(), frame.data() + protocol::kCaptureHeaderBytes, count * protocol::kCaptureRecordBytes);
+
+    const float before = samples[triggerIndex - 1].engineTorqueNm;
+    const float at = samples[triggerIndex].engineTorqueNm;
+    if (!(before < threshold && at >= threshold)) {
+        std::printf("  trigger at %u: %.3f -> %.3f does not cross %.3f\n", triggerIndex,
+                    static_cast<double>(before), static_cast<double>(at), static_cast<double>(threshold));
+        return false;
+    }
+    for (uint32_t i = 1; i < count; ++i) {
+        float dAngle = samples[i].cycleAngleRad - samples[i - 1].cycleAngleRad;
+        if (dAngle < 0.0f) dAngle += EngineLayout::kCycleRad;
+        const float expected = samples[i].omegaRadS * dtS;
+        if (std::abs(dAngle - expected) > 1e-3f + 0.02f * expected) {
+            std::printf("  sample %u: step %.5f rad, expected %.5f\n", i, static_cast<double>(dAngle),
+                        static_cast<double>(expected));
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int ticks = (argc > 1) ? std::atoi(argv[1]) : 3000;
+    if (ticks <= 0) ticks = 3000;
+
+    PhysicsEngine engine(TwinEngine::kDefaultPhysicsRateHz, EngineLayout::inline4());
+    engine.setRpmTarget(3000.0f);
+    engine.setLoad(0.8f);
+    engine.enableCapture();
+    for (int t = 0; t < 500; ++t) engine.step();
+    const float meanTorque = engine.snapshot().engineTorqueStats.mean;
+    BurstCapture& capture = *engine.capture();
+
+    // 1. Cost on the physics thread.
+    const TickTimes off = run(engine, ticks);
+    capture.arm(torqueCrossing(1e9f, false));
+    const TickTimes idle = run(engine, ticks);
+    capture.arm(torqueCrossing(meanTorque, true));
+    const uint64_t before = capture.completed();
+    const TickTimes capturing = run(engine, ticks);
+    const uint64_t captured = capture.completed() - before;
+    capture.disarm();
+    std::printf("inline4 step at 3000 rpm (us/tick, mean / worst):\n");
+    std::printf("  capture off      %6.1f / %6.1f\n", off.meanUs, off.worstUs);
+    std::printf("  armed, no event  %6.1f / %6.1f\n", idle.meanUs, idle.worstUs);
+    std::printf("  rearmed          %6.1f / %6.1f  (%llu captures of 2000 substeps)\n", capturing.meanUs,
+                capturing.worstUs, static_cast<unsigned long long>(captured));
+
+    // 2. A reader pulling captures out while the physics thread runs.
+    capture.arm(torqueCrossing(meanTorque, true));
+    std::atomic<bool> done{false};
+    std::size_t frames = 0, empty = 0, bad = 0;
+    double readUs = 0.0;
+    std::thread reader([&] {
+        std::vector<uint8_t> frame;
+        while (!done.load(std::memory_order_relaxed)) {
+            const auto start = Clock::now();
+            const std::size_t len = capture.encode(0, frame);
+            readUs += std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+            ++frames;
+            uint32_t count;
+            std::memcpy(&count, frame.data() + 8, 4);
+            if (count == 0) ++empty;
+            else if (!checkFrame(frame, len, meanTorque, capture.dtS())) ++bad;
+            std::this_thread::yield();
+        }
+    });
+    const TickTimes contended = run(engine, ticks);
+    done.store(true, std::memory_order_relaxed);
+    reader.join();
+    std::printf("  rearmed + reader %6.1f / %6.1f\n", contended.meanUs, contended.worstUs);
+    std::printf("reader: %zu frames (%zu before the first capture), %zu bad, %.1f us per encode\n",
+                frames, empty, bad, frames ? readUs / static_cast<double>(frames) : 0.0);
+    return bad == 0 ? 0 : 1;
+}
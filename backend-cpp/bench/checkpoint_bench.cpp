@@ -0,0 +1,147 @@
+// Checkpoints: encode, write, restore and fork cost of a warmed-up twin.
+//
+//   checkpoint_bench [path]
+//
+// An inline-4 at 10 kHz under torque dynamics runs 12 s of ticks, so both
+// histories are full, then is checkpointed to `path` (default
+// checkpoint_bench.twck, removed afterwards). Printed: the checkpoint size,
+// the stepping thread's encode time, seal plus write, read plus restore into
+// a new twin, and fork(). The restored twin and the fork then step beside the
+// original for 2 s; their snapshots must match it bit for bit. Last, 3 s of
+// the server's 100 Hz loop each without a writer and with a CheckpointWriter
+// offered every tick: p50/p99/max of step() plus offer().
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+#include "EngineRegistry.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using Micros = std::chrono::duration<double, std::micro>;
+
+constexpr float kRate = 10000.0f;
+
+std::unique_ptr<TwinEngine> makeEngine() {
+    auto engine = EngineRegistry::create(DefaultGeometry::kName, kRate, EngineLayout::inline4());
+    engine->setDynamics(SpeedModel::Torque);
+    return engine;
+}
+
+// Best of `reps`, in microseconds.
+template <typename Fn>
+double bestUs(int reps, Fn&& fn) {
+    double best = 1e300;
+    for (int r = 0; r < reps; ++r) {
+        const auto start = Clock::now();
+        fn();
+        best = std::min(best, Micros(Clock::now() - start).count());
+    }
+    return best;
+}
+
+// Everything but the wall-clock timestamp.
+bool sameState(const TwinEngine& a, const TwinEngine& b) {
+    protocol::StatePayload x = a.snapshot();
+    protocol::StatePayload y = b.snapshot();
+    x.timestampMs = y.timestampMs = 0;
+    return std::memcmp(&x, &y, sizeof(x)) == 0;
+}
+
+struct StepLatency {
+    double p50Us, p99Us, maxUs;
+};
+
+StepLatency stepLatency(TwinEngine& engine, int ticks, CheckpointWriter* writer) {
+    std::vector<double> steps;
+    steps.reserve(static_cast<std::size_t>(ticks));
+    auto deadline = Clock::now();
+    for (int t = 0; t < ticks; ++t) {
+        const auto start = Clock::now();
+        engine.step();
+        if (writer) writer->offer(engine);
+        steps.push_back(Micros(Clock::now() - start).count());
+        deadline += std::chrono::milliseconds(10);
+        std::this_thread::sleep_until(deadline);
+    }
+    std::sort(steps.begin(), steps.end());
+    return {steps[steps.size() / 2], steps[steps.size() * 99 / 100], steps.back()};
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::string path = (argc > 1) ? argv[1] : "checkpoint_bench.twck";
+
+    auto live = makeEngine();
+    live->setRpmTarget(3000.0f);
+    live->setLoad(0.8f);
+    for (int t = 0; t < 1200; ++t) live->step();
+    std::printf("inline4 at 10 kHz, torque dynamics, %zu history ticks, %llu revolutions\n",
+                live->history().size(), static_cast<unsigned long long>(live->revolutions()));
+
+    std::vector<uint8_t> checkpoint;
+    live->saveCheckpoint(checkpoint);
+    const double encodeUs = bestUs(50, [&] { live->saveCheckpoint(checkpoint); });
+    std::printf("  checkpoint        %8zu bytes\n", checkpoint.size());
+    std::printf("  encode            %8.1f us   (stepping thread)\n", encodeUs);
+
+    std::string error;
+    const double writeUs = bestUs(10, [&] {
+        if (!Checkpoint::write(path, checkpoint, &error)) std::fprintf(stderr, "%s\n", error.c_str());
+    });
+    std::printf("  seal + write      %8.1f us\n", writeUs);
+
+    auto restored = makeEngine();
+    std::vector<uint8_t> file;
+    bool restoredOk = false;
+    const double restoreUs = bestUs(10, [&] {
+        restoredOk = Checkpoint::read(path, file, &error) && restored->restoreCheckpoint(file, &error);
+    });
+    if (!restoredOk) {
+        std::fprintf(stderr, "restore failed: %s\n", error.c_str());
+        return 1;
+    }
+    std::printf("  read + restore    %8.1f us\n", restoreUs);
+
+    std::unique_ptr<TwinEngine> fork;
+    const double forkUs = bestUs(10, [&] { fork = live->fork(); });
+    if (!fork) {
+        std::fprintf(stderr, "fork failed\n");
+        return 1;
+    }
+    std::printf("  fork              %8.1f us\n", forkUs);
+    std::filesystem::remove(path);
+
+    bool match = sameState(*live, *restored) && sameState(*live, *fork);
+    live->setRpmTarget(4500.0f);
+    restored->setRpmTarget(4500.0f);
+    fork->setRpmTarget(4500.0f);
+    for (int t = 0; t < 200 && match; ++t) {
+        live->step();
+        restored->step();
+        fork->step();
+        match = sameState(*live, *restored) && sameState(*live, *fork);
+    }
+    std::printf("  restored and forked twins match the original over 2 s: %s\n", match ? "yes" : "NO");
+
+    const StepLatency plain = stepLatency(*live, 300, nullptr);
+    StepLatency offered;
+    uint64_t written = 0;
+    {
+        CheckpointWriter writer(path);
+        offered = stepLatency(*live, 300, &writer);
+        written = writer.written();
+    }
+    std::filesystem::remove(path);
+    std::printf("  tick p50/p99/max, no writer         %6.1f %6.1f %6.1f us\n", plain.p50Us, plain.p99Us,
+                plain.maxUs);
+    std::printf("  tick p50/p99/max, offer every tick  %6.1f %6.1f %6.1f us  (%llu written)\n", offered.p50Us,
+                offered.p99Us, offered.maxUs, static_cast<unsigned long long>(written));
+    return match ? 0 : 1;
+}
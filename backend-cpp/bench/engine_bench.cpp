@@ -0,0 +1,51 @@
+// PhysicsEngine::step() cost per geometry variant, layout and physics rate.
+//
+//   engine_bench [ticks]
+//
+// Each row steps one engine for the given number of 100 Hz ticks and reports
+// the mean and worst tick time against the 10 ms broadcast budget.
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string_view>
+#include "EngineRegistry.h"
+
+int main(int argc, char** argv) {
+    int ticks = (argc > 1) ? std::atoi(argv[1]) : 2000;
+    if (ticks <= 0) ticks = 2000;
+
+    constexpr std::string_view kLayouts[] = {"single", "inline4", "inline6", "v8"};
+    constexpr float kRates[] = {1000.0f, 10000.0f, 50000.0f};
+
+    std::printf("%12s %10s %10s %10s %12s %12s %12s\n",
+                "variant", "layout", "rate_hz", "substeps", "mean_us", "max_us", "budget");
+
+    for (std::string_view variant : EngineRegistry::kVariants) {
+        for (std::string_view name : kLayouts) {
+            for (float rate : kRates) {
+                auto engine = EngineRegistry::create(variant, rate, *EngineLayout::fromName(name));
+                engine->setRpmTarget(6000.0f);
+
+                using clock = std::chrono::steady_clock;
+                double total = 0.0;
+                double worst = 0.0;
+                for (int t = 0; t < ticks; ++t) {
+                    auto t0 = clock::now();
+                    engine->step();
+                    double us = std::chrono::duration<double, std::micro>(clock::now() - t0).count();
+                    total += us;
+                    worst = std::max(worst, us);
+                }
+                double mean = total / ticks;
+                std::printf("%12.*s %10.*s %10.0f %10u %12.2f %12.2f %11.3f%%\n",
+                            static_cast<int>(variant.size()), variant.data(),
+                            static_cast<int>(name.size()), name.data(), rate,
+                            engine->substepsPerTick(), mean, worst,
+                            100.0 * mean / (TwinEngine::kDt * 1e6));
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,53 @@
+// Fleet throughput benchmark: twins stepped per second as fleet size scales.
+//
+//   fleet_bench [min_seconds_per_size]
+//
+// For each N the fleet is stepped repeatedly until at least the requested
+// wall time has elapsed; the 100 Hz column shows what fraction of the 10 ms
+// broadcast budget one fleet tick consumes.
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "EngineFleet.h"
+
+int main(int argc, char** argv) {
+    double minSeconds = (argc > 1) ? std::atof(argv[1]) : 0.5;
+    if (minSeconds <= 0.0) minSeconds = 0.5;
+
+    const std::vector<std::size_t> sizes = {1, 10, 100, 1000, 10000, 100000};
+
+    std::printf("%10s %12s %16s %14s %12s\n",
+                "twins", "ticks", "twin-steps/s", "us/tick", "100Hz load");
+
+    for (std::size_t n : sizes) {
+        EngineFleet fleet(n);
+        // Spread targets so twins are not all in lock-step.
+        for (std::size_t i = 0; i < n; ++i) {
+            fleet.setRpmTarget(i, 800.0f + static_cast<float>(i % 64) * 110.0f);
+        }
+        // Spin up past the RPM filter transient before timing.
+        for (int i = 0; i < 10; ++i) fleet.step();
+
+        using clock = std::chrono::steady_clock;
+        std::size_t ticks = 0;
+        auto start = clock::now();
+        double elapsed = 0.0;
+        do {
+            fleet.step();
+            ++ticks;
+            elapsed = std::chrono::duration<double>(clock::now() - start).count();
+        } while (elapsed < minSeconds);
+
+        double twinSteps = static_cast<double>(ticks) * static_cast<double>(n);
+        double usPerTick = elapsed * 1e6 / static_cast<double>(ticks);
+        double load = usPerTick / (PhysicsEngine::kDt * 1e6);
+        std::printf("%10zu %12zu %16.3e %14.2f %11.2f%%\n",
+                    n, ticks, twinSteps / elapsed, usPerTick, load * 100.0);
+
+        // Keep the optimizer from discarding the work.
+        volatile float sink = fleet.torqueNm()[n - 1];
+        (void)sink;
+    }
+    return 0;
+}
@@ -0,0 +1,88 @@
+// Sensor ingestion throughput: frame decoding and queue hand-off.
+//
+//   ingest_bench [seconds_of_data] [records_per_frame]
+//
+// A producer thread plays the WebSocket I/O thread, pushing pre-encoded
+// binary frames of a 1 MHz sensor stream (four channels at 250 kHz) into
+// SensorIngest. The main thread plays the physics loop and drains it one
+// 10 ms window at a time as fast as it can. Windows advance whether or not
+// data arrived (as in the wall-clock server loop), so the consumer waits for
+// a window's worth before draining; the producer only waits when the queue is
+// nearly full. The figure is the sustained end-to-end rate.
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include "Protocol.h"
+#include "SensorIngest.h"
+
+int main(int argc, char** argv) {
+    double seconds = (argc > 1) ? std::atof(argv[1]) : 5.0;
+    if (!(seconds > 0.0)) seconds = 5.0;
+    std::size_t perFrame = (argc > 2) ? static_cast<std::size_t>(std::atol(argv[2])) : 256;
+    if (perFrame == 0 || perFrame > protocol::kMaxSensorRecords) perFrame = 256;
+
+    constexpr double kSampleRateHz = 1e6;
+    constexpr float kTickS = 0.01f;
+    const auto total = static_cast<std::size_t>(seconds * kSampleRateHz);
+    const std::size_t frames = (total + perFrame - 1) / perFrame;
+
+    // Encode every frame up front; only decoding and hand-off are timed.
+    const std::size_t frameBytes = protocol::kSensorHeaderBytes + perFrame * protocol::kSensorRecordBytes;
+    std::vector<uint8_t> wire(frames * frameBytes);
+    std::vector<std::size_t> lengths(frames);
+    std::vector<protocol::SensorRecord> records(perFrame);
+    for (std::size_t f = 0; f < frames; ++f) {
+        const std::size_t n = std::min(perFrame, total - f * perFrame);
+        for (std::size_t i = 0; i < n; ++i) {
+            const std::size_t k = f * perFrame + i;
+            records[i].timestampNs = 5'000'000'000ull + static_cast<uint64_t>(static_cast<double>(k) * 1e9 / kSampleRateHz);
+            records[i].kind = static_cast<uint8_t>(k % SensorSample::kKinds);
+            records[i].cylinder = 0;
+            records[i].value = static_cast<float>(k % 1000);
+        }
+        lengths[f] = protocol::encodeSensorFrame(records.data(), n, wire.data() + f * frameBytes);
+    }
+
+    SensorIngest ingest;
+    using clock = std::chrono::steady_clock;
+    const auto start = clock::now();
+
+    std::atomic<bool> produced{false};
+    std::thread producer([&] {
+        for (std::size_t f = 0; f < frames; ++f) {
+            while (ingest.queued() + perFrame > SensorIngest::kQueueCapacity) std::this_thread::yield();
+            ingest.pushFrame(wire.data() + f * frameBytes, lengths[f]);
+        }
+        produced.store(true, std::memory_order_release);
+    });
+
+    const auto perTick = static_cast<std::size_t>(kSampleRateHz * kTickS);
+
+    std::size_t drained = 0;
+    std::size_t ticks = 0;
+    std::size_t largestTick = 0;
+    while (drained < total) {
+        while (ingest.queued() <= perTick && !produced.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+        const auto samples = ingest.drainTick(kTickS);
+        drained += samples.size();
+        largestTick = std::max(largestTick, samples.size());
+        ++ticks;
+    }
+    const double elapsedS = std::chrono::duration<double>(clock::now() - start).count();
+    producer.join();
+
+    std::printf("%zu samples in %zu frames of %zu (%zu bytes), %.3f s wall\n", total, frames, perFrame,
+                frameBytes, elapsedS);
+    std::printf("%.2e samples/s, %.1f MB/s of frames, dropped %llu, malformed %llu\n",
+                static_cast<double>(total) / elapsedS,
+                static_cast<double>(frames * frameBytes) / elapsedS / 1e6,
+                static_cast<unsigned long long>(ingest.dropped()),
+                static_cast<unsigned long long>(ingest.malformed()));
+    std::printf("%zu ticks, largest %zu samples\n", ticks, largestTick);
+    return 0;
+}
@@ -0,0 +1,138 @@
+// Vectorized force kernel: accuracy report and throughput vs. the libm path.
+//
+//   kernel_bench [samples]
+//
+// Accuracy is measured against PhysicsEngine::computeCrankForces(), the
+// exact chain PhysicsEngine::step() runs, over a dense angle × RPM grid.
+// Force errors are normalized by each output's peak magnitude at that RPM,
+// since relative error is meaningless near the zero crossings.
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "CrankKernel.h"
+#include "PhysicsEngine.h"
+
+namespace {
+
+constexpr std::array<const char*, 5> kForceNames = {
+    "piston_force_n", "rod_force_n", "tangential_force_n", "torque_nm", "side_thrust_n"};
+
+std::array<float, 5> asArray(const CrankForces& f) {
+    return {f.pistonForceN, f.rodForceN, f.tangentialForceN, f.torqueNm, f.sideThrustN};
+}
+
+void reportSinCos() {
+    double maxSin = 0.0;
+    double maxCos = 0.0;
+    constexpr int kPoints = 4'000'000;
+    constexpr double kRange = 1e4;
+    for (int i = 0; i <= kPoints; ++i) {
+        float x = static_cast<float>(-kRange + 2.0 * kRange * i / kPoints);
+        float s, c;
+        sinCosApprox(x, s, c);
+        maxSin = std::max(maxSin, std::abs(s - std::sin(static_cast<double>(x))));
+        maxCos = std::max(maxCos, std::abs(c - std::cos(static_cast<double>(x))));
+    }
+    std::printf("sin/cos over |x| <= %.0e rad: max abs error sin=%.3e cos=%.3e\n",
+                kRange, maxSin, maxCos);
+}
+
+void reportForces() {
+    constexpr std::size_t kAngles = 4096;
+    std::vector<float> angle(kAngles), omega(kAngles);
+    std::array<std::vector<float>, 5> out;
+    for (auto& v : out) v.resize(kAngles);
+
+    std::array<double, 5> maxNorm{};
+    std::array<double, 5> maxAbs{};
+
+    for (float rpm = 250.0f; rpm <= PhysicsEngine::kRpmMax; rpm += 250.0f) {
+        float w = rpm * PhysicsEngine::kTwoPi / 60.0f;
+        for (std::size_t i = 0; i < kAngles; ++i) {
+            angle[i] = PhysicsEngine::kTwoPi * static_cast<float>(i) / kAngles;
+            omega[i] = w;
+        }
+        computeCrankForcesBatch(angle.data(), omega.data(), kAngles,
+            {out[0].data(), out[1].data(), out[2].data(), out[3].data(), out[4].data()});
+
+        std::array<double, 5> peak{};
+        std::array<double, 5> err{};
+        for (std::size_t i = 0; i < kAngles; ++i) {
+            auto ref = asArray(PhysicsEngine::computeCrankForces(angle[i], w));
+            for (std::size_t k = 0; k < 5; ++k) {
+                peak[k] = std::max(peak[k], std::abs(static_cast<double>(ref[k])));
+                err[k] = std::max(err[k], std::abs(static_cast<double>(out[k][i]) - ref[k]));
+            }
+        }
+        for (std::size_t k = 0; k < 5; ++k) {
+            maxAbs[k] = std::max(maxAbs[k], err[k]);
+            if (peak[k] > 0.0) maxNorm[k] = std::max(maxNorm[k], err[k] / peak[k]);
+        }
+    }
+
+    std::printf("\nforce error vs PhysicsEngine::step() chain (%zu angles x 32 RPMs):\n", kAngles);
+    std::printf("%20s %14s %16s\n", "output", "max abs", "max abs / peak");
+    for (std::size_t k = 0; k < 5; ++k) {
+        std::printf("%20s %14.4e %16.4e\n", kForceNames[k], maxAbs[k], maxNorm[k]);
+    }
+}
+
+template <typename Fn>
+double nsPerSample(std::size_t n, Fn&& fn) {
+    using clock = std::chrono::steady_clock;
+    double best = 1e300;
+    for (int rep = 0; rep < 5; ++rep) {
+        auto t0 = clock::now();
+        fn();
+        double ns = std::chrono::duration<double, std::nano>(clock::now() - t0).count();
+        best = std::min(best, ns / static_cast<double>(n));
+    }
+    return best;
+}
+
+void reportThroughput(std::size_t n) {
+    std::vector<float> angle(n), omega(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        angle[i] = PhysicsEngine::kTwoPi * static_cast<float>(i % 3600) / 3600.0f;
+        omega[i] = (500.0f + static_cast<float>(i % 75) * 100.0f) * PhysicsEngine::kTwoPi / 60.0f;
+    }
+    std::array<std::vector<float>, 5> out;
+    for (auto& v : out) v.resize(n);
+    CrankForceArrays arrays{out[0].data(), out[1].data(), out[2].data(), out[3].data(), out[4].data()};
+
+    double ref = nsPerSample(n, [&] {
+        for (std::size_t i = 0; i < n; ++i) {
+            CrankForces f = PhysicsEngine::computeCrankForces(angle[i], omega[i]);
+            out[0][i] = f.pistonForceN;
+            out[1][i] = f.rodForceN;
+            out[2][i] = f.tangentialForceN;
+            out[3][i] = f.torqueNm;
+            out[4][i] = f.sideThrustN;
+        }
+    });
+    double vec = nsPerSample(n, [&] {
+        computeCrankForcesBatch(angle.data(), omega.data(), n, arrays);
+    });
+
+    std::printf("\nthroughput over %zu samples:\n", n);
+    std::printf("  libm reference : %8.3f ns/sample  (%.3e samples/s)\n", ref, 1e9 / ref);
+    std::printf("  %-6s x%-2zu     : %8.3f ns/sample  (%.3e samples/s)  speedup %.1fx\n",
+                crankKernelIsa(), crankKernelWidth(), vec, 1e9 / vec, ref / vec);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t samples = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+    if (samples == 0) samples = 1'000'000;
+
+    std::printf("kernel isa: %s (%zu lanes)\n\n", crankKernelIsa(), crankKernelWidth());
+    reportSinCos();
+    reportForces();
+    reportThroughput(samples);
+    return 0;
+}
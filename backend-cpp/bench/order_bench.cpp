@@ -0,0 +1,137 @@
+// Engine-order tracking: accuracy on a known signal, cost per sample and
+// what the twin's torque looks like in orders.
+//
+//   order_bench [seconds]
+//
+// 1. A sum of known orders is sampled at uniform time while the speed sweeps,
+//    and the recovered amplitudes and phases are compared with the truth.
+// 2. push() is timed on that stream, next to recomputing the same orders by
+//    a direct DFT over the last cycle once per 10 ms tick.
+// 3. An inline-4 at 3000 rpm and 80% load is stepped with orders on and off,
+//    and its torque and side-thrust orders are printed.
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "OrderTracker.h"
+#include "PhysicsEngine.h"
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kCycleRad = 4.0 * kPi;
+
+struct Component {
+    float order;
+    float amplitude;
+    float phase;
+};
+
+constexpr Component kTruth[] = {
+    {0.0f, 12.0f, 0.0f}, {0.5f, 3.0f, 0.4f}, {1.0f, 40.0f, -1.1f},
+    {2.0f, 25.0f, 2.0f}, {4.0f, 8.0f, -2.5f}, {6.0f, 2.0f, 0.9f},
+};
+
+double signal(double cycleAngle) {
+    double x = 0.0;
+    for (const Component& c : kTruth) x += c.amplitude * std::cos(c.order * cycleAngle + c.phase);
+    return x;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    double seconds = (argc > 1) ? std::atof(argv[1]) : 60.0;
+    if (!(seconds > 0.0)) seconds = 60.0;
+    using clock = std::chrono::steady_clock;
+
+    constexpr double kRateHz = 10000.0;
+    const auto samples = static_cast<std::size_t>(seconds * kRateHz);
+    std::vector<float> angle(samples), value(samples);
+    double phi = 0.0;
+    for (std::size_t i = 0; i < samples; ++i) {
+        // 1000 → 6000 → 1000 rpm triangle, one sweep per 20 s.
+        const double t = static_cast<double>(i) / kRateHz;
+        const double sweep = 1.0 - std::abs(std::fmod(t / 10.0, 2.0) - 1.0);
+        const double omega = (1000.0 + 5000.0 * sweep) * 2.0 * kPi / 60.0;
+        phi = std::fmod(phi + omega / kRateHz, kCycleRad);
+        angle[i] = static_cast<float>(phi);
+        value[i] = static_cast<float>(signal(phi));
+    }
+
+    // 1 + 2. Accuracy and cost of the sliding DFT.
+    std::vector<float> orders;
+    for (const Component& c : kTruth) orders.push_back(c.order);
+    OrderTracker tracker(orders);
+    const auto start = clock::now();
+    for (std::size_t i = 0; i < samples; ++i) tracker.push(angle[i], value[i]);
+    const double pushNs = std::chrono::duration<double, std::nano>(clock::now() - start).count()
+                          / static_cast<double>(samples);
+
+    double worstAmplitude = 0.0, worstPhase = 0.0;
+    for (std::size_t k = 0; k < tracker.orders(); ++k) {
+        const Component& c = kTruth[k];
+        worstAmplitude = std::max(worstAmplitude, static_cast<double>(std::abs(tracker.amplitude(k) - c.amplitude) / c.amplitude));
+        if (c.order > 0.0f) {
+            double dPhase = std::remainder(static_cast<double>(tracker.phaseRad(k) - c.phase), 2.0 * kPi);
+            worstPhase = std::max(worstPhase, std::abs(dPhase));
+        }
+    }
+    std::printf("%zu orders, %zu samples over a 1000-6000 rpm sweep: worst amplitude error %.2e (relative),"
+                " worst phase error %.2e rad\n", tracker.orders(), samples, worstAmplitude, worstPhase);
+
+    // Baseline: the same orders from scratch over the last cycle, every tick.
+    const std::size_t points = tracker.pointsPerCycle();
+    std::vector<float> cycle(points);
+    for (std::size_t j = 0; j < points; ++j) {
+        cycle[j] = static_cast<float>(signal(kCycleRad * static_cast<double>(j) / static_cast<double>(points)));
+    }
+    constexpr int kTicks = 20000;
+    double sink = 0.0;
+    const auto dftStart = clock::now();
+    for (int t = 0; t < kTicks; ++t) {
+        for (float order : orders) {
+            double re = 0.0, im = 0.0;
+            for (std::size_t j = 0; j < points; ++j) {
+                const double a = order * kCycleRad * static_cast<double>(j) / static_cast<double>(points);
+                re += cycle[j] * std::cos(a);
+                im -= cycle[j] * std::sin(a);
+            }
+            sink += re + im;
+        }
+        cycle[static_cast<std::size_t>(t) % points] += 1e-3f;
+    }
+    const double dftUs = std::chrono::duration<double, std::micro>(clock::now() - dftStart).count() / kTicks;
+    volatile double keep = sink;
+    (void)keep;
+    std::printf("sliding DFT %.1f ns/sample (%.1f us per 10 ms tick at %.0f Hz); direct DFT per tick %.1f us\n",
+                pushNs, pushNs * kRateHz * 0.01 * 1e-3, kRateHz, dftUs);
+
+    // 3. The twin.
+    for (int withOrders = 0; withOrders < 2; ++withOrders) {
+        PhysicsEngine engine(TwinEngine::kDefaultPhysicsRateHz, EngineLayout::inline4());
+        engine.setRpmTarget(3000.0f);
+        engine.setLoad(0.8f);
+        if (withOrders) engine.enableOrders();
+        for (int t = 0; t < 300; ++t) engine.step();
+        constexpr int kEngineTicks = 2000;
+        const auto engineStart = clock::now();
+        for (int t = 0; t < kEngineTicks; ++t) engine.step();
+        const double us = std::chrono::duration<double, std::micro>(clock::now() - engineStart).count()
+                          / kEngineTicks;
+        std::printf("inline4 step, orders %-3s: %6.1f us/tick\n", withOrders ? "on" : "off", us);
+        if (!withOrders) continue;
+
+        const auto payload = engine.ordersSnapshot();
+        std::printf("  order   torque Nm  phase    side thrust N  phase\n");
+        for (std::size_t k = 0; k < payload.count; ++k) {
+            std::printf("  %5.1f  %10.2f  %+6.2f  %13.1f  %+6.2f\n", static_cast<double>(payload.order[k]),
+                        static_cast<double>(payload.torqueAmplitudeNm[k]), static_cast<double>(payload.torquePhaseRad[k]),
+                        static_cast<double>(payload.sideThrustAmplitudeN[k]),
+                        static_cast<double>(payload.sideThrustPhaseRad[k]));
+        }
+    }
+    return 0;
+}
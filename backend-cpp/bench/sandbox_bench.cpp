@@ -0,0 +1,141 @@
+// Sandbox twins: the live twin's tick latency as sandboxes are added.
+//
+//   sandbox_bench [seconds] [threads]
+//
+// A live inline-4 at 10 kHz runs the server's 100 Hz loop on the main thread
+// for `seconds` (default 3) per row: step(), then sleep to the next tick.
+// Each row opens N sandboxes of the same engine in a SandboxPool of
+// `threads` workers (0, the default, picks as the server does), half
+// restored from a checkpoint of the live twin and half fresh, with sinks
+// that serialize every snapshot as the server does. Printed per row: live
+// step() p50/p99/max, the worst wake-up lateness of the loop, and the
+// pool's longest shard tick and overrun count. The last row repeats the
+// largest load on plain threads at normal priority, for comparison.
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <span>
+#include <thread>
+#include <vector>
+#include "EngineRegistry.h"
+#include "SandboxPool.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using Micros = std::chrono::duration<double, std::micro>;
+
+struct LiveLatency {
+    double p50Us = 0.0;
+    double p99Us = 0.0;
+    double maxUs = 0.0;
+    double lateUs = 0.0;   // worst wake-up past the tick deadline
+};
+
+LiveLatency runLive(TwinEngine& live, double seconds) {
+    const auto tick = std::chrono::microseconds(static_cast<int64_t>(TwinEngine::kDt * 1e6f));
+    const int ticks = static_cast<int>(seconds / TwinEngine::kDt);
+    std::vector<double> steps;
+    steps.reserve(static_cast<std::size_t>(ticks));
+    LiveLatency r;
+    auto deadline = Clock::now();
+    for (int t = 0; t < ticks; ++t) {
+        const auto start = Clock::now();
+        r.lateUs = std::max(r.lateUs, Micros(start - deadline).count());
+        live.step();
+        steps.push_back(Micros(Clock::now() - start).count());
+        deadline += tick;
+        std::this_thread::sleep_until(deadline);
+    }
+    std::sort(steps.begin(), steps.end());
+    r.p50Us = steps[steps.size() / 2];
+    r.p99Us = steps[steps.size() * 99 / 100];
+    r.maxUs = steps.back();
+    return r;
+}
+
+void printRow(const char* label, std::size_t sandboxes, const LiveLatency& r, double shardUs,
+              unsigned long long overruns) {
+    std::printf("  %-8s %5zu %9.1f %9.1f %9.1f %10.1f %11.0f %9llu\n", label, sandboxes, r.p50Us, r.p99Us,
+                r.maxUs, r.lateUs, shardUs, overruns);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    double seconds = (argc > 1) ? std::atof(argv[1]) : 3.0;
+    if (!(seconds > 0.0)) seconds = 3.0;
+    const unsigned threads = (argc > 2) ? static_cast<unsigned>(std::atoi(argv[2])) : 0u;
+
+    SandboxConfig config;
+    config.layout = EngineLayout::inline4();
+    auto live = EngineRegistry::create(config.variant, config.physicsRateHz, config.layout, config.phaseFormat);
+    live->setRpmTarget(3000.0f);
+    live->setLoad(0.8f);
+    for (int t = 0; t < 300; ++t) live->step();
+
+    std::atomic<std::size_t> bytes{0};
+    auto sink = [&bytes, buffer = protocol::MessageBuffer{}](const protocol::StatePayload& state) mutable {
+        bytes.fetch_add(protocol::serializeState(state, buffer, "sandbox_state"), std::memory_order_relaxed);
+    };
+
+    constexpr std::size_t kCounts[] = {0, 4, 16, 64, 256};
+    std::printf("live inline4 at 3000 rpm, 10 kHz, %.1f s per row\n", seconds);
+    std::printf("  %-8s %5s %9s %9s %9s %10s %11s %9s\n", "pool", "boxes", "p50 us", "p99 us", "max us",
+                "late us", "shard us", "overruns");
+    unsigned poolThreads = 0;
+    for (std::size_t count : kCounts) {
+        SandboxPool pool(config, threads, count);
+        poolThreads = pool.threads();
+        std::vector<SandboxPool::Sandbox> open;
+        std::vector<uint8_t> checkpoint;
+        live->saveCheckpoint(checkpoint);
+        for (std::size_t k = 0; k < count; ++k) {
+            const std::span<const uint8_t> from = k % 2 == 0 ? std::span<const uint8_t>(checkpoint)
+                                                             : std::span<const uint8_t>();
+            if (auto sandbox = pool.create(from, sink)) {
+                sandbox->engine->setRpmTarget(1500.0f + 100.0f * static_cast<float>(k % 40));
+                open.push_back(std::move(*sandbox));
+            }
+        }
+        pool.takeTickStats();
+        const LiveLatency r = runLive(*live, seconds);
+        const SandboxPool::TickStats shard = pool.takeTickStats();
+        printRow("idle", open.size(), r, static_cast<double>(shard.maxTick.count()),
+                 static_cast<unsigned long long>(shard.overruns));
+        for (const auto& sandbox : open) pool.close(sandbox);
+    }
+
+    // The same work on normal-priority threads, each stepping its share
+    // back to back at 100 Hz.
+    {
+        const std::size_t count = kCounts[std::size(kCounts) - 1];
+        std::vector<std::unique_ptr<TwinEngine>> engines;
+        for (std::size_t k = 0; k < count; ++k) {
+            engines.push_back(EngineRegistry::create(config.variant, config.physicsRateHz, config.layout,
+                                                     config.phaseFormat));
+            engines.back()->setRpmTarget(1500.0f + 100.0f * static_cast<float>(k % 40));
+        }
+        std::atomic<bool> running{true};
+        std::vector<std::thread> workers;
+        for (unsigned w = 0; w < poolThreads; ++w) {
+            workers.emplace_back([&, w] {
+                auto deadline = Clock::now();
+                while (running.load(std::memory_order_relaxed)) {
+                    for (std::size_t k = w; k < engines.size(); k += poolThreads) engines[k]->step();
+                    deadline = std::max(deadline + std::chrono::milliseconds(10), Clock::now());
+                    std::this_thread::sleep_until(deadline);
+                }
+            });
+        }
+        const LiveLatency r = runLive(*live, seconds);
+        running.store(false, std::memory_order_relaxed);
+        for (auto& worker : workers) worker.join();
+        printRow("normal", count, r, 0.0, 0);
+    }
+    std::printf("%u worker thread(s); sandbox snapshots serialized: %zu bytes\n", poolThreads,
+                bytes.load(std::memory_order_relaxed));
+    return 0;
+}
@@ -0,0 +1,153 @@
+// Rod force sensitivities: forward-mode gradients against central
+// differences, and what one dual pass costs next to the alternatives.
+//
+//   sensitivity_bench [cycles]
+//
+// 1. For three geometries, four RPMs off the gas-table nodes and two loads,
+//    CycleEvaluator::sensitivity() is compared with central differences of
+//    the same sampled cycle run through crankForceChain<double>. Errors are
+//    printed as elasticities (∂F/∂p · p / F), so all four parameters share a
+//    scale.
+// 2. Per cycle of 720 samples: evaluate() (batch kernel, peaks only), the
+//    scalar float chain, one dual pass, and central differences over
+//    evaluate() (eight more cycles plus two operating-point changes).
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "CrankChain.h"
+#include "CycleEvaluator.h"
+#include "GasPressure.h"
+#include "PhysicsEngine.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+constexpr std::array<const char*, kDesignParameters> kNames = {"throw", "rod", "mass", "rpm"};
+constexpr std::size_t kSamples = 720;
+constexpr double kMaxElasticityError = 1e-4;
+
+struct Peaks {
+    double max = 0.0;
+    double min = 0.0;
+};
+
+// The sampled cycle of CycleEvaluator in double; p is DesignParameter order.
+Peaks cyclePeaks(const std::array<double, kDesignParameters>& p, float load) {
+    const double rpm = p[3];
+    const double omega = rpm * 2.0 * 3.14159265358979323846 / 60.0;
+    const GasPressureTable& table = GasPressureTable::instance<DefaultGeometry>();
+    const GasPressureTable::Slice slice = table.slice(load, static_cast<float>(rpm));
+    Peaks peaks;
+    for (std::size_t k = 0; k < kSamples; ++k) {
+        const float angle = EngineLayout::kCycleRad * static_cast<float>(k) / static_cast<float>(kSamples);
+        const double gas = load > 0.0f
+            ? (static_cast<double>(GasPressureTable::pressurePa(slice, angle)) - GasPressureTable::kCrankcasePa)
+                  * PhysicsEngine::kBoreArea
+            : 0.0;
+        const double rod = crankForceChain<double>(p[0], p[1], p[2], angle, omega, gas).rodForceN;
+        peaks.max = k == 0 ? rod : std::max(peaks.max, rod);
+        peaks.min = k == 0 ? rod : std::min(peaks.min, rod);
+    }
+    return peaks;
+}
+
+template <typename Fn>
+double usPerCycle(int cycles, Fn&& fn) {
+    const auto start = Clock::now();
+    for (int i = 0; i < cycles; ++i) fn();
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count() / cycles;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int cycles = (argc > 1) ? std::atoi(argv[1]) : 20000;
+    if (cycles <= 0) cycles = 20000;
+
+    // 1. Accuracy
+    const std::array<CrankGeometry, 3> geometries = {{
+        {DefaultGeometry::kCrankThrow, DefaultGeometry::kConRodLength, DefaultGeometry::kPistonMass},
+        {CompactGeometry::kCrankThrow, CompactGeometry::kConRodLength, CompactGeometry::kPistonMass},
+        {HeavyDutyGeometry::kCrankThrow, HeavyDutyGeometry::kConRodLength, HeavyDutyGeometry::kPistonMass},
+    }};
+    // Relative steps for the dimensions; 10 rpm keeps every RPM inside one
+    // gas-table cell, where the trace is linear and ω² is quadratic.
+    constexpr std::array<double, kDesignParameters> kStep = {1e-6, 1e-6, 1e-6, 0.0};
+    constexpr double kRpmStep = 10.0;
+
+    CycleEvaluator cycle(kSamples);
+    std::array<double, kDesignParameters> worst{};
+    for (const CrankGeometry& g : geometries) {
+        for (float rpm : {1500.0f, 3300.0f, 5700.0f, 7300.0f}) {
+            for (float load : {0.0f, 0.8f}) {
+                cycle.setOperatingPoint(rpm, load);
+                const CycleSensitivity s = cycle.sensitivity(g);
+                const std::array<double, kDesignParameters> p = {g.crankThrowM, g.conRodLengthM,
+                                                                 g.pistonMassKg, rpm};
+                const Peaks at = cyclePeaks(p, load);
+                for (std::size_t i = 0; i < kDesignParameters; ++i) {
+                    const double h = i == 3 ? kRpmStep : kStep[i] * p[i];
+                    auto up = p, down = p;
+                    up[i] += h;
+                    down[i] -= h;
+                    const Peaks hi = cyclePeaks(up, load), lo = cyclePeaks(down, load);
+                    const double dMax = (hi.max - lo.max) / (2.0 * h);
+                    const double dMin = (hi.min - lo.min) / (2.0 * h);
+                    worst[i] = std::max({worst[i],
+                                         std::abs(s.rodForceMaxGrad[i] - dMax) * p[i] / std::abs(at.max),
+                                         std::abs(s.rodForceMinGrad[i] - dMin) * p[i] / std::abs(at.min)});
+                }
+            }
+        }
+    }
+    bool within = true;
+    std::printf("gradient vs central differences, 3 geometries x 4 rpm x 2 loads, worst elasticity error:\n");
+    for (std::size_t i = 0; i < kDesignParameters; ++i) {
+        within = within && worst[i] <= kMaxElasticityError;
+        std::printf("  %-5s %.2e%s\n", kNames[i], worst[i], worst[i] <= kMaxElasticityError ? "" : "  EXCEEDS");
+    }
+
+    // 2. Cost per cycle
+    const CrankGeometry g = geometries[0];
+    const float rpm = 3300.0f, load = 0.8f;
+    cycle.setOperatingPoint(rpm, load);
+    float sink = 0.0f;
+    const double evaluateUs = usPerCycle(cycles, [&] { sink += cycle.evaluate(g).rodForceMaxN; });
+    const double dualUs = usPerCycle(cycles, [&] { sink += cycle.sensitivity(g).rodForceMaxGrad[0]; });
+    const double scalarUs = usPerCycle(cycles, [&] {
+        const float omega = rpm * PhysicsEngine::kTwoPi / 60.0f;
+        float peak = 0.0f;
+        for (std::size_t k = 0; k < kSamples; ++k) {
+            const float angle = EngineLayout::kCycleRad * static_cast<float>(k) / static_cast<float>(kSamples);
+            peak = std::max(peak, crankForceChain<float>(g.crankThrowM, g.conRodLengthM, g.pistonMassKg,
+                                                         angle, omega, 0.0f).rodForceN);
+        }
+        sink += peak;
+    });
+    const int fdCycles = std::max(1, cycles / 8);
+    const double fdUs = usPerCycle(fdCycles, [&] {
+        CrankGeometry a = g, b = g;
+        a.crankThrowM *= 1.001f;   b.crankThrowM *= 0.999f;
+        sink += cycle.evaluate(a).rodForceMaxN - cycle.evaluate(b).rodForceMaxN;
+        a = g; b = g;
+        a.conRodLengthM *= 1.001f; b.conRodLengthM *= 0.999f;
+        sink += cycle.evaluate(a).rodForceMaxN - cycle.evaluate(b).rodForceMaxN;
+        a = g; b = g;
+        a.pistonMassKg *= 1.001f;  b.pistonMassKg *= 0.999f;
+        sink += cycle.evaluate(a).rodForceMaxN - cycle.evaluate(b).rodForceMaxN;
+        cycle.setOperatingPoint(rpm + kRpmStep, load);
+        sink += cycle.evaluate(g).rodForceMaxN;
+        cycle.setOperatingPoint(rpm - kRpmStep, load);
+        sink -= cycle.evaluate(g).rodForceMaxN;
+    });
+    volatile float keep = sink;
+    (void)keep;
+    std::printf("per %zu-sample cycle: evaluate() %.2f us, scalar chain %.2f us, dual pass %.2f us "
+                "(%zu directions), central differences %.2f us\n",
+                kSamples, evaluateUs, scalarUs, dualUs, kDesignParameters, fdUs);
+    return within ? 0 : 1;
+}
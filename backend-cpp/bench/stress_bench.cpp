@@ -0,0 +1,53 @@
+// Crank-web stress field reconstruction cost against mesh size.
+//
+//   stress_bench [evaluations]
+//
+// Each row builds the default web's basis at one mesh density, then times
+// StressField::evaluate() over a sweep of crank loads, the per-tick work
+// the engine does when a basis is attached.
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include "WebStress.h"
+
+int main(int argc, char** argv) {
+    int evaluations = (argc > 1) ? std::atoi(argv[1]) : 20000;
+    if (evaluations <= 0) evaluations = 20000;
+
+    constexpr WebMeshSize kSizes[] = {{32, 8}, {64, 16}, {128, 32}, {256, 64}};
+    const CrankWebSpec spec = *CrankWebSpec::forVariant("default");
+
+    std::printf("%10s %10s %8s %12s %12s %12s\n",
+                "cells", "nodes", "modes", "build_s", "mean_us", "nodes/us");
+
+    for (const auto& size : kSizes) {
+        using clock = std::chrono::steady_clock;
+        auto t0 = clock::now();
+        auto basis = StressBasis::build(spec, "default", size);
+        double buildS = std::chrono::duration<double>(clock::now() - t0).count();
+        if (!basis) {
+            std::fprintf(stderr, "build failed for %zux%zu\n", size.lengthCells, size.widthCells);
+            return 1;
+        }
+        StressField field(std::make_shared<const StressBasis>(std::move(*basis)));
+
+        float sink = 0.0f;
+        t0 = clock::now();
+        for (int i = 0; i < evaluations; ++i) {
+            float a = 0.01f * static_cast<float>(i);
+            field.evaluate({8e3f * std::cos(a), 5e3f * std::sin(a), 4e5f});
+            sink += field.maxVonMisesPa();
+        }
+        double us = std::chrono::duration<double, std::micro>(clock::now() - t0).count() / evaluations;
+
+        char cells[32];
+        std::snprintf(cells, sizeof(cells), "%zux%zu", size.lengthCells, size.widthCells);
+        std::printf("%10s %10zu %8zu %12.3f %12.2f %12.1f\n", cells, field.basis().nodes(),
+                    field.basis().modes(), buildS, us, static_cast<double>(field.basis().nodes()) / us);
+        if (sink < 0.0f) std::printf("\n");
+    }
+    return 0;
+}
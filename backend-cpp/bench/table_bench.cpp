@@ -0,0 +1,144 @@
+// Compile-time crank-angle tables: max-error report and throughput against
+// the analytic (libm) force chain and the batch kernel.
+//
+//   table_bench [samples]
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "CrankKernel.h"
+#include "CrankTables.h"
+#include "PhysicsEngine.h"
+
+namespace {
+
+struct Exact {
+    double accel, invCosPhi, tangential, tanPhi;
+};
+
+Exact exactFactors(double theta) {
+    double lambda = PhysicsEngine::kLambda;
+    double sinPhi = lambda * std::sin(theta);
+    double cosPhi = std::sqrt(1.0 - sinPhi * sinPhi);
+    return { std::cos(theta) + lambda * std::cos(2.0 * theta),
+             1.0 / cosPhi,
+             std::sin(theta + std::asin(sinPhi)) / cosPhi,
+             sinPhi / cosPhi };
+}
+
+template <typename Lookup>
+void reportFactorError(const char* name, Lookup&& lookup) {
+    constexpr int kPoints = 1 << 22;
+    std::array<double, 4> maxErr{};
+    for (int i = 0; i < kPoints; ++i) {
+        // Evaluate the reference at the float angle the table actually sees.
+        float theta = static_cast<float>(2.0 * 3.14159265358979323846 * i / kPoints);
+        Exact e = exactFactors(theta);
+        KinematicFactors k = lookup(theta);
+        maxErr[0] = std::max(maxErr[0], std::abs(k.accel - e.accel));
+        maxErr[1] = std::max(maxErr[1], std::abs(k.invCosPhi - e.invCosPhi));
+        maxErr[2] = std::max(maxErr[2], std::abs(k.tangential - e.tangential));
+        maxErr[3] = std::max(maxErr[3], std::abs(k.tanPhi - e.tanPhi));
+    }
+    std::printf("%-8s %12.3e %12.3e %12.3e %12.3e\n",
+                name, maxErr[0], maxErr[1], maxErr[2], maxErr[3]);
+}
+
+template <typename Lookup>
+double forceError(Lookup&& lookup) {
+    // Rod force at max RPM, normalized by its peak — the worst output.
+    float w = PhysicsEngine::kRpmMax * PhysicsEngine::kTwoPi / 60.0f;
+    double peak = 0.0;
+    double err = 0.0;
+    for (int i = 0; i < 65536; ++i) {
+        float theta = PhysicsEngine::kTwoPi * static_cast<float>(i) / 65536.0f;
+        CrankForces ref = PhysicsEngine::computeCrankForces(theta, w);
+        KinematicFactors k = lookup(theta);
+        float piston = PhysicsEngine::kPistonMass * (-PhysicsEngine::kCrankThrow * w * w * k.accel);
+        peak = std::max(peak, std::abs(static_cast<double>(ref.rodForceN)));
+        err = std::max(err, std::abs(static_cast<double>(piston * k.invCosPhi - ref.rodForceN)));
+    }
+    return err / peak;
+}
+
+template <typename Fn>
+double nsPerSample(std::size_t n, Fn&& fn) {
+    using clock = std::chrono::steady_clock;
+    double best = 1e300;
+    for (int rep = 0; rep < 5; ++rep) {
+        auto t0 = clock::now();
+        fn();
+        best = std::min(best, std::chrono::duration<double, std::nano>(clock::now() - t0).count());
+    }
+    return best / static_cast<double>(n);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t n = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+    if (n == 0) n = 1'000'000;
+
+    std::printf("table: %zu entries/rev, %zu KiB\n\n", CrankAngleTable::kEntries,
+                sizeof(CrankAngleTable::Columns) / 1024);
+    std::printf("max abs error vs double analytic factors:\n");
+    std::printf("%-8s %12s %12s %12s %12s\n", "interp", "accel", "1/cos_phi", "tangential", "tan_phi");
+    reportFactorError("linear", CrankAngleTable::linear);
+    reportFactorError("cubic", CrankAngleTable::cubic);
+
+    std::printf("\nrod force error / peak at %.0f RPM vs computeCrankForces():\n",
+                static_cast<double>(PhysicsEngine::kRpmMax));
+    std::printf("  linear %.3e   cubic %.3e\n",
+                forceError(CrankAngleTable::linear), forceError(CrankAngleTable::cubic));
+
+    std::vector<float> angle(n), omega(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        angle[i] = PhysicsEngine::kTwoPi * static_cast<float>(i % 3600) / 3600.0f;
+        omega[i] = (500.0f + static_cast<float>(i % 75) * 100.0f) * PhysicsEngine::kTwoPi / 60.0f;
+    }
+    std::array<std::vector<float>, 5> out;
+    for (auto& v : out) v.resize(n);
+
+    auto tableChain = [&](auto lookup) {
+        return [&, lookup] {
+            for (std::size_t i = 0; i < n; ++i) {
+                KinematicFactors k = lookup(angle[i]);
+                float piston = PhysicsEngine::kPistonMass
+                               * (-PhysicsEngine::kCrankThrow * omega[i] * omega[i] * k.accel);
+                float tangential = piston * k.tangential;
+                out[0][i] = piston;
+                out[1][i] = piston * k.invCosPhi;
+                out[2][i] = tangential;
+                out[3][i] = tangential * PhysicsEngine::kCrankThrow;
+                out[4][i] = piston * k.tanPhi;
+            }
+        };
+    };
+
+    double analytic = nsPerSample(n, [&] {
+        for (std::size_t i = 0; i < n; ++i) {
+            CrankForces f = PhysicsEngine::computeCrankForces(angle[i], omega[i]);
+            out[0][i] = f.pistonForceN;
+            out[1][i] = f.rodForceN;
+            out[2][i] = f.tangentialForceN;
+            out[3][i] = f.torqueNm;
+            out[4][i] = f.sideThrustN;
+        }
+    });
+    double linear = nsPerSample(n, tableChain(CrankAngleTable::linear));
+    double cubic = nsPerSample(n, tableChain(CrankAngleTable::cubic));
+    double kernel = nsPerSample(n, [&] {
+        computeCrankForcesBatch(angle.data(), omega.data(), n,
+            {out[0].data(), out[1].data(), out[2].data(), out[3].data(), out[4].data()});
+    });
+
+    std::printf("\nthroughput over %zu samples (ns/sample):\n", n);
+    std::printf("  analytic libm     %8.3f\n", analytic);
+    std::printf("  table linear      %8.3f\n", linear);
+    std::printf("  table cubic       %8.3f\n", cubic);
+    std::printf("  batch kernel      %8.3f  (%s)\n", kernel, crankKernelIsa());
+    return 0;
+}
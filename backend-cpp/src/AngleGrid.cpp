@@ -0,0 +1,34 @@
+#include "AngleGrid.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr double kCycleRad = 4.0 * 3.14159265358979323846;
+}
+
+CrankAngleGrid::CrankAngleGrid(float stepRad, std::size_t maxPointsPerTick)
+    : mPoints(std::max<std::size_t>(4, static_cast<std::size_t>(std::lround(kCycleRad / std::max(stepRad, 1e-4f)))))
+    , mStepRad(static_cast<float>(kCycleRad / static_cast<double>(mPoints)))
+    , mPointsPerRad(static_cast<double>(mPoints) / kCycleRad)
+{
+    mAngle.resize(maxPointsPerTick);
+    mTime.resize(maxPointsPerTick);
+    mOmega.resize(maxPointsPerTick);
+}
+
+void CrankAngleGrid::cross(float fromCycleRad, float dAngleRad, float timeS, float dt,
+                           float omega0, float omega1) {
+    if (!(dAngleRad > 0.0f)) return;
+    const double from = static_cast<double>(fromCycleRad) * mPointsPerRad;
+    const double to = from + static_cast<double>(dAngleRad) * mPointsPerRad;
+    const auto n = static_cast<double>(mPoints);
+
+    for (double k = std::floor(from) + 1.0; k <= to && mCount < mAngle.size(); k += 1.0) {
+        const auto t = static_cast<float>((k - from) / (to - from));
+        const double wrapped = k >= n ? k - n : k;
+        mAngle[mCount] = static_cast<float>(wrapped / mPointsPerRad);
+        mTime[mCount] = timeS + t * dt;
+        mOmega[mCount] = omega0 + t * (omega1 - omega0);
+        ++mCount;
+    }
+}
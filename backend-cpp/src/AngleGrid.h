@@ -0,0 +1,44 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+// ── Fixed crank-angle output grid ──
+// Finds the points of a fixed grid over cylinder 1's four-stroke cycle
+// (0 at its firing TDC) that the crank passes during a tick, so outputs can
+// be evaluated at the same angles at every speed rather than at the 100 Hz
+// tick. Each substep reports the angle it turned through; the grid points
+// inside it are taken at their exact angle, with time and crank speed
+// interpolated linearly across the substep. Storage is sized once for the
+// most points a tick can cross.
+class CrankAngleGrid {
+public:
+    // stepRad is adjusted so a whole number of points spans the 4π cycle.
+    CrankAngleGrid(float stepRad, std::size_t maxPointsPerTick);
+
+    void beginTick() { mCount = 0; }
+
+    // One substep starting at fromCycleRad, timeS seconds into the tick,
+    // turning dAngleRad over dt while the speed goes from omega0 to omega1.
+    // The start is excluded and the end included, so consecutive substeps
+    // never report a point twice. Backward motion crosses nothing.
+    void cross(float fromCycleRad, float dAngleRad, float timeS, float dt, float omega0, float omega1);
+
+    [[nodiscard]] std::size_t count() const { return mCount; }
+    [[nodiscard]] const float* cycleAngleRad() const { return mAngle.data(); }
+    [[nodiscard]] const float* timeS() const { return mTime.data(); }
+    [[nodiscard]] const float* omegaRadS() const { return mOmega.data(); }
+
+    [[nodiscard]] float stepRad() const { return mStepRad; }
+    [[nodiscard]] std::size_t pointsPerCycle() const { return mPoints; }
+    [[nodiscard]] std::size_t capacity() const { return mAngle.size(); }
+
+private:
+    std::size_t mPoints;
+    float mStepRad;
+    double mPointsPerRad;
+
+    std::vector<float> mAngle;
+    std::vector<float> mTime;
+    std::vector<float> mOmega;
+    std::size_t mCount = 0;
+};
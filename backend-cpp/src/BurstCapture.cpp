@@ -0,0 +1,172 @@
+#include "BurstCapture.h"
+#include <algorithm>
+#include <cmath>
+
+BurstCapture::BurstCapture(std::size_t capacity, float dtS)
+    : mCapacity(std::max<std::size_t>(capacity, 1))
+    , mDtS(dtS)
+{
+    for (Slot& slot : mSlots) slot.samples.resize(mCapacity);
+}
+
+// ── Reader thread ──
+
+bool BurstCapture::arm(const protocol::CaptureTrigger& trigger) {
+    Command command{true, trigger};
+    command.trigger.postSamples = static_cast<uint32_t>(
+        std::clamp<std::size_t>(trigger.postSamples, 1, mCapacity));
+    command.trigger.preSamples = static_cast<uint32_t>(
+        std::min<std::size_t>(trigger.preSamples, mCapacity - command.trigger.postSamples));
+    return mCommands.pushBatch(1, [&](std::size_t) { return command; }) == 1;
+}
+
+bool BurstCapture::disarm() {
+    return mCommands.pushBatch(1, [](std::size_t) { return Command{}; }) == 1;
+}
+
+std::size_t BurstCapture::encode(uint64_t sequence, std::vector<uint8_t>& out) {
+    if (sequence == 0) sequence = completed();
+    for (Slot& slot : mSlots) {
+        uint8_t expected = Ready;
+        if (!slot.state.compare_exchange_strong(expected, Reading, std::memory_order_acquire)) continue;
+        if (slot.info.sequence != sequence) {
+            slot.state.store(Ready, std::memory_order_release);
+            continue;
+        }
+        const std::span<const protocol::CaptureSample> ring(slot.samples.data(), slot.info.count);
+        out.resize(protocol::captureFrameBytes(slot.info.count));
+        const std::size_t len = protocol::encodeCaptureFrame(slot.info, ring.subspan(slot.start),
+                                                             ring.first(slot.start), out.data());
+        slot.state.store(Ready, std::memory_order_release);
+        return len;
+    }
+
+    protocol::CaptureInfo missing;
+    missing.sequence = sequence;
+    out.resize(protocol::captureFrameBytes(0));
+    return protocol::encodeCaptureFrame(missing, {}, {}, out.data());
+}
+
+// ── Physics thread ──
+
+void BurstCapture::beginTick() {
+    while (const Command* command = mCommands.front()) {
+        mArmed = command->arm;
+        mTrigger = command->trigger;
+        mCommands.pop();
+        releaseSlot();
+    }
+    if (mArmed && !mActive) claimSlot();
+}
+
+bool BurstCapture::claimSlot() {
+    // A free slot, else the oldest finished capture nobody is reading.
+    for (int pass = 0; pass < 2; ++pass) {
+        std::size_t best = kSlots;
+        for (std::size_t s = 0; s < kSlots; ++s) {
+            const uint8_t state = mSlots[s].state.load(std::memory_order_relaxed);
+            if (state != (pass == 0 ? Free : Ready)) continue;
+            if (best == kSlots || mSlots[s].info.sequence < mSlots[best].info.sequence) best = s;
+        }
+        if (best == kSlots) continue;
+        uint8_t expected = pass == 0 ? Free : Ready;
+        if (!mSlots[best].state.compare_exchange_strong(expected, Recording, std::memory_order_acquire)) continue;
+
+        mSlot = best;
+        mActive = true;
+        mTriggered = false;
+        mWindow = static_cast<std::size_t>(mTrigger.preSamples) + mTrigger.postSamples;
+        mWrite = 0;
+        mFilled = 0;
+        mPrevInBand = true;
+        return true;
+    }
+    return false;
+}
+
+void BurstCapture::releaseSlot() {
+    if (!mActive) return;
+    mActive = false;
+    mTriggered = false;
+    mStampPending = false;
+    mSlots[mSlot].state.store(Free, std::memory_order_release);
+}
+
+bool BurstCapture::fires(float value, float rpm) {
+    using Kind = protocol::CaptureTrigger::Kind;
+    using Edge = protocol::CaptureTrigger::Edge;
+    const bool inBand = rpm >= mTrigger.rpmMin && rpm <= mTrigger.rpmMax;
+    const bool rising = mTrigger.edge != Edge::Falling;
+    const bool falling = mTrigger.edge != Edge::Rising;
+    bool fire = false;
+
+    switch (mTrigger.kind) {
+    case Kind::Level: {
+        const float level = mTrigger.threshold;
+        fire = mFilled >= 2 && inBand
+            && ((rising && mPrevValue < level && value >= level)
+                || (falling && mPrevValue > level && value <= level));
+        break;
+    }
+    case Kind::Slope: {
+        // Rates are edge-triggered too, so a steep stretch fires once.
+        const float rate = (value - mPrevValue) / mDtS;
+        const float limit = std::abs(mTrigger.threshold);
+        fire = mFilled >= 3 && inBand
+            && ((rising && mPrevRate < limit && rate >= limit)
+                || (falling && mPrevRate > -limit && rate <= -limit));
+        mPrevRate = mFilled >= 2 ? rate : 0.0f;
+        break;
+    }
+    case Kind::RpmBand:
+        fire = inBand && !mPrevInBand;
+        break;
+    }
+    mPrevInBand = inBand;
+    mPrevValue = value;
+    return fire;
+}
+
+void BurstCapture::record(const protocol::CaptureSample& sample, float rpm) {
+    if (!mActive || mDone) return;
+    Slot& slot = mSlots[mSlot];
+    slot.samples[mWrite] = sample;
+    mWrite = mWrite + 1 == mWindow ? 0 : mWrite + 1;
+    ++mFilled;
+
+    if (!mTriggered) {
+        const float value = sample.value(mTrigger.signal);
+        if (!fires(value, rpm) || mFilled <= mTrigger.preSamples) return;
+        mTriggered = true;
+        mStampPending = true;
+        mRemaining = mTrigger.postSamples;
+        slot.info.trigger = mTrigger;
+        slot.info.triggerValue = mTrigger.kind == protocol::CaptureTrigger::Kind::RpmBand ? rpm : value;
+        slot.info.rpm = rpm;
+        slot.info.dtS = mDtS;
+        slot.info.count = static_cast<uint32_t>(mWindow);
+        slot.info.triggerIndex = mTrigger.preSamples;
+    }
+
+    if (--mRemaining == 0) {
+        // The window is the ring's last mWindow samples, oldest at mWrite.
+        slot.start = mWrite;
+        mDone = true;
+    }
+}
+
+void BurstCapture::endTick(uint64_t timestampMs) {
+    if (mStampPending) {
+        mSlots[mSlot].info.timestampMs = timestampMs;
+        mStampPending = false;
+    }
+    if (!mDone) return;
+    mDone = false;
+    mActive = false;
+    Slot& slot = mSlots[mSlot];
+    slot.info.sequence = completed() + 1;
+    mLatest = slot.info;
+    slot.state.store(Ready, std::memory_order_release);
+    mCompleted.store(slot.info.sequence, std::memory_order_release);
+    if (!mTrigger.rearm) mArmed = false;
+}
@@ -0,0 +1,104 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Protocol.h"
+#include "SpscQueue.h"
+
+// ── Triggered burst capture (oscilloscope mode) ──
+// While armed, every physics substep is written into a preallocated ring.
+// When the trigger fires, the ring's last pre-trigger samples and the
+// post-trigger samples that follow become one capture. Captures live in
+// kSlots fixed slots. Each slot has an atomic state that hands it between
+// the physics thread and one reader thread. The physics thread only claims
+// a slot nobody is reading, and the reader only copies a slot the physics
+// thread has finished. Neither side waits for the other, and nothing is
+// copied or allocated on the physics side.
+//
+// arm() and disarm() reach the physics thread through a small SPSC queue
+// and take effect at the next beginTick(). At most one capture completes
+// per tick. A rearmed trigger then starts over in a new slot next tick, and
+// must fill its pre-trigger window again before it can fire.
+class BurstCapture {
+public:
+    static constexpr std::size_t kSlots = 4;
+    static constexpr std::size_t kDefaultCapacity = 8192;   // 0.8 s at 10 kHz
+
+    // capacity: the most samples one capture holds; dtS: the substep.
+    BurstCapture(std::size_t capacity, float dtS);
+
+    BurstCapture(const BurstCapture&) = delete;
+    BurstCapture& operator=(const BurstCapture&) = delete;
+
+    // ── Reader thread ──
+    // post_samples is clamped to [1, capacity], then pre_samples to what
+    // is left. Returns false if the command queue is full.
+    bool arm(const protocol::CaptureTrigger& trigger);
+    bool disarm();
+
+    // Writes the frame of capture `sequence` (0 for the newest) to `out`,
+    // resizing it (Protocol.h). An unknown or overwritten sequence gives a
+    // header with count 0. Returns the bytes written.
+    std::size_t encode(uint64_t sequence, std::vector<uint8_t>& out);
+
+    // ── Physics thread ──
+    void beginTick();
+    void record(const protocol::CaptureSample& sample, float rpm);
+    void endTick(uint64_t timestampMs);
+
+    [[nodiscard]] bool armed() const { return mArmed; }
+    [[nodiscard]] const protocol::CaptureTrigger& trigger() const { return mTrigger; }
+
+    // Info of the newest completed capture, read from the physics thread.
+    [[nodiscard]] const protocol::CaptureInfo& latest() const { return mLatest; }
+
+    // ── Any thread ──
+    // Captures completed so far; also the newest one's sequence.
+    [[nodiscard]] uint64_t completed() const { return mCompleted.load(std::memory_order_acquire); }
+    [[nodiscard]] std::size_t capacity() const { return mCapacity; }
+    [[nodiscard]] float dtS() const { return mDtS; }
+
+private:
+    enum State : uint8_t { Free, Recording, Ready, Reading };
+
+    struct Slot {
+        std::atomic<uint8_t> state{Free};
+        protocol::CaptureInfo info;
+        std::size_t start = 0;                    // oldest sample in the ring
+        std::vector<protocol::CaptureSample> samples;
+    };
+
+    struct Command {
+        bool arm = false;
+        protocol::CaptureTrigger trigger;
+    };
+
+    bool claimSlot();
+    void releaseSlot();
+    [[nodiscard]] bool fires(float value, float rpm);
+
+    std::size_t mCapacity;
+    float mDtS;
+    std::array<Slot, kSlots> mSlots;
+    SpscQueue<Command, 8> mCommands;
+    std::atomic<uint64_t> mCompleted{0};
+
+    // Physics thread state
+    protocol::CaptureTrigger mTrigger;
+    protocol::CaptureInfo mLatest;
+    bool mArmed = false;            // a trigger is set, whether or not recording
+    bool mActive = false;           // recording into mSlots[mSlot]
+    bool mTriggered = false;
+    bool mDone = false;             // completed this tick, publish at endTick()
+    bool mStampPending = false;     // triggered this tick, timestamp at endTick()
+    std::size_t mSlot = 0;
+    std::size_t mWindow = 0;        // pre + post
+    std::size_t mWrite = 0;
+    std::size_t mFilled = 0;
+    std::size_t mRemaining = 0;     // post-trigger samples still to come
+    float mPrevValue = 0.0f;
+    float mPrevRate = 0.0f;
+    bool mPrevInBand = true;
+};
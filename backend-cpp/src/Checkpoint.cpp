@@ -0,0 +1,268 @@
+#include "Checkpoint.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include "PhysicsEngine.h"
+
+// Checkpoint layout (little-endian):
+//   char[4]  "TWCK"
+//   uint32   version
+//   uint64   body bytes, 0 until sealed
+//   uint32   CRC-32 of the body (IEEE, as zlib), 0 until sealed
+//   uint32   substeps per tick
+//   char[16] variant name, NUL-padded
+//   char[16] phase format, NUL-padded
+//   uint32   cylinders
+//   float    bank angle, rad
+//   uint8    firing order                 × 16
+//   body     TwinEngine::saveCheckpoint(): the twin's part, then the variant's
+static_assert(std::endian::native == std::endian::little,
+              "Checkpoints are read and written in host byte order");
+
+namespace {
+
+constexpr char kMagic[4] = {'T', 'W', 'C', 'K'};
+constexpr std::size_t kNameChars = 16;
+
+struct FileHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t bodyBytes;
+    uint32_t crc;
+    uint32_t substeps;
+    char variant[kNameChars];
+    char phase[kNameChars];
+    uint32_t cylinders;
+    float bankAngleRad;
+    uint8_t firingOrder[EngineLayout::kMaxCylinders];
+};
+static_assert(sizeof(FileHeader) == Checkpoint::kHeaderBytes);
+static_assert(EngineLayout::kMaxCylinders == 16, "FileHeader holds a 16-entry firing order");
+
+FileHeader headerFor(const TwinEngine& engine) {
+    FileHeader h{};
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version = Checkpoint::kVersion;
+    h.substeps = engine.substepsPerTick();
+    const std::string_view variant = engine.variant();
+    const std::string_view phase = engine.phaseFormat();
+    std::memcpy(h.variant, variant.data(), std::min(variant.size(), kNameChars - 1));
+    std::memcpy(h.phase, phase.data(), std::min(phase.size(), kNameChars - 1));
+    const EngineLayout& layout = engine.layout();
+    h.cylinders = static_cast<uint32_t>(layout.cylinders());
+    h.bankAngleRad = layout.bankAngleRad();
+    std::copy(layout.firingOrder().begin(), layout.firingOrder().end(), h.firingOrder);
+    return h;
+}
+
+std::string nameOf(const char (&chars)[kNameChars]) {
+    return std::string(chars, std::find(chars, chars + kNameChars, '\0'));
+}
+
+uint32_t crc32(std::span<const uint8_t> bytes) {
+    static const std::array<uint32_t, 256> kTable = [] {
+        std::array<uint32_t, 256> table{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) c = (c & 1u) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            table[i] = c;
+        }
+        return table;
+    }();
+    uint32_t c = 0xFFFFFFFFu;
+    for (uint8_t b : bytes) c = kTable[(c ^ b) & 0xFFu] ^ (c >> 8);
+    return c ^ 0xFFFFFFFFu;
+}
+
+} // namespace
+
+// ── Checkpoint ──
+
+void Checkpoint::begin(std::vector<uint8_t>& out, const TwinEngine& engine) {
+    const FileHeader h = headerFor(engine);
+    const auto* bytes = reinterpret_cast<const uint8_t*>(&h);
+    out.assign(bytes, bytes + sizeof(h));
+}
+
+void Checkpoint::seal(std::span<uint8_t> checkpoint) {
+    if (checkpoint.size() < sizeof(FileHeader)) return;
+    FileHeader h;
+    std::memcpy(&h, checkpoint.data(), sizeof(h));
+    h.bodyBytes = checkpoint.size() - sizeof(h);
+    h.crc = crc32(checkpoint.subspan(sizeof(h)));
+    std::memcpy(checkpoint.data(), &h, sizeof(h));
+}
+
+std::span<const uint8_t> Checkpoint::body(std::span<const uint8_t> checkpoint, const TwinEngine& engine,
+                                          bool requireSealed, std::string* error) {
+    auto fail = [&](const std::string& what) -> std::span<const uint8_t> {
+        if (error) *error = what;
+        return {};
+    };
+
+    FileHeader h{};
+    if (checkpoint.size() < sizeof(h)) return fail("not a checkpoint");
+    std::memcpy(&h, checkpoint.data(), sizeof(h));
+    if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0) return fail("not a checkpoint");
+    if (h.version != kVersion) return fail("unsupported version " + std::to_string(h.version));
+
+    const FileHeader want = headerFor(engine);
+    if (nameOf(h.variant) != nameOf(want.variant)) {
+        return fail("checkpoint is of variant " + nameOf(h.variant) + ", engine is " + nameOf(want.variant));
+    }
+    if (nameOf(h.phase) != nameOf(want.phase)) {
+        return fail("checkpoint has phase format " + nameOf(h.phase) + ", engine has " + nameOf(want.phase));
+    }
+    if (h.substeps != want.substeps) {
+        return fail("checkpoint runs " + std::to_string(h.substeps) + " substeps per tick, engine runs "
+                    + std::to_string(want.substeps));
+    }
+    if (h.cylinders != want.cylinders || h.bankAngleRad != want.bankAngleRad
+        || !std::equal(h.firingOrder, h.firingOrder + EngineLayout::kMaxCylinders, want.firingOrder)) {
+        return fail("checkpoint is of a different engine layout");
+    }
+
+    const std::span<const uint8_t> payload = checkpoint.subspan(sizeof(h));
+    if (h.bodyBytes == 0 && requireSealed) return fail("not sealed");
+    if (h.bodyBytes != 0) {
+        if (h.bodyBytes != payload.size()) return fail("truncated");
+        if (h.crc != crc32(payload)) return fail("checksum mismatch");
+    }
+    return payload;
+}
+
+bool Checkpoint::read(const std::string& path, std::vector<uint8_t>& out, std::string* error) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        if (error) *error = path + ": cannot open";
+        return false;
+    }
+    const std::streamoff size = in.tellg();
+    out.resize(static_cast<std::size_t>(std::max<std::streamoff>(size, 0)));
+    in.seekg(0);
+    in.read(reinterpret_cast<char*>(out.data()), static_cast<std::streamsize>(out.size()));
+    if (!in) {
+        if (error) *error = path + ": read failed";
+        return false;
+    }
+    return true;
+}
+
+bool Checkpoint::write(const std::string& path, std::span<uint8_t> checkpoint, std::string* error) {
+    seal(checkpoint);
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            if (error) *error = "cannot open " + temporary;
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(checkpoint.data()), static_cast<std::streamsize>(checkpoint.size()));
+        out.flush();
+        if (!out) {
+            if (error) *error = "write failed: " + temporary;
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(temporary, path, ec);
+    if (ec) {
+        if (error) *error = "cannot replace " + path + ": " + ec.message();
+        return false;
+    }
+    return true;
+}
+
+// ── CheckpointWriter ──
+
+CheckpointWriter::CheckpointWriter(std::string path)
+    : mPath(std::move(path))
+    , mThread([this] { run(); })
+{
+}
+
+CheckpointWriter::~CheckpointWriter() {
+    // Let a pending write finish; the file on disk is then never a torn one.
+    for (uint8_t s = mState.load(); s == Pending; s = mState.load()) mState.wait(s);
+    mState.store(Stopping);
+    mState.notify_one();
+    mThread.join();
+}
+
+bool CheckpointWriter::offer(const TwinEngine& engine) {
+    if (mState.load(std::memory_order_acquire) != Idle) {
+        mSkipped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    engine.saveCheckpoint(mBuffer);
+    mEncodeUs.store(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::steady_clock::now() - start).count()),
+                    std::memory_order_relaxed);
+    mState.store(Pending, std::memory_order_release);
+    mState.notify_one();
+    return true;
+}
+
+bool CheckpointWriter::flush(const TwinEngine& engine, std::string* error) {
+    for (uint8_t s = mState.load(std::memory_order_acquire); s == Pending; s = mState.load(std::memory_order_acquire)) {
+        mState.wait(s, std::memory_order_acquire);
+    }
+    engine.saveCheckpoint(mBuffer);
+    if (!Checkpoint::write(mPath, mBuffer, error)) {
+        mFailed.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    mBytes.store(mBuffer.size(), std::memory_order_relaxed);
+    mWritten.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void CheckpointWriter::run() {
+    for (;;) {
+        mState.wait(Idle, std::memory_order_acquire);
+        if (mState.load(std::memory_order_acquire) == Stopping) return;
+
+        const auto start = std::chrono::steady_clock::now();
+        if (Checkpoint::write(mPath, mBuffer)) {
+            mBytes.store(mBuffer.size(), std::memory_order_relaxed);
+            mWritten.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            mFailed.fetch_add(1, std::memory_order_relaxed);
+        }
+        mWriteUs.store(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                           std::chrono::steady_clock::now() - start).count()),
+                       std::memory_order_relaxed);
+        mState.store(Idle, std::memory_order_release);
+        mState.notify_all();
+    }
+}
+
+// ── CheckpointRequests ──
+
+void CheckpointRequests::request(Callback done) {
+    std::lock_guard lk(mMutex);
+    mPending.push_back(std::move(done));
+    mAny.store(true, std::memory_order_release);
+}
+
+std::size_t CheckpointRequests::serve(const TwinEngine& engine) {
+    if (!mAny.load(std::memory_order_acquire)) return 0;
+    {
+        std::lock_guard lk(mMutex);
+        mServing.swap(mPending);
+        mAny.store(false, std::memory_order_relaxed);
+    }
+    if (mServing.empty()) return 0;
+
+    auto checkpoint = std::make_shared<std::vector<uint8_t>>();
+    engine.saveCheckpoint(*checkpoint);
+
+    const std::size_t served = mServing.size();
+    for (Callback& done : mServing) done(checkpoint);
+    mServing.clear();
+    return served;
+}
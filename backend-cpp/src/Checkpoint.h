@@ -0,0 +1,254 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "Protocol.h"
+
+class TwinEngine;
+
+// ── Checkpoint byte streams ──
+// Engine state is written and read by one visit function per class, called
+// with a CheckpointOut (const object) or a CheckpointIn (mutable object), so
+// the two directions cannot drift apart. Values go out in host byte order
+// (little-endian, see Checkpoint.cpp) with no padding.
+class CheckpointOut {
+public:
+    static constexpr bool kReading = false;
+
+    explicit CheckpointOut(std::vector<uint8_t>& out) : mOut(out) {}
+
+    template <typename T>
+    void operator()(const T& value) { array(&value, 1); }
+
+    template <typename T>
+    void array(const T* values, std::size_t count) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const auto* bytes = reinterpret_cast<const uint8_t*>(values);
+        mOut.insert(mOut.end(), bytes, bytes + count * sizeof(T));
+    }
+
+    void fail() {}
+
+private:
+    std::vector<uint8_t>& mOut;
+};
+
+class CheckpointIn {
+public:
+    static constexpr bool kReading = true;
+
+    explicit CheckpointIn(std::span<const uint8_t> in) : mIn(in) {}
+
+    template <typename T>
+    void operator()(T& value) { array(&value, 1); }
+
+    // Reads nothing once failed, so a visit can run to its end unchecked.
+    template <typename T>
+    void array(T* values, std::size_t count) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const std::size_t bytes = count * sizeof(T);
+        if (!mOk || bytes > mIn.size() - mAt) {
+            mOk = false;
+            return;
+        }
+        std::memcpy(values, mIn.data() + mAt, bytes);
+        mAt += bytes;
+    }
+
+    void fail() { mOk = false; }
+    [[nodiscard]] bool ok() const { return mOk; }
+    [[nodiscard]] bool finished() const { return mOk && mAt == mIn.size(); }
+
+private:
+    std::span<const uint8_t> mIn;
+    std::size_t mAt = 0;
+    bool mOk = true;
+};
+
+// ── Visits shared by several classes ──
+
+// bool as one byte; anything but 0 or 1 fails the read.
+template <typename Flag, typename Io>
+void visitFlag(Flag& flag, Io& io) {
+    uint8_t v = flag ? 1 : 0;
+    io(v);
+    if (v > 1) io.fail();
+    if constexpr (Io::kReading) flag = v != 0;
+}
+
+// Field by field, and the torsion arrays only as far as shaftSections.
+template <typename S, typename Io>
+void visitStatePayload(S& s, Io& io) {
+    io(s.rpm);
+    io(s.angleRad);
+    io(s.stressPa);
+    io(s.stressFactor);
+    io(s.pistonForceN);
+    io(s.rodForceN);
+    io(s.tangentialForceN);
+    io(s.torqueNm);
+    io(s.sideThrustN);
+    io(s.timestampMs);
+    io(s.load);
+    io(s.cylinderPressurePa);
+    io(s.engineTorqueNm);
+    io(s.shakingForceXN);
+    io(s.shakingForceYN);
+    io(s.pistonForceStats);
+    io(s.rodForceStats);
+    io(s.tangentialForceStats);
+    io(s.torqueStats);
+    io(s.sideThrustStats);
+    io(s.engineTorqueStats);
+    io(s.rpmStats);
+    io(s.loadTorqueNm);
+    io(s.shaftSections);
+    if (s.shaftSections > protocol::kMaxShaftSections) return io.fail();
+    io.array(s.twistRad.data(), s.shaftSections);
+    io.array(s.shearStressPa.data(), s.shaftSections);
+    io(s.maxShearStressPa);
+    io(s.webStressMaxPa);
+    io(s.webHotspotNode);
+}
+static_assert(sizeof(protocol::ForceStats) == 3 * sizeof(float), "ForceStats is written whole");
+
+template <typename R, typename Io>
+void visitRevolutionPayload(R& r, Io& io) {
+    io(r.index);
+    io(r.timestampMs);
+    io(r.durationS);
+    io(r.rpm);
+    io(r.torqueMeanNm);
+    io(r.torqueRmsNm);
+    io(r.torquePeakNm);
+    io(r.rodForceMaxN);
+    io(r.sideThrustMaxN);
+}
+
+// Oldest first; a read replaces the ring's contents.
+template <typename Ring, typename Io, typename Visit>
+void visitRing(Ring& ring, Io& io, Visit visit) {
+    uint32_t count = static_cast<uint32_t>(ring.size());
+    io(count);
+    if (count > ring.capacity()) return io.fail();
+    if constexpr (Io::kReading) {
+        ring.clear();
+        for (uint32_t i = 0; i < count && io.ok(); ++i) {
+            std::remove_cvref_t<decltype(ring.latest())> item{};
+            visit(item, io);
+            ring.push(item);
+        }
+    } else {
+        for (uint32_t i = 0; i < count; ++i) visit(ring.at(i), io);
+    }
+}
+
+// ── Checkpoint files ──
+// A checkpoint is a fixed header followed by the body TwinEngine writes
+// (layout in Checkpoint.cpp). The header names what the body belongs to:
+// variant, phase format, substeps per tick and layout must all match the
+// engine it is restored into. seal() stamps the body's length and CRC-32;
+// files are always sealed, in-memory forks need not be.
+class Checkpoint {
+public:
+    static constexpr uint32_t kVersion = 2;   // 2: rainflow on/off
+    static constexpr std::size_t kHeaderBytes = 80;
+
+    // Starts `out` (cleared) with an unsealed header for `engine`.
+    static void begin(std::vector<uint8_t>& out, const TwinEngine& engine);
+
+    static void seal(std::span<uint8_t> checkpoint);
+
+    // The body of a checkpoint that can be restored into `engine`, or an
+    // empty span with `error` set. A sealed checkpoint must match its length
+    // and CRC; an unsealed one is accepted only without requireSealed.
+    static std::span<const uint8_t> body(std::span<const uint8_t> checkpoint, const TwinEngine& engine,
+                                         bool requireSealed, std::string* error = nullptr);
+
+    // Whole-file read, and a sealed write through a temporary file renamed
+    // over `path`, so a crash mid-write leaves the previous checkpoint.
+    static bool read(const std::string& path, std::vector<uint8_t>& out, std::string* error = nullptr);
+    static bool write(const std::string& path, std::span<uint8_t> checkpoint, std::string* error = nullptr);
+};
+
+// ── Background checkpoint writer ──
+// The stepping thread encodes the engine into the writer's buffer between
+// steps: that is the consistent copy, and it allocates nothing once the
+// buffer has grown to size. Sealing and the file write then happen on the
+// writer's own thread. offer() never waits. While the previous checkpoint is
+// still being written it skips and counts the request.
+class CheckpointWriter {
+public:
+    explicit CheckpointWriter(std::string path);
+    ~CheckpointWriter();
+
+    CheckpointWriter(const CheckpointWriter&) = delete;
+    CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+
+    // Stepping thread. Returns false if a write was still in progress.
+    bool offer(const TwinEngine& engine);
+
+    // Stepping thread: waits for any write in progress, then writes the
+    // engine's state synchronously (e.g. at shutdown).
+    bool flush(const TwinEngine& engine, std::string* error = nullptr);
+
+    [[nodiscard]] const std::string& path() const { return mPath; }
+
+    // ── Any thread ──
+    [[nodiscard]] uint64_t written() const { return mWritten.load(std::memory_order_relaxed); }
+    [[nodiscard]] uint64_t skipped() const { return mSkipped.load(std::memory_order_relaxed); }
+    [[nodiscard]] uint64_t failed() const { return mFailed.load(std::memory_order_relaxed); }
+    [[nodiscard]] std::size_t bytes() const { return mBytes.load(std::memory_order_relaxed); }
+    // Stepping-thread time of the last encode, and wall time of the last write.
+    [[nodiscard]] uint64_t encodeUs() const { return mEncodeUs.load(std::memory_order_relaxed); }
+    [[nodiscard]] uint64_t writeUs() const { return mWriteUs.load(std::memory_order_relaxed); }
+
+private:
+    enum State : uint8_t { Idle, Pending, Stopping };
+
+    void run();
+
+    std::string mPath;
+    std::vector<uint8_t> mBuffer;   // the stepping thread's while Idle, the writer's while Pending
+    std::atomic<uint8_t> mState{Idle};
+    std::atomic<uint64_t> mWritten{0};
+    std::atomic<uint64_t> mSkipped{0};
+    std::atomic<uint64_t> mFailed{0};
+    std::atomic<std::size_t> mBytes{0};
+    std::atomic<uint64_t> mEncodeUs{0};
+    std::atomic<uint64_t> mWriteUs{0};
+    std::thread mThread;   // last: started once the rest exists
+};
+
+// ── Checkpoints on demand ──
+// Other threads ask for the stepping engine's state with request(); the
+// stepping thread calls serve() between steps, which encodes one
+// checkpoint for everything pending and hands it to each callback. The
+// callbacks run on the stepping thread, so they should only pass the
+// shared bytes on. serve() is one atomic load while nothing is pending.
+class CheckpointRequests {
+public:
+    using Bytes = std::shared_ptr<const std::vector<uint8_t>>;
+    using Callback = std::function<void(Bytes)>;
+
+    // Any thread.
+    void request(Callback done);
+
+    // Stepping thread. Returns the number of requests answered.
+    std::size_t serve(const TwinEngine& engine);
+
+private:
+    std::mutex mMutex;   // guards mPending
+    std::vector<Callback> mPending;
+    std::vector<Callback> mServing;   // the stepping thread's
+    std::atomic<bool> mAny{false};
+};
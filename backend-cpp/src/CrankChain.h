@@ -0,0 +1,66 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+
+// The dual instantiation is too large for the inliner's default budget, and
+// out of line every Dual argument and result goes through memory (2.5× the
+// cost in CycleEvaluator::sensitivity()).
+#if defined(_MSC_VER)
+#define TWIN_CHAIN_INLINE __forceinline
+#else
+#define TWIN_CHAIN_INLINE inline __attribute__((always_inline))
+#endif
+
+// Outputs of the crank-slider force chain for a single crank angle.
+template <typename T>
+struct BasicCrankForces {
+    T pistonForceN     = T(0.0f);
+    T rodForceN        = T(0.0f);
+    T tangentialForceN = T(0.0f);
+    T torqueNm         = T(0.0f);
+    T sideThrustN      = T(0.0f);
+};
+
+// ── Crank-slider force chain, generic over its scalar type ──
+// The one reference formulation of the chain. With T = float and a policy's
+// constants it is PhysicsEngine::computeCrankForces(), which the batch kernel
+// (CrankKernel.h) vectorizes across cylinders in step(). With T = Dual<float,
+// N> (Dual.h) the same pass also carries derivatives with respect to the
+// geometry and ω. The crank angle may stay a plain float when no derivative
+// is taken through it, which spares the dual sin/cos of θ.
+template <typename T, typename Angle = T>
+TWIN_CHAIN_INLINE BasicCrankForces<T> crankForceChain(T crankThrowM, T conRodLengthM, T pistonMassKg,
+                                                      Angle angleRad, T omegaRadS, T gasForceN) {
+    using std::asin, std::cos, std::sin;
+    BasicCrankForces<T> f;
+    const T lambda = crankThrowM / conRodLengthM;
+
+    // Piston acceleration (2nd-order approximation):
+    //   a = -R·ω²·(cos θ + λ·cos 2θ)
+    T omega2 = omegaRadS * omegaRadS;
+    Angle cosTheta = cos(angleRad);
+    Angle sinTheta = sin(angleRad);
+    T pistonAccel = -crankThrowM * omega2
+                    * (cosTheta + lambda * cos(2.0f * angleRad));
+    f.pistonForceN = pistonMassKg * pistonAccel + gasForceN;
+
+    // Connecting rod angle from bore axis: φ = asin(λ·sin θ)
+    T sinPhi = lambda * sinTheta;
+    T phi = asin(std::clamp(sinPhi, T(-1.0f), T(1.0f)));
+    T cosPhi = cos(phi);
+
+    // Rod force (along rod axis): F_rod = F_piston / cos φ
+    f.rodForceN = (cosPhi > T(1e-4f)) ? f.pistonForceN / cosPhi : T(0.0f);
+
+    // Tangential force at crank pin (perpendicular to crank arm, drives rotation):
+    //   F_t = F_rod · sin(θ + φ)
+    T thetaPlusPhi = angleRad + phi;
+    f.tangentialForceN = f.rodForceN * sin(thetaPlusPhi);
+
+    // Instantaneous torque: T = F_t · R
+    f.torqueNm = f.tangentialForceN * crankThrowM;
+
+    // Side thrust on cylinder wall: F_side = F_piston · tan φ
+    f.sideThrustN = (cosPhi > T(1e-4f)) ? f.pistonForceN * sinPhi / cosPhi : T(0.0f);
+    return f;
+}
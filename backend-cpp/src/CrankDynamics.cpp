@@ -0,0 +1,55 @@
+#include "CrankDynamics.h"
+#include <cmath>
+#include <cstdlib>
+#include <string>
+
+std::optional<SpeedModel> speedModelFromName(std::string_view name) {
+    if (name == "filter") return SpeedModel::Filter;
+    if (name == "torque") return SpeedModel::Torque;
+    return std::nullopt;
+}
+
+std::optional<LoadModel> LoadModel::parse(std::string_view text) {
+    if (text == "dyno") return LoadModel{};
+
+    constexpr std::string_view kPrefix = "propeller:";
+    if (text.substr(0, kPrefix.size()) != kPrefix) return std::nullopt;
+    std::string s(text.substr(kPrefix.size()));
+    char* end = nullptr;
+    float torque = std::strtof(s.c_str(), &end);
+    if (end == s.c_str() || *end != ':') return std::nullopt;
+    const char* p = end + 1;
+    float rpm = std::strtof(p, &end);
+    if (end == p || *end != '\0') return std::nullopt;
+    if (!(torque > 0.0f) || !(rpm > 0.0f) || !std::isfinite(torque) || !std::isfinite(rpm)) {
+        return std::nullopt;
+    }
+    return propeller(torque, rpm);
+}
+
+void CrankDynamics::configure(float inertiaKgM2, const LoadModel& load, float maxOmegaRadS) {
+    constexpr float kTwoPi = 2.0f * 3.14159265358979323846f;
+    mLoad = load;
+    mInertia = inertiaKgM2;
+    mInverseInertia = 1.0f / inertiaKgM2;
+    mMaxOmega = maxOmegaRadS;
+
+    // J·s² + Kp·s + Ki with natural frequency ωn and damping ζ.
+    const float wn = kTwoPi * load.dynoBandwidthHz;
+    mKp = 2.0f * load.dynoDamping * wn * inertiaKgM2;
+    mKi = wn * wn * inertiaKgM2;
+
+    const float ratedOmega = load.ratedRpm * kTwoPi / 60.0f;
+    mPropellerGain = ratedOmega > 0.0f ? load.ratedTorqueNm / (ratedOmega * ratedOmega) : 0.0f;
+    mHoldLoad = false;
+
+    reset(0.0f);
+}
+
+void CrankDynamics::reset(float omegaRadS) {
+    mOmega = std::clamp(omegaRadS, 0.0f, mMaxOmega);
+    mOmegaPredicted = mOmega;
+    mAccel = 0.0f;
+    mIntegral = 0.0f;
+    mLoadTorqueNm = 0.0f;
+}
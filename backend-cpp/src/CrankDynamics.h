@@ -0,0 +1,162 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <string_view>
+#include "Checkpoint.h"
+
+// How the twin's crank speed evolves.
+enum class SpeedModel {
+    Filter,   // first-order lag toward the RPM target; torque has no effect (cheap)
+    Torque,   // J·dω/dt = engine torque − load torque
+};
+
+std::optional<SpeedModel> speedModelFromName(std::string_view name);
+
+// Resistance on the crankshaft under SpeedModel::Torque.
+struct LoadModel {
+    enum class Kind {
+        Dyno,        // speed-controlled dynamometer holding the RPM target
+        Propeller,   // T = ratedTorque·(ω / ω_rated)², RPM target ignored
+    };
+
+    Kind kind = Kind::Dyno;
+
+    // PI gains are placed for this closed-loop bandwidth and damping on the
+    // crank inertia: slow enough to leave the within-cycle speed ripple alone.
+    // The dyno absorbs positive torque and motors with negative torque.
+    float dynoBandwidthHz = 2.0f;
+    float dynoDamping     = 0.7f;
+    float dynoMaxTorqueNm = 5000.0f;
+
+    float ratedTorqueNm = 0.0f;
+    float ratedRpm      = 6000.0f;
+
+    static LoadModel propeller(float ratedTorqueNm, float ratedRpm) {
+        LoadModel m;
+        m.kind = Kind::Propeller;
+        m.ratedTorqueNm = ratedTorqueNm;
+        m.ratedRpm = ratedRpm;
+        return m;
+    }
+
+    // "dyno" or "propeller:TORQUE_NM:RPM"; nullopt if malformed.
+    static std::optional<LoadModel> parse(std::string_view text);
+};
+
+// ── Crank speed from net torque ──
+// Integrates J·dω/dt = T_engine(θ, ω) − T_load(ω) with velocity Verlet: the
+// angle advances with the start-of-step acceleration, the force chain is
+// evaluated once at the new angle (and predicted speed), and the speed takes
+// the trapezoidal mean of both accelerations. That is second-order accurate
+// and symplectic for the angle-dependent engine torque, at one force
+// evaluation per substep like the filter path. The load terms are damping
+// with h·(∂T_load/∂ω)/J around 1e-3 or less at the supported substep rates, so
+// they stay stable explicitly.
+class CrankDynamics {
+public:
+    // Resets to rest.
+    void configure(float inertiaKgM2, const LoadModel& load, float maxOmegaRadS);
+
+    // Sets the speed and clears acceleration and controller state.
+    void reset(float omegaRadS);
+
+    // Moves the speed to an external estimate; the dyno controller carries on.
+    void setOmega(float omegaRadS) {
+        mOmega = std::clamp(omegaRadS, 0.0f, mMaxOmega);
+        mOmegaPredicted = mOmega;
+    }
+
+    // Replaces the load model by a fixed torque (an estimate of the real
+    // load) until releaseLoad() or configure().
+    void holdLoad(float torqueNm) {
+        mHeldLoadNm = torqueNm;
+        mHoldLoad = true;
+    }
+    void releaseLoad() { mHoldLoad = false; }
+
+    // First half of a step: returns the crank-angle increment over h.
+    float advance(float h) {
+        mOmegaPredicted = mOmega + h * mAccel;
+        return h * mOmega + 0.5f * h * h * mAccel;
+    }
+
+    // Speed at which the force chain for the new angle should be evaluated.
+    [[nodiscard]] float predictedOmega() const { return mOmegaPredicted; }
+
+    // Second half, with the engine torque at the new angle.
+    void correct(float engineTorqueNm, float targetOmegaRadS, float h) {
+        mLoadTorqueNm = loadTorque(mOmegaPredicted, targetOmegaRadS);
+        const float accel = (engineTorqueNm - mLoadTorqueNm) * mInverseInertia;
+        mOmega += 0.5f * h * (mAccel + accel);
+        mAccel = accel;
+
+        if (mLoad.kind == LoadModel::Kind::Dyno) {
+            // Anti-windup: stop integrating while the dyno is saturated.
+            const float error = mOmega - targetOmegaRadS;
+            if (std::abs(mLoadTorqueNm) < mLoad.dynoMaxTorqueNm || error * mIntegral < 0.0f) {
+                mIntegral += h * error;
+            }
+        }
+
+        // The crank neither reverses nor overspeeds past the tables' range.
+        if (mOmega <= 0.0f) {
+            mOmega = 0.0f;
+            mAccel = std::max(mAccel, 0.0f);
+        } else if (mOmega >= mMaxOmega) {
+            mOmega = mMaxOmega;
+            mAccel = std::min(mAccel, 0.0f);
+        }
+    }
+
+    [[nodiscard]] float omega() const { return mOmega; }
+    [[nodiscard]] float loadTorqueNm() const { return mLoadTorqueNm; }
+    [[nodiscard]] float inertiaKgM2() const { return mInertia; }
+
+    // Checkpoint hook (Checkpoint.h): configuration and integrator state.
+    template <typename Self, typename Io>
+    static void visitState(Self& self, Io& io) {
+        io(self.mLoad);
+        if (self.mLoad.kind != LoadModel::Kind::Dyno && self.mLoad.kind != LoadModel::Kind::Propeller) {
+            return io.fail();
+        }
+        io(self.mInertia);
+        io(self.mInverseInertia);
+        io(self.mMaxOmega);
+        io(self.mKp);
+        io(self.mKi);
+        io(self.mPropellerGain);
+        io(self.mOmega);
+        io(self.mOmegaPredicted);
+        io(self.mAccel);
+        io(self.mIntegral);
+        io(self.mLoadTorqueNm);
+        visitFlag(self.mHoldLoad, io);
+        io(self.mHeldLoadNm);
+    }
+
+private:
+    [[nodiscard]] float loadTorque(float omega, float targetOmega) const {
+        if (mHoldLoad) return mHeldLoadNm;
+        if (mLoad.kind == LoadModel::Kind::Propeller) return mPropellerGain * omega * omega;
+        const float t = mKp * (omega - targetOmega) + mKi * mIntegral;
+        return std::clamp(t, -mLoad.dynoMaxTorqueNm, mLoad.dynoMaxTorqueNm);
+    }
+
+    LoadModel mLoad;
+    float mInertia = 1.0f;
+    float mInverseInertia = 1.0f;
+    float mMaxOmega = 0.0f;
+    float mKp = 0.0f;
+    float mKi = 0.0f;
+    float mPropellerGain = 0.0f;
+
+    float mOmega = 0.0f;
+    float mOmegaPredicted = 0.0f;
+    float mAccel = 0.0f;
+    float mIntegral = 0.0f;
+    float mLoadTorqueNm = 0.0f;
+
+    bool mHoldLoad = false;
+    float mHeldLoadNm = 0.0f;
+};
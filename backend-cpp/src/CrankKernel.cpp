@@ -0,0 +1,354 @@
+#include "CrankKernel.h"
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include "CrankTables.h"
+#include "PhysicsEngine.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <immintrin.h>
+#define TWIN_KERNEL_X86 1
+#endif
+
+// MSVC's /arch:AVX2 implies FMA but does not define __FMA__.
+#if defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+#define TWIN_KERNEL_FMA 1
+#endif
+
+namespace {
+
+// Quadrant reduction: x = j·π/2 + r, with π/2 split so j·kPiO2A is exact for
+// |j| < 2^16 (kPiO2A has 8 significant bits).
+constexpr float kTwoOverPi = 0.636619772367581343f;
+constexpr float kPiO2A     = 1.5703125f;
+constexpr float kPiO2B     = 4.837512969970703125e-4f;
+constexpr float kPiO2C     = 7.54978995489188216e-8f;
+
+// Minimax coefficients on [-π/4, π/4] (Cephes sinf/cosf).
+constexpr float kSin1 = -1.6666654611e-1f;
+constexpr float kSin2 =  8.3321608736e-3f;
+constexpr float kSin3 = -1.9515295891e-4f;
+constexpr float kCos1 =  4.166664568298827e-2f;
+constexpr float kCos2 = -1.388731625493765e-3f;
+constexpr float kCos3 =  2.443315711809948e-5f;
+
+// ── ISA wrappers ──
+// Each provides the same small set of operations so the kernel below is
+// written once. M is the per-lane predicate type, I the 32-bit integer vector.
+
+struct IsaScalar {
+    static constexpr std::size_t kWidth = 1;
+    static constexpr const char* kName = "scalar";
+    using F = float;
+    using I = int32_t;
+    using M = bool;
+
+    static F load(const float* p)   { return *p; }
+    static void store(float* p, F v) { *p = v; }
+    static F set1(float x)          { return x; }
+    static F add(F a, F b)          { return a + b; }
+    static F mul(F a, F b)          { return a * b; }
+    static F div(F a, F b)          { return a / b; }
+#ifdef TWIN_KERNEL_FMA
+    static F fmadd(F a, F b, F c)   { return std::fma(a, b, c); }
+    static F fnmadd(F a, F b, F c)  { return std::fma(-a, b, c); }
+#else
+    static F fmadd(F a, F b, F c)   { return a * b + c; }
+    static F fnmadd(F a, F b, F c)  { return c - a * b; }
+#endif
+    static F sqrt(F a)              { return std::sqrt(a); }
+    static I roundToInt(F a)        { return static_cast<I>(std::nearbyint(a)); }
+    static F toFloat(I a)           { return static_cast<F>(a); }
+    static I addI(I a, int32_t k)   { return a + k; }
+    static M isOdd(I a)             { return (a & 1) != 0; }
+    static F select(M m, F a, F b)  { return m ? a : b; }
+    static I bit1ToSign(I a) {
+        return static_cast<I>(static_cast<uint32_t>(a & 2) << 30);
+    }
+    static F xorSign(F x, I s) {
+        return std::bit_cast<F>(std::bit_cast<uint32_t>(x) ^ static_cast<uint32_t>(s));
+    }
+};
+
+#ifdef TWIN_KERNEL_X86
+struct IsaSse2 {
+    static constexpr std::size_t kWidth = 4;
+    static constexpr const char* kName = "sse2";
+    using F = __m128;
+    using I = __m128i;
+    using M = __m128;
+
+    static F load(const float* p)   { return _mm_loadu_ps(p); }
+    static void store(float* p, F v) { _mm_storeu_ps(p, v); }
+    static F set1(float x)          { return _mm_set1_ps(x); }
+    static F add(F a, F b)          { return _mm_add_ps(a, b); }
+    static F mul(F a, F b)          { return _mm_mul_ps(a, b); }
+    static F div(F a, F b)          { return _mm_div_ps(a, b); }
+    static F fmadd(F a, F b, F c)   { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+    static F fnmadd(F a, F b, F c)  { return _mm_sub_ps(c, _mm_mul_ps(a, b)); }
+    static F sqrt(F a)              { return _mm_sqrt_ps(a); }
+    static I roundToInt(F a)        { return _mm_cvtps_epi32(a); }
+    static F toFloat(I a)           { return _mm_cvtepi32_ps(a); }
+    static I addI(I a, int32_t k)   { return _mm_add_epi32(a, _mm_set1_epi32(k)); }
+    static M isOdd(I a) {
+        I one = _mm_set1_epi32(1);
+        return _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(a, one), one));
+    }
+    static F select(M m, F a, F b)  { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+    static I bit1ToSign(I a)        { return _mm_slli_epi32(_mm_and_si128(a, _mm_set1_epi32(2)), 30); }
+    static F xorSign(F x, I s)      { return _mm_xor_ps(x, _mm_castsi128_ps(s)); }
+};
+#endif
+
+#if defined(TWIN_KERNEL_X86) && defined(TWIN_KERNEL_FMA)
+struct IsaAvx2 {
+    static constexpr std::size_t kWidth = 8;
+    static constexpr const char* kName = "avx2";
+    using F = __m256;
+    using I = __m256i;
+    using M = __m256;
+
+    static F load(const float* p)   { return _mm256_loadu_ps(p); }
+    static void store(float* p, F v) { _mm256_storeu_ps(p, v); }
+    static F set1(float x)          { return _mm256_set1_ps(x); }
+    static F add(F a, F b)          { return _mm256_add_ps(a, b); }
+    static F mul(F a, F b)          { return _mm256_mul_ps(a, b); }
+    static F div(F a, F b)          { return _mm256_div_ps(a, b); }
+    static F fmadd(F a, F b, F c)   { return _mm256_fmadd_ps(a, b, c); }
+    static F fnmadd(F a, F b, F c)  { return _mm256_fnmadd_ps(a, b, c); }
+    static F sqrt(F a)              { return _mm256_sqrt_ps(a); }
+    static I roundToInt(F a)        { return _mm256_cvtps_epi32(a); }
+    static F toFloat(I a)           { return _mm256_cvtepi32_ps(a); }
+    static I addI(I a, int32_t k)   { return _mm256_add_epi32(a, _mm256_set1_epi32(k)); }
+    static M isOdd(I a) {
+        I one = _mm256_set1_epi32(1);
+        return _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(a, one), one));
+    }
+    static F select(M m, F a, F b)  { return _mm256_blendv_ps(b, a, m); }
+    static I bit1ToSign(I a) {
+        return _mm256_slli_epi32(_mm256_and_si256(a, _mm256_set1_epi32(2)), 30);
+    }
+    static F xorSign(F x, I s)      { return _mm256_xor_ps(x, _mm256_castsi256_ps(s)); }
+};
+#endif
+
+#if defined(TWIN_KERNEL_X86) && defined(__AVX512F__)
+struct IsaAvx512 {
+    static constexpr std::size_t kWidth = 16;
+    static constexpr const char* kName = "avx512";
+    using F = __m512;
+    using I = __m512i;
+    using M = __mmask16;
+
+    static F load(const float* p)   { return _mm512_loadu_ps(p); }
+    static void store(float* p, F v) { _mm512_storeu_ps(p, v); }
+    static F set1(float x)          { return _mm512_set1_ps(x); }
+    static F add(F a, F b)          { return _mm512_add_ps(a, b); }
+    static F mul(F a, F b)          { return _mm512_mul_ps(a, b); }
+    static F div(F a, F b)          { return _mm512_div_ps(a, b); }
+    static F fmadd(F a, F b, F c)   { return _mm512_fmadd_ps(a, b, c); }
+    static F fnmadd(F a, F b, F c)  { return _mm512_fnmadd_ps(a, b, c); }
+    static F sqrt(F a)              { return _mm512_sqrt_ps(a); }
+    static I roundToInt(F a)        { return _mm512_cvtps_epi32(a); }
+    static F toFloat(I a)           { return _mm512_cvtepi32_ps(a); }
+    static I addI(I a, int32_t k)   { return _mm512_add_epi32(a, _mm512_set1_epi32(k)); }
+    static M isOdd(I a)             { return _mm512_test_epi32_mask(a, _mm512_set1_epi32(1)); }
+    static F select(M m, F a, F b)  { return _mm512_mask_blend_ps(m, b, a); }
+    static I bit1ToSign(I a) {
+        return _mm512_slli_epi32(_mm512_and_si512(a, _mm512_set1_epi32(2)), 30);
+    }
+    static F xorSign(F x, I s) {
+        return _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(x), s));
+    }
+};
+#endif
+
+#if defined(TWIN_KERNEL_X86) && defined(__AVX512F__)
+using IsaBest = IsaAvx512;
+#elif defined(TWIN_KERNEL_X86) && defined(TWIN_KERNEL_FMA)
+using IsaBest = IsaAvx2;
+#elif defined(TWIN_KERNEL_X86)
+using IsaBest = IsaSse2;
+#else
+using IsaBest = IsaScalar;
+#endif
+
+// ── Shared math ──
+
+template <class O>
+inline void sinCosPoly(typename O::F x, typename O::F& s, typename O::F& c) {
+    using F = typename O::F;
+    using I = typename O::I;
+
+    I j = O::roundToInt(O::mul(x, O::set1(kTwoOverPi)));
+    F jf = O::toFloat(j);
+    F r = O::fnmadd(jf, O::set1(kPiO2A), x);
+    r = O::fnmadd(jf, O::set1(kPiO2B), r);
+    r = O::fnmadd(jf, O::set1(kPiO2C), r);
+    F z = O::mul(r, r);
+
+    // sin r ≈ r + r·z·(s1 + z·(s2 + z·s3))
+    F ps = O::fmadd(O::set1(kSin3), z, O::set1(kSin2));
+    ps = O::fmadd(ps, z, O::set1(kSin1));
+    ps = O::fmadd(O::mul(ps, z), r, r);
+
+    // cos r ≈ 1 - z/2 + z²·(c1 + z·(c2 + z·c3))
+    F pc = O::fmadd(O::set1(kCos3), z, O::set1(kCos2));
+    pc = O::fmadd(pc, z, O::set1(kCos1));
+    pc = O::fmadd(O::mul(pc, z), z, O::fnmadd(O::set1(0.5f), z, O::set1(1.0f)));
+
+    // Quadrant q = j mod 4: odd quadrants swap sin/cos, then sin is negated
+    // for q ∈ {2,3} and cos for q ∈ {1,2}.
+    typename O::M odd = O::isOdd(j);
+    F sRaw = O::select(odd, pc, ps);
+    F cRaw = O::select(odd, ps, pc);
+    s = O::xorSign(sRaw, O::bit1ToSign(j));
+    c = O::xorSign(cRaw, O::bit1ToSign(O::addI(j, 1)));
+}
+
+// Geometry scalars the force chain needs. Passed by value into an inlined
+// call, a constexpr instance folds exactly like template constants would.
+struct ChainConstants {
+    float lambda;
+    float crankThrow;
+    float pistonMass;
+};
+
+template <class G>
+constexpr ChainConstants chainConstantsOf() {
+    using PE = BasicPhysicsEngine<G>;
+    return { PE::kLambda, PE::kCrankThrow, PE::kPistonMass };
+}
+
+template <class O>
+inline void crankForcesAt(ChainConstants k, const float* angleRad, const float* omegaRadS,
+                          const float* gasForceN, std::size_t i, const CrankForceArrays& out) {
+    using F = typename O::F;
+
+    F theta = O::load(angleRad + i);
+    F omega = O::load(omegaRadS + i);
+
+    F sinTheta, cosTheta;
+    sinCosPoly<O>(theta, sinTheta, cosTheta);
+
+    // a = -R·ω²·(cos θ + λ·cos 2θ), cos 2θ = 2cos²θ - 1
+    F omega2 = O::mul(omega, omega);
+    F cos2Theta = O::fmadd(O::add(cosTheta, cosTheta), cosTheta, O::set1(-1.0f));
+    F kinematic = O::fmadd(O::set1(k.lambda), cos2Theta, cosTheta);
+    F pistonAccel = O::mul(O::mul(O::set1(-k.crankThrow), omega2), kinematic);
+    F piston = O::mul(O::set1(k.pistonMass), pistonAccel);
+    if (gasForceN) piston = O::add(piston, O::load(gasForceN + i));
+
+    // sin φ = λ·sin θ, cos φ = √(1 - sin²φ)
+    F sinPhi = O::mul(O::set1(k.lambda), sinTheta);
+    F cosPhi = O::sqrt(O::fnmadd(sinPhi, sinPhi, O::set1(1.0f)));
+
+    F rod = O::div(piston, cosPhi);
+    F sinThetaPlusPhi = O::fmadd(sinTheta, cosPhi, O::mul(cosTheta, sinPhi));
+    F tangential = O::mul(rod, sinThetaPlusPhi);
+    F torque = O::mul(tangential, O::set1(k.crankThrow));
+    F side = O::div(O::mul(piston, sinPhi), cosPhi);
+
+    O::store(out.pistonForceN + i, piston);
+    O::store(out.rodForceN + i, rod);
+    O::store(out.tangentialForceN + i, tangential);
+    O::store(out.torqueNm + i, torque);
+    O::store(out.sideThrustN + i, side);
+}
+
+template <class O>
+inline void crankForcesLoop(ChainConstants k, const float* angleRad, const float* omegaRadS,
+                            const float* gasForceN, std::size_t count,
+                            const CrankForceArrays& out) {
+    std::size_t i = 0;
+    for (; i + O::kWidth <= count; i += O::kWidth) {
+        crankForcesAt<O>(k, angleRad, omegaRadS, gasForceN, i, out);
+    }
+    for (; i < count; ++i) {
+        crankForcesAt<IsaScalar>(k, angleRad, omegaRadS, gasForceN, i, out);
+    }
+}
+
+} // namespace
+
+template <typename Geometry>
+void computeCrankForcesBatch(const float* angleRad, const float* omegaRadS,
+                             std::size_t count, const CrankForceArrays& out) {
+    computeCrankForcesBatch<Geometry>(angleRad, omegaRadS, nullptr, count, out);
+}
+
+#if defined(TWIN_KINEMATICS_TABLE)
+
+// Build-time alternative (TWIN_KINEMATICS=table-linear|table-cubic): every
+// angle factor comes from CrankAngleTable, leaving only multiplies per sample.
+template <typename Geometry>
+void computeCrankForcesBatch(const float* angleRad, const float* omegaRadS,
+                             const float* gasForceN, std::size_t count,
+                             const CrankForceArrays& out) {
+    using PE = BasicPhysicsEngine<Geometry>;
+    using Table = BasicCrankAngleTable<Geometry>;
+    for (std::size_t i = 0; i < count; ++i) {
+#if TWIN_KINEMATICS_TABLE == 2
+        KinematicFactors k = Table::cubic(angleRad[i]);
+#else
+        KinematicFactors k = Table::linear(angleRad[i]);
+#endif
+        float omega2 = omegaRadS[i] * omegaRadS[i];
+        float piston = PE::kPistonMass * (-PE::kCrankThrow * omega2 * k.accel);
+        if (gasForceN) piston += gasForceN[i];
+        float tangential = piston * k.tangential;
+        out.pistonForceN[i]     = piston;
+        out.rodForceN[i]        = piston * k.invCosPhi;
+        out.tangentialForceN[i] = tangential;
+        out.torqueNm[i]         = tangential * PE::kCrankThrow;
+        out.sideThrustN[i]      = piston * k.tanPhi;
+    }
+}
+
+const char* crankKernelIsa() {
+    return TWIN_KINEMATICS_TABLE == 2 ? "table-cubic" : "table-linear";
+}
+
+std::size_t crankKernelWidth() { return 1; }
+
+#else
+
+template <typename Geometry>
+void computeCrankForcesBatch(const float* angleRad, const float* omegaRadS,
+                             const float* gasForceN, std::size_t count,
+                             const CrankForceArrays& out) {
+    constexpr ChainConstants k = chainConstantsOf<Geometry>();
+    crankForcesLoop<IsaBest>(k, angleRad, omegaRadS, gasForceN, count, out);
+}
+
+const char* crankKernelIsa() { return IsaBest::kName; }
+
+std::size_t crankKernelWidth() { return IsaBest::kWidth; }
+
+#endif
+
+#define TWIN_INSTANTIATE_CRANK_KERNEL(G)                                                  \
+    template void computeCrankForcesBatch<G>(const float*, const float*, std::size_t,   \
+                                             const CrankForceArrays&);                   \
+    template void computeCrankForcesBatch<G>(const float*, const float*, const float*,  \
+                                             std::size_t, const CrankForceArrays&);
+
+TWIN_INSTANTIATE_CRANK_KERNEL(DefaultGeometry)
+TWIN_INSTANTIATE_CRANK_KERNEL(CompactGeometry)
+TWIN_INSTANTIATE_CRANK_KERNEL(HeavyDutyGeometry)
+
+#undef TWIN_INSTANTIATE_CRANK_KERNEL
+
+// Runtime geometry always takes the polynomial path: the crank-angle tables
+// are generated per compile-time λ.
+void computeCrankForcesBatch(const CrankGeometry& geometry, const float* angleRad,
+                             const float* omegaRadS, const float* gasForceN, std::size_t count,
+                             const CrankForceArrays& out) {
+    const ChainConstants k{ geometry.crankThrowM / geometry.conRodLengthM,
+                            geometry.crankThrowM, geometry.pistonMassKg };
+    crankForcesLoop<IsaBest>(k, angleRad, omegaRadS, gasForceN, count, out);
+}
+
+void sinCosApprox(float x, float& sinOut, float& cosOut) {
+    sinCosPoly<IsaScalar>(x, sinOut, cosOut);
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include <cstddef>
+#include "Geometry.h"
+
+// ── Vectorized crank-slider force kernel ──
+// Evaluates the same piston → rod → tangential → torque → side-thrust chain as
+// PhysicsEngine::computeCrankForces() for a whole array of (angle, omega)
+// pairs, 4/8/16 lanes at a time (SSE2 / AVX2+FMA / AVX-512F, picked at compile
+// time via TWIN_SIMD), with a scalar fallback running the identical
+// polynomials for tails and non-x86 targets.
+//
+// Only one transcendental is approximated: sin θ and cos θ share a single
+// quadrant reduction (Cody–Waite, three-part π/2) and a pair of minimax
+// polynomials on [-π/4, π/4]. Everything else follows from identities:
+//   cos 2θ     = 2·cos²θ - 1
+//   cos φ      = √(1 - λ²·sin²θ)           (replaces asin + cos)
+//   sin(θ + φ) = sin θ·cos φ + cos θ·sin φ
+// so the kernel needs no asin at all, and cos φ ≥ √(1 - λ²) > 0.95 removes the
+// reference path's divide-by-zero guard.
+//
+// Error bounds (float, |θ| ≤ 1e4 rad):
+//   sin/cos vs. double libm:        ≤ 1e-7 absolute
+//   each force vs. the libm chain:  ≤ 1e-6 × its peak magnitude at the given ω
+// `kernel_bench` reports the measured error against PhysicsEngine::step().
+//
+// Configuring with TWIN_KINEMATICS=table-linear|table-cubic swaps the
+// polynomials for the compile-time tables in CrankTables.h (scalar loop).
+//
+// The batch entry points are instantiated per geometry policy (Geometry.h) so
+// the crank throw, λ and piston mass stay compile-time constants in the loop.
+
+struct CrankForceArrays {
+    float* pistonForceN     = nullptr;
+    float* rodForceN        = nullptr;
+    float* tangentialForceN = nullptr;
+    float* torqueNm         = nullptr;
+    float* sideThrustN      = nullptr;
+};
+
+// Computes forces for `count` samples. Inputs and outputs are plain arrays;
+// no alignment is required. Output arrays may alias neither input.
+template <typename Geometry = DefaultGeometry>
+void computeCrankForcesBatch(const float* angleRad, const float* omegaRadS,
+                             std::size_t count, const CrankForceArrays& out);
+
+// Same, with a per-sample gas force (N, positive toward the crank) added to
+// the inertial piston force before the rod/tangential/side-thrust chain.
+template <typename Geometry = DefaultGeometry>
+void computeCrankForcesBatch(const float* angleRad, const float* omegaRadS,
+                             const float* gasForceN, std::size_t count,
+                             const CrankForceArrays& out);
+
+// Crank-slider dimensions supplied at runtime, for tools that vary geometry
+// (parameter sweeps) rather than pick one of the compiled policies.
+// Requires conRodLengthM > crankThrowM > 0.
+struct CrankGeometry {
+    float crankThrowM   = DefaultGeometry::kCrankThrow;
+    float conRodLengthM = DefaultGeometry::kConRodLength;
+    float pistonMassKg  = DefaultGeometry::kPistonMass;
+};
+
+// Same chain with geometry as data; gasForceN may be null. Always uses the
+// polynomial path, even in TWIN_KINEMATICS table builds.
+void computeCrankForcesBatch(const CrankGeometry& geometry, const float* angleRad,
+                             const float* omegaRadS, const float* gasForceN, std::size_t count,
+                             const CrankForceArrays& out);
+
+// Polynomial sin/cos used by every lane, exposed for accuracy reporting.
+void sinCosApprox(float x, float& sinOut, float& cosOut);
+
+// Name and lane count of the instruction set compiled into the batch kernel.
+[[nodiscard]] const char* crankKernelIsa();
+[[nodiscard]] std::size_t crankKernelWidth();
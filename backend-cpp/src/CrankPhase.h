@@ -0,0 +1,144 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include "EngineLayout.h"
+
+// ── Crank phase accumulators ──
+// The crank angle is the one piece of twin state integrated open-loop over
+// the whole run: every substep adds ω·h and wraps. Its number format sets how
+// far the phase drifts over a long run. BasicPhysicsEngine takes one of these
+// as its Phase parameter. Each tracks the four-stroke cycle angle (0…4π) and
+// the crank angle (0…2π), and reads both out as float for the force chain.
+//
+//   FloatPhase   float radians, as the engine always did. Each add rounds to
+//                half an ulp of the running angle (up to 2.4e-7 rad at 4π).
+//   DoublePhase  double radians, with ω·h formed in double. Each add rounds
+//                to about 1e-15 rad.
+//   FixedPhase   32-bit unsigned fraction of a cycle; wrap-around is integer
+//                overflow and an add is exact. The step itself is rounded to
+//                one unit (4π / 2³² ≈ 2.9e-9 rad), so at a steady speed the
+//                error is a fixed frequency offset of at most half a unit per
+//                step, not an accumulating rounding walk.
+//
+// advance() returns the step actually taken in radians, for consumers that
+// integrate per-substep quantities (revolution stats, the angle grid).
+// raw() exposes the stored phase of the wider formats for error studies.
+// visitState() is the checkpoint hook (Checkpoint.h): the stored phase,
+// exactly.
+struct FloatPhase {
+    static constexpr const char* kName = "float";
+
+    // ω·h in float; the step the dynamics integrator already took.
+    float advance(float omegaRadS, float dtS) { return advanceBy(omegaRadS * dtS); }
+    float advanceBy(float dAngleRad) {
+        mCrankRad += dAngleRad;
+        if (mCrankRad >= kTwoPi) mCrankRad -= kTwoPi;
+        if (mCrankRad < 0.0f)    mCrankRad += kTwoPi;
+
+        mCycleRad += dAngleRad;
+        if (mCycleRad >= kCycleRad) mCycleRad -= kCycleRad;
+        return dAngleRad;
+    }
+
+    void set(float cycleRad) {
+        mCycleRad = cycleRad;
+        mCrankRad = std::fmod(cycleRad, kTwoPi);
+    }
+
+    [[nodiscard]] float cycleRad() const { return mCycleRad; }
+    [[nodiscard]] float crankRad() const { return mCrankRad; }
+
+    template <typename Self, typename Io>
+    static void visitState(Self& self, Io& io) {
+        io(self.mCrankRad);
+        io(self.mCycleRad);
+    }
+
+private:
+    static constexpr float kTwoPi    = 2.0f * EngineLayout::kPi;
+    static constexpr float kCycleRad = EngineLayout::kCycleRad;
+
+    float mCrankRad = 0.0f;
+    float mCycleRad = 0.0f;
+};
+
+struct DoublePhase {
+    static constexpr const char* kName = "double";
+
+    float advance(float omegaRadS, float dtS) {
+        return add(static_cast<double>(omegaRadS) * static_cast<double>(dtS));
+    }
+    float advanceBy(float dAngleRad) { return add(static_cast<double>(dAngleRad)); }
+
+    void set(float cycleRad) { mCycleRad = std::fmod(static_cast<double>(cycleRad), kCycleRad); }
+
+    [[nodiscard]] float cycleRad() const { return toFloat(mCycleRad, kCycleRad); }
+    [[nodiscard]] float crankRad() const {
+        return toFloat(mCycleRad >= kTwoPi ? mCycleRad - kTwoPi : mCycleRad, kTwoPi);
+    }
+
+    [[nodiscard]] double raw() const { return mCycleRad; }
+
+    template <typename Self, typename Io>
+    static void visitState(Self& self, Io& io) { io(self.mCycleRad); }
+
+private:
+    static constexpr double kTwoPi    = 2.0 * 3.14159265358979323846;
+    static constexpr double kCycleRad = 2.0 * kTwoPi;
+
+    float add(double dAngleRad) {
+        mCycleRad += dAngleRad;
+        if (mCycleRad >= kCycleRad) mCycleRad -= kCycleRad;
+        if (mCycleRad < 0.0)        mCycleRad += kCycleRad;
+        return static_cast<float>(dAngleRad);
+    }
+
+    // Rounding to float can land exactly on the period; keep [0, period).
+    static float toFloat(double rad, double period) {
+        const float f = static_cast<float>(rad);
+        return f >= static_cast<float>(period) ? 0.0f : f;
+    }
+
+    double mCycleRad = 0.0;
+};
+
+struct FixedPhase {
+    static constexpr const char* kName = "fixed32";
+
+    float advance(float omegaRadS, float dtS) {
+        return add(static_cast<double>(omegaRadS) * static_cast<double>(dtS));
+    }
+    float advanceBy(float dAngleRad) { return add(static_cast<double>(dAngleRad)); }
+
+    void set(float cycleRad) {
+        const double turns = static_cast<double>(cycleRad) / kCycleRad;
+        mCycle = static_cast<uint32_t>(static_cast<int64_t>(std::llround((turns - std::floor(turns)) * kUnits)));
+    }
+
+    [[nodiscard]] float cycleRad() const { return toFloat(mCycle, kCycleRad); }
+    // The crank angle is the cycle's first bit dropped: 2³² units per turn.
+    [[nodiscard]] float crankRad() const { return toFloat(mCycle << 1, kCycleRad / 2.0); }
+
+    [[nodiscard]] uint32_t raw() const { return mCycle; }   // units of 4π / 2³²
+
+    template <typename Self, typename Io>
+    static void visitState(Self& self, Io& io) { io(self.mCycle); }
+
+private:
+    static constexpr double kCycleRad = 4.0 * 3.14159265358979323846;
+    static constexpr double kUnits    = 4294967296.0;   // 2³² per cycle
+
+    float add(double dAngleRad) {
+        // Signed steps wrap the same way as positive ones.
+        const int64_t step = std::llround(dAngleRad / kCycleRad * kUnits);
+        mCycle += static_cast<uint32_t>(step);
+        return static_cast<float>(static_cast<double>(step) * (kCycleRad / kUnits));
+    }
+
+    static float toFloat(uint32_t units, double period) {
+        const float f = static_cast<float>(static_cast<double>(units) * (period / kUnits));
+        return f >= static_cast<float>(period) ? 0.0f : f;
+    }
+
+    uint32_t mCycle = 0;
+};
@@ -0,0 +1,85 @@
+#include "CycleEvaluator.h"
+#include <algorithm>
+#include <cmath>
+#include "CrankChain.h"
+#include "Dual.h"
+#include "GasPressure.h"
+#include "PhysicsEngine.h"
+
+CycleEvaluator::CycleEvaluator(std::size_t samplesPerCycle)
+    : mAngle(samplesPerCycle)
+    , mOmega(samplesPerCycle, 0.0f)
+    , mGas(samplesPerCycle, 0.0f)
+    , mGasSlope(samplesPerCycle, 0.0f)
+    , mPiston(samplesPerCycle)
+    , mRod(samplesPerCycle)
+    , mTangential(samplesPerCycle)
+    , mTorque(samplesPerCycle)
+    , mSide(samplesPerCycle)
+{
+    for (std::size_t k = 0; k < samplesPerCycle; ++k) {
+        mAngle[k] = EngineLayout::kCycleRad * static_cast<float>(k)
+                    / static_cast<float>(samplesPerCycle);
+    }
+}
+
+void CycleEvaluator::setOperatingPoint(float rpm, float load) {
+    mRpm = rpm;
+    std::fill(mOmega.begin(), mOmega.end(), rpm * PhysicsEngine::kTwoPi / 60.0f);
+
+    load = std::clamp(load, 0.0f, 1.0f);
+    mGasEnabled = load > 0.0f;
+    if (!mGasEnabled) return;
+
+    const GasPressureTable& table = GasPressureTable::instance<DefaultGeometry>();
+    const GasPressureTable::Slice slice = table.slice(load, rpm);
+    const GasPressureTable::Slice slope = table.rpmSlope(load, rpm);
+    for (std::size_t k = 0; k < mAngle.size(); ++k) {
+        mGas[k] = (GasPressureTable::pressurePa(slice, mAngle[k])
+                   - GasPressureTable::kCrankcasePa) * PhysicsEngine::kBoreArea;
+        mGasSlope[k] = GasPressureTable::pressurePa(slope, mAngle[k]) * PhysicsEngine::kBoreArea;
+    }
+}
+
+CyclePeaks CycleEvaluator::evaluate(const CrankGeometry& geometry) {
+    const std::size_t n = mAngle.size();
+    computeCrankForcesBatch(geometry, mAngle.data(), mOmega.data(),
+                            mGasEnabled ? mGas.data() : nullptr, n,
+                            {mPiston.data(), mRod.data(), mTangential.data(),
+                             mTorque.data(), mSide.data()});
+
+    float rodMax = mRod[0], rodMin = mRod[0], sideMax = 0.0f, torquePeak = 0.0f;
+    float torqueSum = 0.0f;
+    for (std::size_t k = 0; k < n; ++k) {
+        rodMax = std::max(rodMax, mRod[k]);
+        rodMin = std::min(rodMin, mRod[k]);
+        sideMax = std::max(sideMax, std::abs(mSide[k]));
+        torquePeak = std::max(torquePeak, std::abs(mTorque[k]));
+        torqueSum += mTorque[k];
+    }
+    return {rodMax, rodMin, sideMax, torqueSum / static_cast<float>(n), torquePeak};
+}
+
+CycleSensitivity CycleEvaluator::sensitivity(const CrankGeometry& geometry) const {
+    using D = Dual<float, kDesignParameters>;
+    constexpr auto index = [](DesignParameter p) { return static_cast<std::size_t>(p); };
+
+    const D throwM = D::variable(geometry.crankThrowM, index(DesignParameter::CrankThrowM));
+    const D rodM   = D::variable(geometry.conRodLengthM, index(DesignParameter::ConRodLengthM));
+    const D massKg = D::variable(geometry.pistonMassKg, index(DesignParameter::PistonMassKg));
+    D omega(mRpm * PhysicsEngine::kTwoPi / 60.0f);
+    omega.tangent[index(DesignParameter::Rpm)] = PhysicsEngine::kTwoPi / 60.0f;   // dω/drpm
+
+    D rodMax, rodMin;
+    for (std::size_t k = 0; k < mAngle.size(); ++k) {
+        D gas;
+        if (mGasEnabled) {
+            gas.value = mGas[k];
+            gas.tangent[index(DesignParameter::Rpm)] = mGasSlope[k];
+        }
+        const D rod = crankForceChain<D, float>(throwM, rodM, massKg, mAngle[k], omega, gas).rodForceN;
+        if (k == 0 || rod > rodMax) rodMax = rod;
+        if (k == 0 || rod < rodMin) rodMin = rod;
+    }
+    return {rodMax.value, rodMin.value, rodMax.tangent, rodMin.tangent};
+}
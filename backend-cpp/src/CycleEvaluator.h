@@ -0,0 +1,71 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "CrankKernel.h"
+
+// Design-relevant extremes of the force chain over one four-stroke cycle.
+struct CyclePeaks {
+    float rodForceMaxN   = 0.0f;   // peak compression
+    float rodForceMinN   = 0.0f;   // peak tension (negative)
+    float sideThrustMaxN = 0.0f;   // peak |side thrust|
+    float torqueMeanNm   = 0.0f;
+    float torquePeakNm   = 0.0f;   // peak |torque|
+};
+
+// Inputs CycleSensitivity differentiates with respect to.
+enum class DesignParameter : uint8_t { CrankThrowM, ConRodLengthM, PistonMassKg, Rpm };
+inline constexpr std::size_t kDesignParameters = 4;
+
+// Peak rod forces and their gradients in DesignParameter order: N per metre,
+// per kg and per rpm.
+struct CycleSensitivity {
+    float rodForceMaxN = 0.0f;
+    float rodForceMinN = 0.0f;
+    std::array<float, kDesignParameters> rodForceMaxGrad{};
+    std::array<float, kDesignParameters> rodForceMinGrad{};
+};
+
+// ── Full-cycle evaluation of the crank-slider chain for a runtime geometry ──
+// Samples 720° of crank angle at a fixed operating point, runs the batch
+// kernel once and reduces the result to CyclePeaks. Owns its scratch, so one
+// instance per thread; the angle grid and gas trace are reused across calls
+// until the operating point changes.
+//
+// With load > 0 the gas force comes from the default chamber's pressure trace
+// (GasPressureTable for DefaultGeometry) on the default bore. The effect of
+// throw and rod length on the compression ratio is not modelled.
+class CycleEvaluator {
+public:
+    explicit CycleEvaluator(std::size_t samplesPerCycle = 720);
+
+    void setOperatingPoint(float rpm, float load);
+
+    [[nodiscard]] CyclePeaks evaluate(const CrankGeometry& geometry);
+
+    // Rod force peaks with their gradients, from one forward-mode pass:
+    // crankForceChain() runs on Dual<float, 4> (Dual.h) seeded with the three
+    // dimensions and RPM, so every sample carries all four derivatives. Each
+    // peak takes the gradient of the sample it comes from, which is the
+    // derivative of the sampled peak. The gas force's RPM dependence enters
+    // through GasPressureTable::rpmSlope(). Values come from the scalar chain
+    // rather than the kernel's polynomial sin/cos, so they agree with
+    // evaluate() to the kernel's error.
+    [[nodiscard]] CycleSensitivity sensitivity(const CrankGeometry& geometry) const;
+
+    [[nodiscard]] std::size_t samplesPerCycle() const { return mAngle.size(); }
+
+private:
+    std::vector<float> mAngle;
+    std::vector<float> mOmega;
+    std::vector<float> mGas;
+    std::vector<float> mGasSlope;   // ∂gas/∂rpm, N per rpm
+    std::vector<float> mPiston;
+    std::vector<float> mRod;
+    std::vector<float> mTangential;
+    std::vector<float> mTorque;
+    std::vector<float> mSide;
+    float mRpm = 0.0f;
+    bool mGasEnabled = false;
+};
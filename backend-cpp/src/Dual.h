@@ -0,0 +1,111 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+// ── Forward-mode dual number with N tangent directions ──
+// A value plus its derivatives with respect to N independent inputs,
+// propagated through every operation by the chain rule. Seeding input i with
+// variable(x, i) and running a computation once yields the value and all N
+// partial derivatives. The tangents are a fixed-size array updated in
+// straight-line loops, so for N = 4 floats each operation updates all four
+// directions in one SSE register.
+//
+// Covers what the crank-slider chain (CrankChain.h) needs: + - * /, sin,
+// cos, asin, sqrt, and comparisons on the value. A plain T converts
+// implicitly to a constant (zero tangents).
+template <typename T, std::size_t N>
+struct Dual {
+    T value{};
+    std::array<T, N> tangent{};
+
+    constexpr Dual() = default;
+    constexpr Dual(T v) : value(v) {}   // NOLINT: constants convert implicitly
+
+    // Input `direction` of the N, with unit tangent there.
+    static constexpr Dual variable(T v, std::size_t direction) {
+        Dual d(v);
+        d.tangent[direction] = T(1);
+        return d;
+    }
+
+    // ── Arithmetic ──
+    friend constexpr Dual operator-(const Dual& a) {
+        Dual r(-a.value);
+        for (std::size_t k = 0; k < N; ++k) r.tangent[k] = -a.tangent[k];
+        return r;
+    }
+    friend constexpr Dual operator+(const Dual& a, const Dual& b) {
+        Dual r(a.value + b.value);
+        for (std::size_t k = 0; k < N; ++k) r.tangent[k] = a.tangent[k] + b.tangent[k];
+        return r;
+    }
+    friend constexpr Dual operator+(const Dual& a, T b) {
+        Dual r = a;
+        r.value += b;
+        return r;
+    }
+    friend constexpr Dual operator+(T a, const Dual& b) { return b + a; }
+    friend constexpr Dual operator-(const Dual& a, const Dual& b) {
+        Dual r(a.value - b.value);
+        for (std::size_t k = 0; k < N; ++k) r.tangent[k] = a.tangent[k] - b.tangent[k];
+        return r;
+    }
+    friend constexpr Dual operator-(const Dual& a, T b) {
+        Dual r = a;
+        r.value -= b;
+        return r;
+    }
+    friend constexpr Dual operator-(T a, const Dual& b) { return -b + a; }
+    friend constexpr Dual operator*(const Dual& a, const Dual& b) {
+        Dual r(a.value * b.value);
+        for (std::size_t k = 0; k < N; ++k) r.tangent[k] = a.tangent[k] * b.value + a.value * b.tangent[k];
+        return r;
+    }
+    friend constexpr Dual operator*(const Dual& a, T b) {
+        Dual r(a.value * b);
+        for (std::size_t k = 0; k < N; ++k) r.tangent[k] = a.tangent[k] * b;
+        return r;
+    }
+    friend constexpr Dual operator*(T a, const Dual& b) { return b * a; }
+    friend constexpr Dual operator/(const Dual& a, const Dual& b) {
+        // (a/b)' = (a' - (a/b)·b') / b
+        const T inv = T(1) / b.value;
+        Dual r(a.value * inv);
+        for (std::size_t k = 0; k < N; ++k) r.tangent[k] = (a.tangent[k] - r.value * b.tangent[k]) * inv;
+        return r;
+    }
+    friend constexpr Dual operator/(const Dual& a, T b) { return a * (T(1) / b); }
+    friend constexpr Dual operator/(T a, const Dual& b) { return Dual(a) / b; }
+
+    // ── Comparisons (value only) ──
+    friend constexpr bool operator<(const Dual& a, const Dual& b) { return a.value < b.value; }
+    friend constexpr bool operator>(const Dual& a, const Dual& b) { return a.value > b.value; }
+
+    // ── Elementary functions, found by ADL next to the std:: overloads ──
+    friend Dual sin(const Dual& a) {
+        using std::cos, std::sin;
+        return chain(a, sin(a.value), cos(a.value));
+    }
+    friend Dual cos(const Dual& a) {
+        using std::cos, std::sin;
+        return chain(a, cos(a.value), -sin(a.value));
+    }
+    friend Dual sqrt(const Dual& a) {
+        using std::sqrt;
+        const T root = sqrt(a.value);
+        return chain(a, root, T(0.5) / root);
+    }
+    friend Dual asin(const Dual& a) {
+        using std::asin, std::sqrt;
+        return chain(a, asin(a.value), T(1) / sqrt(T(1) - a.value * a.value));
+    }
+
+private:
+    // f(a) given f(a.value) and f'(a.value).
+    static constexpr Dual chain(const Dual& a, T f, T slope) {
+        Dual r(f);
+        for (std::size_t k = 0; k < N; ++k) r.tangent[k] = a.tangent[k] * slope;
+        return r;
+    }
+};
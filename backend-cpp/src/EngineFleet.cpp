@@ -0,0 +1,121 @@
+#include "EngineFleet.h"
+#include <chrono>
+#include "CrankKernel.h"
+
+EngineFleet::EngineFleet(std::size_t count)
+    : mRpm(count, 0.0f)
+    , mRpmTarget(count, PhysicsEngine::kDefaultRpm)
+    , mAngleRad(count, 0.0f)
+    , mOmegaRadS(count, 0.0f)
+    , mStressPa(count, 0.0f)
+    , mStressFactor(count, 0.0f)
+    , mPistonForceN(count, 0.0f)
+    , mRodForceN(count, 0.0f)
+    , mTangentialForceN(count, 0.0f)
+    , mTorqueNm(count, 0.0f)
+    , mSideThrustN(count, 0.0f)
+    , mStressMaxPa(PhysicsEngine::computeStressMaxPa())
+{}
+
+void EngineFleet::setRpmTarget(std::size_t idx, float target) {
+    mRpmTarget[idx] = std::clamp(target, PhysicsEngine::kRpmMin, PhysicsEngine::kRpmMax);
+}
+
+void EngineFleet::setAllRpmTargets(float target) {
+    target = std::clamp(target, PhysicsEngine::kRpmMin, PhysicsEngine::kRpmMax);
+    std::fill(mRpmTarget.begin(), mRpmTarget.end(), target);
+}
+
+void EngineFleet::enableRainflow(uint16_t rangeBins, uint16_t meanBins) {
+    std::array<RainflowCounter, kFatigueSignals> prototypes;
+    for (std::size_t s = 0; s < kFatigueSignals; ++s) {
+        RainflowSpec spec = PhysicsEngine::rainflowSpec(static_cast<FatigueSignal>(s), false);
+        spec.rangeBins = rangeBins;
+        spec.meanBins = meanBins;
+        prototypes[s] = RainflowCounter(spec);
+    }
+    mRainflow.clear();
+    mRainflow.reserve(size() * kFatigueSignals);
+    for (std::size_t i = 0; i < size(); ++i) {
+        mRainflow.insert(mRainflow.end(), prototypes.begin(), prototypes.end());
+    }
+}
+
+std::size_t EngineFleet::rainflowBytes() const {
+    std::size_t bytes = 0;
+    for (std::size_t s = 0; s < std::min(mRainflow.size(), kFatigueSignals); ++s) bytes += mRainflow[s].bytes();
+    return bytes;
+}
+
+void EngineFleet::step() {
+    using PE = PhysicsEngine;
+
+    const float alpha = PE::rpmFilterAlpha();
+    const float stressMax = mStressMaxPa;
+    const std::size_t n = size();
+
+    // Raw pointers keep the compiler from re-loading vector bases every
+    // iteration and make the no-aliasing layout obvious.
+    float* rpm = mRpm.data();
+    const float* rpmTarget = mRpmTarget.data();
+    float* angle = mAngleRad.data();
+    float* omega = mOmegaRadS.data();
+    float* stress = mStressPa.data();
+    float* stressFactor = mStressFactor.data();
+
+    for (std::size_t i = 0; i < n; ++i) {
+        float r = rpm[i] + (rpmTarget[i] - rpm[i]) * alpha;
+        r = std::clamp(r, PE::kRpmMin, PE::kRpmMax);
+        rpm[i] = r;
+
+        float w = r * PE::kTwoPi / 60.0f;
+        omega[i] = w;
+
+        float a = angle[i] + w * PE::kDt;
+        if (a >= PE::kTwoPi) a -= PE::kTwoPi;
+        if (a < 0.0f)        a += PE::kTwoPi;
+        angle[i] = a;
+
+        float force = PE::kMass * PE::kRadius * w * w;
+        stress[i] = force / PE::kArea;
+        stressFactor[i] = std::clamp(stress[i] / stressMax, 0.0f, 1.0f);
+    }
+
+    // Force chain for the whole fleet in one SIMD pass over the fresh state.
+    computeCrankForcesBatch(angle, omega, n, {
+        mPistonForceN.data(), mRodForceN.data(), mTangentialForceN.data(),
+        mTorqueNm.data(), mSideThrustN.data()});
+
+    if (!mRainflow.empty()) {
+        constexpr auto kStress = static_cast<std::size_t>(FatigueSignal::StressPa);
+        constexpr auto kRod = static_cast<std::size_t>(FatigueSignal::RodForceN);
+        constexpr auto kTorque = static_cast<std::size_t>(FatigueSignal::TorqueNm);
+        RainflowCounter* counter = mRainflow.data();
+        const float* rod = mRodForceN.data();
+        const float* torque = mTorqueNm.data();
+        for (std::size_t i = 0; i < n; ++i, counter += kFatigueSignals) {
+            counter[kStress].push(stress[i]);
+            counter[kRod].push(rod[i]);
+            counter[kTorque].push(torque[i]);
+        }
+    }
+
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    mTimestampMs = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(now).count());
+}
+
+protocol::StatePayload EngineFleet::snapshot(std::size_t idx) const {
+    protocol::StatePayload state{};
+    state.rpm = mRpm[idx];
+    state.angleRad = mAngleRad[idx];
+    state.stressPa = mStressPa[idx];
+    state.stressFactor = mStressFactor[idx];
+    state.pistonForceN = mPistonForceN[idx];
+    state.rodForceN = mRodForceN[idx];
+    state.tangentialForceN = mTangentialForceN[idx];
+    state.torqueNm = mTorqueNm[idx];
+    state.sideThrustN = mSideThrustN[idx];
+    state.timestampMs = mTimestampMs;
+    return state;
+}
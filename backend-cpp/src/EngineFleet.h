@@ -0,0 +1,70 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "PhysicsEngine.h"
+#include "Protocol.h"
+
+// ── Fleet of crank-slider twins in structure-of-arrays layout ──
+// Each field lives in its own contiguous array so one step() walks memory
+// linearly for every twin. Each twin is a cheaper model than PhysicsEngine:
+// a single cylinder with no gas pressure, the same first-order RPM filter
+// taken as one kDt step per step() rather than the engine's substeps, and
+// inertia-only forces from the vectorized kernel in CrankKernel.h, which
+// agree with PhysicsEngine::computeCrankForces(angle, ω) (no gas term)
+// within its documented error bound. While the RPM is changing, the fleet's
+// crank angle drifts from a substepped engine's.
+//
+// Not thread-safe: setRpmTarget() and step() must run on the same thread.
+class EngineFleet {
+public:
+    explicit EngineFleet(std::size_t count);
+
+    [[nodiscard]] std::size_t size() const { return mRpm.size(); }
+
+    void setRpmTarget(std::size_t idx, float target);
+    void setAllRpmTargets(float target);
+    [[nodiscard]] float rpmTarget(std::size_t idx) const { return mRpmTarget[idx]; }
+
+    void step();
+
+    [[nodiscard]] protocol::StatePayload snapshot(std::size_t idx) const;
+
+    // Per-twin rainflow counting of the fatigue signals, once per step. Off
+    // by default; the bins are coarser than the single engine's to keep the
+    // fleet's footprint at rainflowBytes() per twin.
+    void enableRainflow(uint16_t rangeBins = 16, uint16_t meanBins = 8);
+    [[nodiscard]] const RainflowCounter* rainflow(std::size_t idx, FatigueSignal signal) const {
+        if (mRainflow.empty()) return nullptr;
+        return &mRainflow[idx * kFatigueSignals + static_cast<std::size_t>(signal)];
+    }
+    [[nodiscard]] std::size_t rainflowBytes() const;
+
+    [[nodiscard]] const float* rpm() const              { return mRpm.data(); }
+    [[nodiscard]] const float* angleRad() const         { return mAngleRad.data(); }
+    [[nodiscard]] const float* stressPa() const         { return mStressPa.data(); }
+    [[nodiscard]] const float* pistonForceN() const     { return mPistonForceN.data(); }
+    [[nodiscard]] const float* rodForceN() const        { return mRodForceN.data(); }
+    [[nodiscard]] const float* tangentialForceN() const { return mTangentialForceN.data(); }
+    [[nodiscard]] const float* torqueNm() const         { return mTorqueNm.data(); }
+    [[nodiscard]] const float* sideThrustN() const      { return mSideThrustN.data(); }
+
+private:
+    std::vector<float> mRpm;
+    std::vector<float> mRpmTarget;
+    std::vector<float> mAngleRad;
+    std::vector<float> mOmegaRadS;
+    std::vector<float> mStressPa;
+    std::vector<float> mStressFactor;
+
+    std::vector<float> mPistonForceN;
+    std::vector<float> mRodForceN;
+    std::vector<float> mTangentialForceN;
+    std::vector<float> mTorqueNm;
+    std::vector<float> mSideThrustN;
+
+    std::vector<RainflowCounter> mRainflow;   // twin-major, kFatigueSignals each
+
+    float mStressMaxPa;
+    uint64_t mTimestampMs = 0;
+};
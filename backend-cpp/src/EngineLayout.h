@@ -0,0 +1,124 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+
+// ── Cylinder arrangement on a single crankshaft ──
+// Describes how many cylinders share the crank, which bank each sits on and
+// the order they fire in. From that, every cylinder gets
+//   phaseRad    — crank angle at which it reaches firing TDC (even firing,
+//                 720°/N apart in a four-stroke cycle),
+//   boreAxisRad — tilt of its bore axis from vertical (±bank/2 on a V), and
+//   throwOf     — the crank throw its rod runs on, counted from the pulley.
+// Inline engines have one throw per cylinder; on a V two cylinders, one
+// per bank, share each throw.
+// A cylinder's local crank angle is then θ - phaseRad, which is what the
+// crank-slider force chain consumes.
+class EngineLayout {
+public:
+    static constexpr std::size_t kMaxCylinders = 16;
+    static constexpr float kPi = 3.14159265358979323846f;
+    static constexpr float kCycleRad = 4.0f * kPi; // four-stroke: 720°
+
+    // Single cylinder on a vertical bore — the original model.
+    static EngineLayout singleCylinder() { return *make(std::array{1}, 0.0f); }
+
+    // Inline-4, firing order 1-3-4-2.
+    static EngineLayout inline4() { return *make(std::array{1, 3, 4, 2}, 0.0f); }
+
+    // Inline-6, firing order 1-5-3-6-2-4.
+    static EngineLayout inline6() { return *make(std::array{1, 5, 3, 6, 2, 4}, 0.0f); }
+
+    // 90° cross-plane V8, cylinders 1–4 on the right bank, 5–8 on the left,
+    // firing order 1-5-4-2-6-3-7-8. Cylinders k and k+4 share throw k.
+    static EngineLayout v8() {
+        return *make(std::array{1, 5, 4, 2, 6, 3, 7, 8}, 90.0f,
+                     std::array{0, 0, 0, 0, 1, 1, 1, 1},
+                     std::array{0, 1, 2, 3, 0, 1, 2, 3});
+    }
+
+    static std::optional<EngineLayout> fromName(std::string_view name) {
+        if (name == "single")  return singleCylinder();
+        if (name == "inline4") return inline4();
+        if (name == "inline6") return inline6();
+        if (name == "v8")      return v8();
+        return std::nullopt;
+    }
+
+    // firingOrder lists 1-based cylinder numbers and must be a permutation of
+    // 1..N. bankOf gives each cylinder's bank (0 or 1); omitted means inline.
+    // throwOf gives each cylinder's 0-based throw; omitted means one throw
+    // per cylinder in cylinder order. Every throw up to the highest must
+    // carry a cylinder, and at most one from each bank.
+    // Returns nullopt for anything that does not describe a real engine.
+    static std::optional<EngineLayout> make(std::span<const int> firingOrder,
+                                            float bankAngleDeg,
+                                            std::span<const int> bankOf = {},
+                                            std::span<const int> throwOf = {}) {
+        const std::size_t n = firingOrder.size();
+        if (n == 0 || n > kMaxCylinders) return std::nullopt;
+        if (!bankOf.empty() && bankOf.size() != n) return std::nullopt;
+        if (!throwOf.empty() && throwOf.size() != n) return std::nullopt;
+        if (bankAngleDeg < 0.0f || bankAngleDeg > 180.0f) return std::nullopt;
+
+        EngineLayout layout;
+        layout.mCylinders = n;
+        layout.mBankAngleRad = bankAngleDeg * kPi / 180.0f;
+
+        std::array<bool, kMaxCylinders> seen{};
+        for (std::size_t k = 0; k < n; ++k) {
+            int cyl = firingOrder[k];
+            if (cyl < 1 || static_cast<std::size_t>(cyl) > n || seen[cyl - 1]) return std::nullopt;
+            seen[cyl - 1] = true;
+            layout.mFiringOrder[k] = static_cast<uint8_t>(cyl);
+            layout.mPhaseRad[cyl - 1] = kCycleRad * static_cast<float>(k) / static_cast<float>(n);
+        }
+
+        for (std::size_t i = 0; i < n; ++i) {
+            int bank = bankOf.empty() ? 0 : bankOf[i];
+            if (bank != 0 && bank != 1) return std::nullopt;
+            float half = 0.5f * layout.mBankAngleRad;
+            layout.mBoreAxisRad[i] = bankOf.empty() ? 0.0f : (bank == 0 ? -half : half);
+        }
+
+        // Bit b of a throw's entry: a cylinder of bank b runs on it.
+        std::array<uint8_t, kMaxCylinders> banksOnThrow{};
+        layout.mThrows = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            const int t = throwOf.empty() ? static_cast<int>(i) : throwOf[i];
+            if (t < 0 || static_cast<std::size_t>(t) >= n) return std::nullopt;
+            const uint8_t bank = static_cast<uint8_t>(1u << (bankOf.empty() ? 0 : bankOf[i]));
+            if (banksOnThrow[t] & bank) return std::nullopt;
+            banksOnThrow[t] |= bank;
+            layout.mThrowOf[i] = static_cast<uint8_t>(t);
+            layout.mThrows = std::max(layout.mThrows, static_cast<std::size_t>(t) + 1);
+        }
+        for (std::size_t t = 0; t < layout.mThrows; ++t) {
+            if (!banksOnThrow[t]) return std::nullopt;
+        }
+        return layout;
+    }
+
+    [[nodiscard]] std::size_t cylinders() const { return mCylinders; }
+    [[nodiscard]] std::size_t throws() const { return mThrows; }
+    [[nodiscard]] float bankAngleRad() const { return mBankAngleRad; }
+    [[nodiscard]] const std::array<uint8_t, kMaxCylinders>& firingOrder() const { return mFiringOrder; }
+    [[nodiscard]] const std::array<float, kMaxCylinders>& phaseRad() const { return mPhaseRad; }
+    [[nodiscard]] const std::array<float, kMaxCylinders>& boreAxisRad() const { return mBoreAxisRad; }
+    [[nodiscard]] const std::array<uint8_t, kMaxCylinders>& throwOf() const { return mThrowOf; }
+
+private:
+    EngineLayout() = default;
+
+    std::size_t mCylinders = 1;
+    std::size_t mThrows = 1;
+    float mBankAngleRad = 0.0f;
+    std::array<uint8_t, kMaxCylinders> mFiringOrder{};
+    std::array<float, kMaxCylinders> mPhaseRad{};
+    std::array<float, kMaxCylinders> mBoreAxisRad{};
+    std::array<uint8_t, kMaxCylinders> mThrowOf{};
+};
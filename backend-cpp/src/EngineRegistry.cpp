@@ -0,0 +1,29 @@
+#include "EngineRegistry.h"
+
+namespace {
+
+template <typename Geometry>
+std::unique_ptr<TwinEngine> makeIfNamed(std::string_view variant, float physicsRateHz,
+                                        const EngineLayout& layout, std::string_view phaseFormat) {
+    if (variant != Geometry::kName) return nullptr;
+    if (phaseFormat == FloatPhase::kName) {
+        return std::make_unique<BasicPhysicsEngine<Geometry, FloatPhase>>(physicsRateHz, layout);
+    }
+    if (phaseFormat == DoublePhase::kName) {
+        return std::make_unique<BasicPhysicsEngine<Geometry, DoublePhase>>(physicsRateHz, layout);
+    }
+    if (phaseFormat == FixedPhase::kName) {
+        return std::make_unique<BasicPhysicsEngine<Geometry, FixedPhase>>(physicsRateHz, layout);
+    }
+    return nullptr;
+}
+
+} // namespace
+
+std::unique_ptr<TwinEngine> EngineRegistry::create(std::string_view variant, float physicsRateHz,
+                                                   const EngineLayout& layout, std::string_view phaseFormat) {
+    if (auto e = makeIfNamed<DefaultGeometry>(variant, physicsRateHz, layout, phaseFormat))   return e;
+    if (auto e = makeIfNamed<CompactGeometry>(variant, physicsRateHz, layout, phaseFormat))   return e;
+    if (auto e = makeIfNamed<HeavyDutyGeometry>(variant, physicsRateHz, layout, phaseFormat)) return e;
+    return nullptr;
+}
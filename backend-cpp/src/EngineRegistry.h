@@ -0,0 +1,24 @@
+#pragma once
+#include <array>
+#include <memory>
+#include <string_view>
+#include "PhysicsEngine.h"
+
+// ── Runtime selection of compiled engine variants ──
+// Maps a variant name (Geometry::kName) and a crank phase format
+// (Phase::kName, CrankPhase.h) to the BasicPhysicsEngine instantiation built
+// for them. The choice costs one virtual step() per tick; the substep loop
+// itself stays fully specialized.
+class EngineRegistry {
+public:
+    static constexpr std::array<std::string_view, 3> kVariants = {
+        DefaultGeometry::kName, CompactGeometry::kName, HeavyDutyGeometry::kName};
+    static constexpr std::array<std::string_view, 3> kPhaseFormats = {
+        FloatPhase::kName, DoublePhase::kName, FixedPhase::kName};
+
+    // Returns nullptr for an unknown variant or phase format name.
+    static std::unique_ptr<TwinEngine> create(std::string_view variant,
+                                              float physicsRateHz = TwinEngine::kDefaultPhysicsRateHz,
+                                              const EngineLayout& layout = EngineLayout::singleCylinder(),
+                                              std::string_view phaseFormat = FloatPhase::kName);
+};
@@ -0,0 +1,178 @@
+#include "GasPressure.h"
+#include <algorithm>
+#include <cmath>
+#include "PhysicsEngine.h"
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kDegToRad = kPi / 180.0;
+
+// Single-zone thermodynamics
+constexpr double kGammaCompression     = 1.32;
+constexpr double kGammaBurn            = 1.30;
+constexpr double kWiebeA               = 5.0;
+constexpr double kWiebeM               = 2.0;
+constexpr double kFuelLhvJPerKg        = 44.0e6;
+constexpr double kStoichAfr            = 14.7;
+constexpr double kCombustionEfficiency = 0.95;
+constexpr double kVolumetricEfficiency = 0.90;
+constexpr double kIntakeTempK          = 300.0;
+constexpr double kAirGasConstant       = 287.0;
+constexpr double kExhaustBackPressure  = 1.1;   // × atmosphere
+constexpr double kMinManifoldPressure  = 0.3;   // × atmosphere at zero load
+
+// Fine integration step inside each 0.5° table cell.
+constexpr double kOdeStepDeg = 0.05;
+
+struct CylinderVolume {
+    explicit CylinderVolume(const GasPressureTable::Chamber& c)
+        : area(c.boreArea)
+        , crank(c.crankThrow)
+        , lambda(c.crankThrow / c.conRodLength)
+        , rod(c.conRodLength)
+        , clearance(area * 2.0 * crank / (c.compressionRatio - 1.0))
+    {}
+
+    double area;
+    double crank;
+    double lambda;
+    double rod;
+    double clearance;
+
+    // V(θ) = V_c + A·(R(1 - cos θ) + L(1 - √(1 - λ²sin²θ)))
+    double at(double thetaRad) const {
+        double s = std::sin(thetaRad);
+        double x = crank * (1.0 - std::cos(thetaRad))
+                 + rod * (1.0 - std::sqrt(1.0 - lambda * lambda * s * s));
+        return clearance + area * x;
+    }
+
+    // dV/dθ = A·R·(sin θ + λ·sin θ·cos θ / √(1 - λ²sin²θ))
+    double slope(double thetaRad) const {
+        double s = std::sin(thetaRad);
+        double c = std::cos(thetaRad);
+        return area * crank * (s + lambda * s * c / std::sqrt(1.0 - lambda * lambda * s * s));
+    }
+};
+
+// Bracketing nodes and fraction of v ∈ [0, 1] on an axis of `points` nodes.
+void axisCell(float v, std::size_t points, std::size_t& i0, std::size_t& i1, float& t) {
+    float pos = std::clamp(v, 0.0f, 1.0f) * static_cast<float>(points - 1);
+    i0 = std::min(static_cast<std::size_t>(pos), points - 2);
+    i1 = i0 + 1;
+    t = pos - static_cast<float>(i0);
+}
+
+} // namespace
+
+GasPressureTable::GasPressureTable(const Chamber& chamber)
+    : mChamber(chamber)
+    , mPressurePa(kLoadPoints * kRpmPoints * kAnglePoints)
+{
+    for (std::size_t li = 0; li < kLoadPoints; ++li) {
+        float load = static_cast<float>(li) / static_cast<float>(kLoadPoints - 1);
+        for (std::size_t ri = 0; ri < kRpmPoints; ++ri) {
+            float rpm = TwinEngine::kRpmMax * static_cast<float>(ri)
+                        / static_cast<float>(kRpmPoints - 1);
+            buildCurve(load, rpm, mPressurePa.data() + (li * kRpmPoints + ri) * kAnglePoints);
+        }
+    }
+    mPeakPa = *std::max_element(mPressurePa.begin(), mPressurePa.end());
+}
+
+void GasPressureTable::buildCurve(float load, float rpm, float* out) const {
+    const CylinderVolume vol(mChamber);
+    const double atm = kAtmospherePa;
+    const double pIntake = (kMinManifoldPressure + (1.0 - kMinManifoldPressure) * load) * atm;
+    const double pExhaust = kExhaustBackPressure * atm;
+
+    // Trapped charge → fuel energy released over the burn.
+    const double displacement = vol.area * 2.0 * vol.crank;
+    const double airMass = kVolumetricEfficiency * pIntake * displacement
+                           / (kAirGasConstant * kIntakeTempK);
+    const double heatJ = kCombustionEfficiency * airMass / kStoichAfr * kFuelLhvJPerKg;
+
+    // Faster engines need more spark advance and burn over more crank degrees.
+    const double speed = static_cast<double>(rpm) / TwinEngine::kRpmMax;
+    const double burnStartDeg = 720.0 - (8.0 + 22.0 * speed);
+    const double burnDurationDeg = 45.0 + 20.0 * speed;
+
+    auto heatRate = [&](double deg) {  // dQ/dθ in J/rad
+        if (deg < burnStartDeg) return 0.0;
+        double u = (deg - burnStartDeg) / burnDurationDeg;
+        double um = std::pow(u, kWiebeM);
+        double dxb = kWiebeA * (kWiebeM + 1.0) / (burnDurationDeg * kDegToRad)
+                     * um * std::exp(-kWiebeA * um * u);
+        return heatJ * dxb;
+    };
+    auto dpdTheta = [&](double deg, double p) {
+        double th = deg * kDegToRad;
+        return ((kGammaBurn - 1.0) * heatRate(deg) - kGammaBurn * p * vol.slope(th)) / vol.at(th);
+    };
+
+    constexpr double kCellDeg = 720.0 / kAnglePoints;
+    auto index = [&](double deg) {
+        auto i = static_cast<std::size_t>(std::lround(std::fmod(deg, 720.0) / kCellDeg));
+        return i % kAnglePoints;
+    };
+
+    // Gas exchange strokes: exhaust at back-pressure, intake at manifold pressure.
+    for (double deg = 180.0; deg < 540.0 - 1e-9; deg += kCellDeg) {
+        out[index(deg)] = static_cast<float>(deg < 360.0 ? pExhaust : pIntake);
+    }
+
+    // Closed cycle from intake BDC (540°) through firing TDC (720°) to
+    // exhaust BDC (900° ≡ 180°): polytropic until the burn starts, then RK4.
+    const double vBdc = vol.at(540.0 * kDegToRad);
+    double odeDeg = burnStartDeg;
+    double odeP = pIntake * std::pow(vBdc / vol.at(burnStartDeg * kDegToRad), kGammaCompression);
+
+    for (double deg = 540.0; deg < 900.0 - 1e-9; deg += kCellDeg) {
+        double p;
+        if (deg < burnStartDeg) {
+            p = pIntake * std::pow(vBdc / vol.at(deg * kDegToRad), kGammaCompression);
+        } else {
+            while (odeDeg < deg - 1e-9) {
+                double h = std::min(kOdeStepDeg, deg - odeDeg);
+                double hr = h * kDegToRad;
+                double k1 = dpdTheta(odeDeg, odeP);
+                double k2 = dpdTheta(odeDeg + 0.5 * h, odeP + 0.5 * hr * k1);
+                double k3 = dpdTheta(odeDeg + 0.5 * h, odeP + 0.5 * hr * k2);
+                double k4 = dpdTheta(odeDeg + h, odeP + hr * k3);
+                odeP += hr / 6.0 * (k1 + 2.0 * k2 + 2.0 * k3 + k4);
+                odeDeg += h;
+            }
+            p = odeP;
+        }
+        out[index(deg)] = static_cast<float>(p);
+    }
+}
+
+GasPressureTable::Slice GasPressureTable::slice(float load, float rpm) const {
+    std::size_t l0, l1, r0, r1;
+    float tl, tr;
+    axisCell(load, kLoadPoints, l0, l1, tl);
+    axisCell(rpm / TwinEngine::kRpmMax, kRpmPoints, r0, r1, tr);
+
+    Slice s;
+    s.rows = { curve(l0, r0), curve(l0, r1), curve(l1, r0), curve(l1, r1) };
+    s.weights = { (1.0f - tl) * (1.0f - tr), (1.0f - tl) * tr, tl * (1.0f - tr), tl * tr };
+    return s;
+}
+
+GasPressureTable::Slice GasPressureTable::rpmSlope(float load, float rpm) const {
+    std::size_t l0, l1, r0, r1;
+    float tl, tr;
+    axisCell(load, kLoadPoints, l0, l1, tl);
+    axisCell(rpm / TwinEngine::kRpmMax, kRpmPoints, r0, r1, tr);
+
+    // d(tr)/d(rpm) inside the range; the clamp flattens it outside.
+    const float dtr = (rpm >= 0.0f && rpm < TwinEngine::kRpmMax)
+                          ? static_cast<float>(kRpmPoints - 1) / TwinEngine::kRpmMax
+                          : 0.0f;
+    Slice s;
+    s.rows = { curve(l0, r0), curve(l0, r1), curve(l1, r0), curve(l1, r1) };
+    s.weights = { -(1.0f - tl) * dtr, (1.0f - tl) * dtr, -tl * dtr, tl * dtr };
+    return s;
+}
@@ -0,0 +1,98 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <vector>
+
+// ── Precomputed in-cylinder gas pressure ──
+// Pressure vs. four-stroke cycle angle (0 = firing TDC, 4π = next firing
+// TDC), tabulated over a load × RPM grid at construction. Each curve is
+// integrated once, offline, from the single-zone first-law ODE
+//   dp/dθ = ((γ-1)·dQ/dθ - γ·p·dV/dθ) / V
+// with a Wiebe heat-release profile
+//   x_b(θ) = 1 - exp(-a·((θ - θ_s)/Δθ)^(m+1)),  a = 5, m = 2
+// and polytropic compression from IVC (intake BDC). Exhaust and intake
+// strokes sit at constant back-pressure / manifold pressure. At runtime a
+// lookup is a bilinear blend of four curves plus a linear angle interpolation.
+//
+// Load maps to manifold pressure (0.3–1.0 atm) and therefore trapped air and
+// fuel; RPM sets spark advance and burn duration (both grow with speed).
+class GasPressureTable {
+public:
+    static constexpr std::size_t kLoadPoints  = 11;    // 0.0 … 1.0
+    static constexpr std::size_t kRpmPoints   = 9;     // 0 … 8000
+    static constexpr std::size_t kAnglePoints = 1440;  // 0.5° over 720°
+
+    static constexpr float kAtmospherePa     = 101325.0f;
+    static constexpr float kCrankcasePa      = kAtmospherePa;
+
+    // Curves for the current (load, RPM), resolved once per tick so each
+    // per-substep lookup only interpolates in angle.
+    struct Slice {
+        std::array<const float*, 4> rows{};
+        std::array<float, 4> weights{};
+    };
+
+    // Chamber dimensions the curves are integrated for.
+    struct Chamber {
+        float boreArea         = 0.0f;   // m²
+        float crankThrow       = 0.0f;   // m
+        float conRodLength     = 0.0f;   // m
+        float compressionRatio = 0.0f;
+
+        template <typename Geometry>
+        static constexpr Chamber of() {
+            return { 0.25f * 3.14159265358979323846f * Geometry::kBore * Geometry::kBore,
+                     Geometry::kCrankThrow, Geometry::kConRodLength,
+                     Geometry::kCompressionRatio };
+        }
+    };
+
+    explicit GasPressureTable(const Chamber& chamber);
+
+    // Shared table for a geometry policy (Geometry.h); built on first use.
+    template <typename Geometry>
+    static const GasPressureTable& instance() {
+        static const GasPressureTable table(Chamber::of<Geometry>());
+        return table;
+    }
+
+    [[nodiscard]] Slice slice(float load, float rpm) const;
+
+    // ∂/∂rpm of slice(load, rpm): pressurePa() of the result is the pressure
+    // slope in Pa per rpm. The blend is piecewise linear in RPM, so on a grid
+    // RPM this is the slope above it, and outside 0…kRpmMax it is zero.
+    [[nodiscard]] Slice rpmSlope(float load, float rpm) const;
+
+    // Absolute cylinder pressure at a cycle angle in [0, 4π).
+    [[nodiscard]] static float pressurePa(const Slice& s, float cycleAngleRad) {
+        float pos = cycleAngleRad * kAnglesPerRad;
+        auto i0 = static_cast<std::size_t>(pos);
+        if (i0 >= kAnglePoints) i0 = kAnglePoints - 1;
+        std::size_t i1 = (i0 + 1 == kAnglePoints) ? 0 : i0 + 1;
+        float t = pos - static_cast<float>(i0);
+
+        float p = 0.0f;
+        for (std::size_t k = 0; k < 4; ++k) {
+            const float* row = s.rows[k];
+            p += s.weights[k] * (row[i0] + t * (row[i1] - row[i0]));
+        }
+        return p;
+    }
+
+    // Highest pressure anywhere in the table (full load, best spark timing).
+    [[nodiscard]] float peakPa() const { return mPeakPa; }
+
+    [[nodiscard]] const float* curve(std::size_t loadIdx, std::size_t rpmIdx) const {
+        return mPressurePa.data() + (loadIdx * kRpmPoints + rpmIdx) * kAnglePoints;
+    }
+
+private:
+    static constexpr float kAnglesPerRad =
+        static_cast<float>(kAnglePoints) / (4.0f * 3.14159265358979323846f);
+
+    void buildCurve(float load, float rpm, float* out) const;
+
+    Chamber mChamber;
+    std::vector<float> mPressurePa;
+    float mPeakPa = 0.0f;
+};
@@ -0,0 +1,99 @@
+#pragma once
+
+// ── Engine geometry policies ──
+// Each policy is a bag of constexpr dimensions that BasicPhysicsEngine and the
+// force kernels are instantiated over, so every variant gets a fully
+// constant-folded hot loop. To add a variant: define a policy here, add it to
+// the explicit instantiations at the bottom of PhysicsEngine.cpp and
+// CrankKernel.cpp, and register it in EngineRegistry.cpp.
+
+// Passenger-car gasoline engine the twin was built around: square 80 × 80 mm.
+struct DefaultGeometry {
+    static constexpr const char* kName = "default";
+
+    // Rotating assembly (centrifugal stress model)
+    static constexpr float kMass        = 2.5f;
+    static constexpr float kRadius      = 0.08f;
+    static constexpr float kArea        = 0.0004f;
+
+    // Crank-slider mechanism
+    static constexpr float kCrankThrow    = 0.04f;    // 40 mm throw → 80 mm stroke
+    static constexpr float kConRodLength  = 0.128f;   // 128 mm connecting rod
+    static constexpr float kPistonMass    = 0.4f;     // 400 g piston + wrist pin
+
+    // Combustion chamber
+    static constexpr float kBore             = 0.08f;
+    static constexpr float kCompressionRatio = 10.5f;
+
+    // Crankshaft torsion (TorsionalModel.h): lumped pulley, one mass per
+    // throw (incl. rotating con-rod share) and flywheel, joined by journal
+    // sections of equal stiffness.
+    static constexpr float kPulleyInertia    = 0.008f;   // kg·m²
+    static constexpr float kThrowInertia     = 0.003f;   // kg·m²
+    static constexpr float kFlywheelInertia  = 0.15f;    // kg·m²
+    static constexpr float kSectionStiffness = 1.0e6f;   // N·m/rad
+    static constexpr float kSectionDamping   = 2.0f;     // N·m·s/rad
+    static constexpr float kThrowDamping     = 0.5f;     // N·m·s/rad, bearings to ground
+    static constexpr float kJournalDiameter  = 0.05f;    // m
+
+    // Crank web (WebStress.h): stadium plate spanning main journal and pin.
+    static constexpr float kPinDiameter      = 0.045f;   // m
+    static constexpr float kWebHalfWidth     = 0.04f;    // m, also end radius
+    static constexpr float kWebThickness     = 0.018f;   // m
+};
+
+// Small-displacement, short-stroke three/four-cylinder class: 72 × 72 mm.
+struct CompactGeometry {
+    static constexpr const char* kName = "compact";
+
+    static constexpr float kMass        = 1.9f;
+    static constexpr float kRadius      = 0.07f;
+    static constexpr float kArea        = 0.00035f;
+
+    static constexpr float kCrankThrow    = 0.036f;   // 72 mm stroke
+    static constexpr float kConRodLength  = 0.121f;
+    static constexpr float kPistonMass    = 0.29f;
+
+    static constexpr float kBore             = 0.072f;
+    static constexpr float kCompressionRatio = 11.5f;
+
+    static constexpr float kPulleyInertia    = 0.005f;
+    static constexpr float kThrowInertia     = 0.0018f;
+    static constexpr float kFlywheelInertia  = 0.09f;
+    static constexpr float kSectionStiffness = 8.0e5f;
+    static constexpr float kSectionDamping   = 1.5f;
+    static constexpr float kThrowDamping     = 0.4f;
+    static constexpr float kJournalDiameter  = 0.045f;
+
+    static constexpr float kPinDiameter      = 0.04f;
+    static constexpr float kWebHalfWidth     = 0.036f;
+    static constexpr float kWebThickness     = 0.016f;
+};
+
+// Heavy-duty diesel: 120 mm bore × 140 mm stroke, long rod, heavy piston.
+struct HeavyDutyGeometry {
+    static constexpr const char* kName = "heavy_duty";
+
+    static constexpr float kMass        = 9.0f;
+    static constexpr float kRadius      = 0.13f;
+    static constexpr float kArea        = 0.0012f;
+
+    static constexpr float kCrankThrow    = 0.07f;    // 140 mm stroke
+    static constexpr float kConRodLength  = 0.23f;
+    static constexpr float kPistonMass    = 2.3f;
+
+    static constexpr float kBore             = 0.12f;
+    static constexpr float kCompressionRatio = 17.0f;
+
+    static constexpr float kPulleyInertia    = 0.05f;    // incl. viscous damper hub
+    static constexpr float kThrowInertia     = 0.03f;
+    static constexpr float kFlywheelInertia  = 1.5f;
+    static constexpr float kSectionStiffness = 4.0e6f;
+    static constexpr float kSectionDamping   = 15.0f;
+    static constexpr float kThrowDamping     = 3.0f;
+    static constexpr float kJournalDiameter  = 0.09f;
+
+    static constexpr float kPinDiameter      = 0.085f;
+    static constexpr float kWebHalfWidth     = 0.075f;
+    static constexpr float kWebThickness     = 0.032f;
+};
@@ -0,0 +1,225 @@
+#include "MonteCarlo.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <thread>
+#include <vector>
+#include "GasPressure.h"
+#include "Philox.h"
+
+namespace {
+
+// Fixed-range histogram with exact integer state, so merging per-thread
+// copies gives the same bits in any order. Values outside [lo, hi) land in
+// under/overflow cells bounded by the exact min/max.
+class PeakHistogram {
+public:
+    static constexpr std::size_t kBins = 4096;
+    static constexpr double kSumScale = 1024.0;   // fixed-point mean, 1/1024 unit
+
+    PeakHistogram(float lo, float hi)
+        : mLo(lo), mHi(hi), mBinsPerUnit(static_cast<double>(kBins) / (hi - lo)), mCounts(kBins + 2, 0)
+    {}
+
+    void add(float v) {
+        double pos = (static_cast<double>(v) - mLo) * mBinsPerUnit;
+        std::size_t cell = pos < 0.0 ? 0
+                         : pos >= static_cast<double>(kBins) ? kBins + 1
+                         : static_cast<std::size_t>(pos) + 1;
+        ++mCounts[cell];
+        ++mTotal;
+        mSumFixed += std::llround(static_cast<double>(v) * kSumScale);
+        mMin = std::min(mMin, v);
+        mMax = std::max(mMax, v);
+    }
+
+    void merge(const PeakHistogram& o) {
+        for (std::size_t i = 0; i < mCounts.size(); ++i) mCounts[i] += o.mCounts[i];
+        mTotal += o.mTotal;
+        mSumFixed += o.mSumFixed;
+        mMin = std::min(mMin, o.mMin);
+        mMax = std::max(mMax, o.mMax);
+    }
+
+    [[nodiscard]] PercentileSummary summary() const {
+        PercentileSummary s;
+        if (mTotal == 0) return s;
+        s.min = mMin;
+        s.max = mMax;
+        s.mean = static_cast<float>(static_cast<double>(mSumFixed) / kSumScale
+                                    / static_cast<double>(mTotal));
+        for (std::size_t q = 0; q < PercentileSummary::kPercentiles.size(); ++q) {
+            s.percentiles[q] = quantile(PercentileSummary::kPercentiles[q] / 100.0);
+        }
+        return s;
+    }
+
+private:
+    // Linear interpolation inside the cell holding the target rank.
+    [[nodiscard]] float quantile(double p) const {
+        double rank = p * static_cast<double>(mTotal);
+        uint64_t seen = 0;
+        for (std::size_t cell = 0; cell < mCounts.size(); ++cell) {
+            uint64_t c = mCounts[cell];
+            if (c == 0 || static_cast<double>(seen + c) < rank) {
+                seen += c;
+                continue;
+            }
+            double lo, hi;
+            if (cell == 0) {
+                lo = mMin; hi = mLo;
+            } else if (cell == kBins + 1) {
+                lo = mHi; hi = mMax;
+            } else {
+                lo = mLo + static_cast<double>(cell - 1) / mBinsPerUnit;
+                hi = lo + 1.0 / mBinsPerUnit;
+            }
+            double t = (rank - static_cast<double>(seen)) / static_cast<double>(c);
+            double v = lo + std::clamp(t, 0.0, 1.0) * (hi - lo);
+            return static_cast<float>(std::clamp(v, static_cast<double>(mMin),
+                                                 static_cast<double>(mMax)));
+        }
+        return mMax;
+    }
+
+    double mLo;
+    double mHi;
+    double mBinsPerUnit;
+    std::vector<uint64_t> mCounts;
+    uint64_t mTotal = 0;
+    int64_t mSumFixed = 0;
+    float mMin = std::numeric_limits<float>::max();
+    float mMax = std::numeric_limits<float>::lowest();
+};
+
+struct PeakAccumulator {
+    PeakHistogram rodCompression;
+    PeakHistogram rodTension;
+    PeakHistogram torquePeak;
+
+    void add(const CyclePeaks& p) {
+        rodCompression.add(p.rodForceMaxN);
+        rodTension.add(-p.rodForceMinN);
+        torquePeak.add(p.torquePeakNm);
+    }
+
+    void merge(const PeakAccumulator& o) {
+        rodCompression.merge(o.rodCompression);
+        rodTension.merge(o.rodTension);
+        torquePeak.merge(o.torquePeak);
+    }
+};
+
+// Deterministic geometry draw for sample i: one Philox block for normals
+// and a second, independent one for uniforms.
+CrankGeometry drawGeometry(const MonteCarloConfig& cfg, const Philox4x32& rng, uint64_t i) {
+    const Philox4x32::Block nb = rng(i, 0);
+    const Philox4x32::Block ub = rng(i, 1);
+    float n[4];
+    Philox4x32::toNormal(nb[0], nb[1], n[0], n[1]);
+    Philox4x32::toNormal(nb[2], nb[3], n[2], n[3]);
+    return {cfg.crankThrowM.sample(Philox4x32::toUnit(ub[0]), n[0]),
+            cfg.conRodLengthM.sample(Philox4x32::toUnit(ub[1]), n[1]),
+            cfg.pistonMassKg.sample(Philox4x32::toUnit(ub[2]), n[2])};
+}
+
+// Histogram ranges from the corners of the sampling box. The tracked peaks
+// are monotonic in mass and throw and nearly so in rod length, so the corners
+// bracket practically every draw; anything outside still lands in the exact
+// under/overflow cells.
+PeakAccumulator makeAccumulator(const MonteCarloConfig& cfg) {
+    CycleEvaluator cycle(cfg.samplesPerCycle);
+    cycle.setOperatingPoint(cfg.rpm, cfg.load);
+
+    float lo[3] = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+                   std::numeric_limits<float>::max()};
+    float hi[3] = {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(),
+                   std::numeric_limits<float>::lowest()};
+    for (int corner = 0; corner < 8; ++corner) {
+        const CrankGeometry g{
+            (corner & 1) ? cfg.crankThrowM.high()   : cfg.crankThrowM.low(),
+            (corner & 2) ? cfg.conRodLengthM.high() : cfg.conRodLengthM.low(),
+            (corner & 4) ? cfg.pistonMassKg.high()  : cfg.pistonMassKg.low()};
+        const CyclePeaks p = cycle.evaluate(g);
+        const float v[3] = {p.rodForceMaxN, -p.rodForceMinN, p.torquePeakNm};
+        for (int m = 0; m < 3; ++m) {
+            lo[m] = std::min(lo[m], v[m]);
+            hi[m] = std::max(hi[m], v[m]);
+        }
+    }
+    auto range = [&](int m) {
+        float margin = std::max(0.05f * (hi[m] - lo[m]), 1e-3f * std::max(1.0f, std::abs(hi[m])));
+        return PeakHistogram(lo[m] - margin, hi[m] + margin);
+    };
+    return {range(0), range(1), range(2)};
+}
+
+bool distributionValid(const ToleranceDistribution& d) {
+    return std::isfinite(d.a) && std::isfinite(d.b) && d.low() <= d.high();
+}
+
+} // namespace
+
+std::optional<MonteCarloReport> MonteCarlo::run(const MonteCarloConfig& config, unsigned threads,
+                                                const ProgressFn& onProgress) {
+    if (!distributionValid(config.crankThrowM) || !distributionValid(config.conRodLengthM)
+        || !distributionValid(config.pistonMassKg)) {
+        return std::nullopt;
+    }
+    if (config.crankThrowM.low() <= 0.0f || config.pistonMassKg.low() <= 0.0f
+        || config.conRodLengthM.low() <= config.crankThrowM.high()
+        || config.samples == 0 || config.samplesPerCycle == 0) {
+        return std::nullopt;
+    }
+
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    const uint64_t reportEvery = config.reportEvery > 0
+        ? config.reportEvery : std::max<uint64_t>(1, config.samples / 10);
+    constexpr uint64_t kChunk = 1024;   // samples per work grab
+
+    const Philox4x32 rng(config.seed);
+    if (config.load > 0.0f) (void)GasPressureTable::instance<DefaultGeometry>();
+    const PeakAccumulator empty = makeAccumulator(config);
+    PeakAccumulator total = empty;
+
+    MonteCarloReport report;
+    for (uint64_t roundBegin = 0; roundBegin < config.samples; roundBegin += reportEvery) {
+        const uint64_t roundEnd = std::min(config.samples, roundBegin + reportEvery);
+        const uint64_t chunks = (roundEnd - roundBegin + kChunk - 1) / kChunk;
+        const unsigned workers = static_cast<unsigned>(std::min<uint64_t>(threads, chunks));
+
+        // Which thread takes which chunk varies run to run; the merged
+        // integer state does not.
+        std::atomic<uint64_t> nextChunk{0};
+        std::vector<PeakAccumulator> partial(workers, empty);
+        {
+            std::vector<std::jthread> pool;
+            pool.reserve(workers);
+            for (unsigned w = 0; w < workers; ++w) {
+                pool.emplace_back([&, w] {
+                    CycleEvaluator cycle(config.samplesPerCycle);
+                    cycle.setOperatingPoint(config.rpm, config.load);
+                    PeakAccumulator& acc = partial[w];
+                    for (;;) {
+                        uint64_t c = nextChunk.fetch_add(1, std::memory_order_relaxed);
+                        if (c >= chunks) break;
+                        uint64_t begin = roundBegin + c * kChunk;
+                        uint64_t end = std::min(roundEnd, begin + kChunk);
+                        for (uint64_t i = begin; i < end; ++i) {
+                            acc.add(cycle.evaluate(drawGeometry(config, rng, i)));
+                        }
+                    }
+                });
+            }
+        }
+        for (const PeakAccumulator& p : partial) total.merge(p);
+
+        report.samples = roundEnd;
+        report.rodCompressionN = total.rodCompression.summary();
+        report.rodTensionN = total.rodTension.summary();
+        report.torquePeakNm = total.torquePeak.summary();
+        if (onProgress) onProgress(report);
+    }
+    return report;
+}
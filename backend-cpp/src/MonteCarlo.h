@@ -0,0 +1,91 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include "CycleEvaluator.h"
+#include "PhysicsEngine.h"
+
+// ── Monte Carlo tolerance analysis of the crank-slider force chain ──
+// Draws crank throw, rod length and piston mass from their tolerance
+// distributions, evaluates each drawn engine over a full cycle at a fixed
+// operating point (CycleEvaluator) and accumulates the distribution of peak
+// rod compression, peak rod tension and peak torque.
+//
+// Reproducibility: sample i draws from Philox counter i under the run's
+// seed, and every accumulator is order-free (integer histogram counts,
+// fixed-point sums, min/max). The samples run in rounds of reportEvery
+// samples. A round's counts are merged before its progress report is
+// emitted. Every report, and the final result, is therefore bit-identical
+// for a given seed at any thread count.
+struct ToleranceDistribution {
+    enum class Kind { Normal, Uniform };
+
+    Kind kind = Kind::Normal;
+    float a = 0.0f;   // mean (normal) or lower bound (uniform)
+    float b = 0.0f;   // standard deviation (normal) or upper bound (uniform)
+
+    static constexpr float kNormalClampSigma = 6.0f;
+
+    static constexpr ToleranceDistribution normal(float mean, float stddev) {
+        return {Kind::Normal, mean, stddev};
+    }
+    static constexpr ToleranceDistribution uniform(float lo, float hi) {
+        return {Kind::Uniform, lo, hi};
+    }
+
+    // Support of the draw; normals are truncated at ±6σ.
+    [[nodiscard]] float low() const  { return kind == Kind::Normal ? a - kNormalClampSigma * b : a; }
+    [[nodiscard]] float high() const { return kind == Kind::Normal ? a + kNormalClampSigma * b : b; }
+
+    // Maps one uniform in (0, 1) and one standard normal to a draw.
+    [[nodiscard]] float sample(float unit, float standardNormal) const {
+        if (kind == Kind::Uniform) return a + (b - a) * unit;
+        float z = std::clamp(standardNormal, -kNormalClampSigma, kNormalClampSigma);
+        return a + b * z;
+    }
+};
+
+struct MonteCarloConfig {
+    ToleranceDistribution crankThrowM   = ToleranceDistribution::normal(DefaultGeometry::kCrankThrow, 25e-6f);
+    ToleranceDistribution conRodLengthM = ToleranceDistribution::normal(DefaultGeometry::kConRodLength, 50e-6f);
+    ToleranceDistribution pistonMassKg  = ToleranceDistribution::normal(DefaultGeometry::kPistonMass, 0.002f);
+
+    float rpm = TwinEngine::kRpmMax;
+    float load = 0.0f;
+    std::size_t samplesPerCycle = 720;
+
+    uint64_t samples = 1'000'000;
+    uint64_t seed = 1;
+    uint64_t reportEvery = 0;   // samples per progress report; 0 = samples / 10
+};
+
+struct PercentileSummary {
+    static constexpr std::array<float, 6> kPercentiles = {1.0f, 5.0f, 50.0f, 95.0f, 99.0f, 99.9f};
+
+    float min = 0.0f;
+    float max = 0.0f;
+    float mean = 0.0f;
+    std::array<float, kPercentiles.size()> percentiles{};
+};
+
+struct MonteCarloReport {
+    uint64_t samples = 0;
+    PercentileSummary rodCompressionN;   // per-sample peak compressive rod force
+    PercentileSummary rodTensionN;       // per-sample peak tensile rod force (positive)
+    PercentileSummary torquePeakNm;      // per-sample peak |torque|
+};
+
+class MonteCarlo {
+public:
+    using ProgressFn = std::function<void(const MonteCarloReport&)>;
+
+    // threads = 0 uses every hardware thread. onProgress runs on the calling
+    // thread after each round, the last call being the final report. Returns
+    // nullopt if any distribution can produce a non-physical engine
+    // (rod ≤ throw, throw or mass ≤ 0) or the run is empty.
+    static std::optional<MonteCarloReport> run(const MonteCarloConfig& config, unsigned threads = 0,
+                                               const ProgressFn& onProgress = {});
+};
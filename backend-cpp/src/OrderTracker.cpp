@@ -0,0 +1,96 @@
+#include "OrderTracker.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr double kCycleRad = 4.0 * 3.14159265358979323846;
+}
+
+OrderTracker::OrderTracker(std::span<const float> orders, std::size_t pointsPerCycle)
+    : mPoints(std::max<std::size_t>(pointsPerCycle, 8))
+    , mPointsPerRad(static_cast<double>(mPoints) / kCycleRad)
+{
+    for (float order : orders) {
+        if (!(order >= 0.0f) || mOrderCount == kMaxOrders) continue;
+        const auto bin = static_cast<uint32_t>(std::lround(2.0f * order));
+        if (2 * static_cast<std::size_t>(bin) >= mPoints) continue;
+        mBin[mOrderCount++] = bin;
+    }
+
+    mCos.resize(mPoints);
+    mSin.resize(mPoints);
+    for (std::size_t j = 0; j < mPoints; ++j) {
+        const double angle = 2.0 * 3.14159265358979323846 * static_cast<double>(j) / static_cast<double>(mPoints);
+        mCos[j] = std::cos(angle);
+        mSin[j] = std::sin(angle);
+    }
+    mRing.assign(mPoints, 0.0f);
+}
+
+void OrderTracker::reset() {
+    std::fill(mRing.begin(), mRing.end(), 0.0f);
+    mRe.fill(0.0);
+    mIm.fill(0.0);
+    mStarted = false;
+    mFilled = 0;
+}
+
+void OrderTracker::push(float cycleAngleRad, float value) {
+    const auto n = static_cast<double>(mPoints);
+    double pos = static_cast<double>(cycleAngleRad) * mPointsPerRad;
+    if (pos >= n) pos -= n;
+    if (pos < 0.0) pos += n;
+    double ahead = pos - mLastPos;
+    if (ahead < 0.0) ahead += n;
+
+    if (!mStarted || ahead > 0.25 * n) {
+        mStarted = true;
+        seek(static_cast<std::size_t>(std::ceil(pos)) % mPoints);
+        mLastPos = pos;
+        mLastValue = value;
+        return;
+    }
+
+    // Every grid angle passed since the previous sample, interpolated.
+    double gap = static_cast<double>(mNext) - mLastPos;
+    if (gap < 0.0) gap += n;
+    const float slope = ahead > 0.0 ? static_cast<float>((value - mLastValue) / ahead) : 0.0f;
+    for (; gap <= ahead; gap += 1.0) {
+        add(ahead > 0.0 ? mLastValue + static_cast<float>(gap) * slope : value);
+    }
+    mLastPos = pos;
+    mLastValue = value;
+}
+
+void OrderTracker::seek(std::size_t index) {
+    mNext = index;
+    for (std::size_t k = 0; k < mOrderCount; ++k) {
+        mTwiddle[k] = static_cast<uint32_t>((static_cast<std::size_t>(mBin[k]) * index) % mPoints);
+    }
+}
+
+void OrderTracker::add(float value) {
+    const double delta = static_cast<double>(value) - static_cast<double>(mRing[mNext]);
+    mRing[mNext] = value;
+    if (mFilled < mPoints) ++mFilled;
+
+    // Twiddle index m·j mod N steps by m as j steps by one.
+    const auto points = static_cast<uint32_t>(mPoints);
+    for (std::size_t k = 0; k < mOrderCount; ++k) {
+        const uint32_t twiddle = mTwiddle[k];
+        mRe[k] += delta * mCos[twiddle];
+        mIm[k] -= delta * mSin[twiddle];
+        const uint32_t stepped = twiddle + mBin[k];
+        mTwiddle[k] = stepped >= points ? stepped - points : stepped;
+    }
+    mNext = mNext + 1 == mPoints ? 0 : mNext + 1;
+}
+
+float OrderTracker::amplitude(std::size_t k) const {
+    const double scale = (mBin[k] == 0 ? 1.0 : 2.0) / static_cast<double>(mPoints);
+    return static_cast<float>(std::hypot(mRe[k], mIm[k]) * scale);
+}
+
+float OrderTracker::phaseRad(std::size_t k) const {
+    return static_cast<float>(std::atan2(mIm[k], mRe[k]));
+}
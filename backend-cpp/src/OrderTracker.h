@@ -0,0 +1,73 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// ── Engine-order analysis in the crank-angle domain ──
+// Tracks the amplitude and phase of chosen engine orders (harmonics per
+// crankshaft revolution) of one signal as it is produced. Samples arrive at
+// uniform time steps; they are linearly resampled onto a fixed grid of
+// pointsPerCycle crank angles over the four-stroke cycle (4π), so the window
+// is always exactly one cycle whatever the speed, and half orders resolve.
+//
+// The window is a sliding DFT keyed by grid index rather than by arrival:
+// the ring holds the latest sample at every grid angle, and a new sample at
+// index j only adds (x_new − x_old)·e^{−i·2π·m·j/N} to each tracked bin m.
+// That is O(orders) per grid point, with no rotation factor to accumulate
+// error and phases referenced to cylinder 1's firing TDC. Sums are in double;
+// the error stays at rounding level over days of running.
+class OrderTracker {
+public:
+    static constexpr std::size_t kMaxOrders = 16;
+    static constexpr std::size_t kDefaultPointsPerCycle = 720;   // 1° of crank
+
+    // Orders are rounded to the nearest half; ones at or above the grid's
+    // Nyquist order (pointsPerCycle / 4) are dropped, and at most kMaxOrders
+    // are kept.
+    explicit OrderTracker(std::span<const float> orders,
+                          std::size_t pointsPerCycle = kDefaultPointsPerCycle);
+
+    // cycleAngleRad in [0, 4π). A step back, or forward by more than a
+    // quarter cycle, is a discontinuity: resampling restarts from there and
+    // the ring keeps what it had.
+    void push(float cycleAngleRad, float value);
+
+    [[nodiscard]] std::size_t orders() const { return mOrderCount; }
+    [[nodiscard]] float order(std::size_t k) const { return 0.5f * static_cast<float>(mBin[k]); }
+
+    // x(φ) ≈ Σ amplitude·cos(order·φ + phase) with φ the cycle angle; order 0
+    // is the mean.
+    [[nodiscard]] float amplitude(std::size_t k) const;
+    [[nodiscard]] float phaseRad(std::size_t k) const;
+
+    // True once a whole cycle of grid points has been filled.
+    [[nodiscard]] bool ready() const { return mFilled >= mPoints; }
+    [[nodiscard]] std::size_t pointsPerCycle() const { return mPoints; }
+
+    void reset();
+
+private:
+    void seek(std::size_t index);
+    void add(float value);   // at mNext, then steps to the next grid angle
+
+    std::size_t mPoints;
+    double mPointsPerRad;
+
+    std::array<uint32_t, kMaxOrders> mBin{};   // DFT bin = 2·order
+    std::size_t mOrderCount = 0;
+    std::array<double, kMaxOrders> mRe{};
+    std::array<double, kMaxOrders> mIm{};
+    std::array<uint32_t, kMaxOrders> mTwiddle{};   // bin·mNext mod N
+
+    std::vector<double> mCos;                  // cos/sin(2π·j/N)
+    std::vector<double> mSin;
+    std::vector<float> mRing;                  // latest sample per grid angle
+
+    bool mStarted = false;
+    double mLastPos = 0.0;                     // previous sample, in grid units
+    float mLastValue = 0.0f;
+    std::size_t mNext = 0;                     // next grid index to fill
+    std::size_t mFilled = 0;
+};
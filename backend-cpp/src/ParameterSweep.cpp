@@ -0,0 +1,77 @@
+#include "ParameterSweep.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <thread>
+#include "GasPressure.h"
+
+namespace {
+
+bool axisValid(const SweepAxis& a) {
+    return a.points > 0 && std::isfinite(a.min) && std::isfinite(a.max);
+}
+
+float axisLow(const SweepAxis& a)  { return std::min(a.at(0), a.at(a.points - 1)); }
+float axisHigh(const SweepAxis& a) { return std::max(a.at(0), a.at(a.points - 1)); }
+
+void runBlock(const SweepGrid& grid, std::size_t begin, std::size_t end, SweepCell* out) {
+    CycleEvaluator cycle(grid.samplesPerCycle);
+
+    std::size_t lastRpmIdx = grid.rpm.points;  // none yet
+    for (std::size_t cell = begin; cell < end; ++cell) {
+        std::size_t idx = cell;
+        const std::size_t it = idx % grid.crankThrowM.points;   idx /= grid.crankThrowM.points;
+        const std::size_t ir = idx % grid.conRodLengthM.points; idx /= grid.conRodLengthM.points;
+        const std::size_t im = idx % grid.pistonMassKg.points;  idx /= grid.pistonMassKg.points;
+        const std::size_t irpm = idx;
+
+        // RPM is the slowest axis, so ω and the gas trace change rarely.
+        const float rpm = grid.rpm.at(irpm);
+        if (irpm != lastRpmIdx) {
+            lastRpmIdx = irpm;
+            cycle.setOperatingPoint(rpm, grid.load);
+        }
+
+        SweepCell& c = out[cell];
+        c.geometry = {grid.crankThrowM.at(it), grid.conRodLengthM.at(ir), grid.pistonMassKg.at(im)};
+        c.rpm = rpm;
+        c.peaks = cycle.evaluate(c.geometry);
+        if (grid.sensitivities) c.sensitivity = cycle.sensitivity(c.geometry);
+    }
+}
+
+} // namespace
+
+std::optional<std::vector<SweepCell>> ParameterSweep::run(const SweepGrid& grid, unsigned threads) {
+    if (!axisValid(grid.crankThrowM) || !axisValid(grid.conRodLengthM)
+        || !axisValid(grid.pistonMassKg) || !axisValid(grid.rpm) || grid.samplesPerCycle == 0) {
+        return std::nullopt;
+    }
+    if (axisLow(grid.crankThrowM) <= 0.0f
+        || axisLow(grid.conRodLengthM) <= axisHigh(grid.crankThrowM)
+        || axisLow(grid.pistonMassKg) <= 0.0f
+        || axisLow(grid.rpm) < 0.0f) {
+        return std::nullopt;
+    }
+
+    const std::size_t cells = grid.cells();
+    std::vector<SweepCell> result(cells);
+
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(std::min<std::size_t>(threads, cells));
+
+    // Build the shared (read-only) pressure table before the workers start.
+    if (grid.load > 0.0f) (void)GasPressureTable::instance<DefaultGeometry>();
+
+    // Every cell costs the same, so equal contiguous blocks balance the load.
+    {
+        std::vector<std::jthread> workers;
+        workers.reserve(threads);
+        for (unsigned w = 0; w < threads; ++w) {
+            std::size_t begin = cells * w / threads;
+            std::size_t end = cells * (w + 1) / threads;
+            workers.emplace_back(runBlock, std::cref(grid), begin, end, result.data());
+        }
+    }
+    return result;
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <cstddef>
+#include <optional>
+#include <vector>
+#include "CycleEvaluator.h"
+
+// ── Multi-core design sweep over crank geometry × RPM ──
+// Evaluates the crank-slider force chain over one full four-stroke cycle for
+// every cell of the cartesian grid throw × rod length × piston mass × RPM and
+// reduces each cell to its design-relevant peaks. Cells are split into one
+// contiguous block per worker; each worker owns its scratch buffers and writes
+// only its own slice of the result, so the hot loop shares no mutable state.
+// Per-cell evaluation and the gas-force assumptions are CycleEvaluator's.
+// With `sensitivities` each cell also gets the rod force gradients from one
+// forward-mode pass, instead of eight extra cells for central differences.
+struct SweepAxis {
+    float min = 0.0f;
+    float max = 0.0f;
+    std::size_t points = 1;
+
+    // Evenly spaced; a one-point axis sits at min.
+    [[nodiscard]] float at(std::size_t i) const {
+        if (points < 2) return min;
+        return min + (max - min) * static_cast<float>(i) / static_cast<float>(points - 1);
+    }
+};
+
+struct SweepGrid {
+    SweepAxis crankThrowM   {DefaultGeometry::kCrankThrow, DefaultGeometry::kCrankThrow, 1};
+    SweepAxis conRodLengthM {DefaultGeometry::kConRodLength, DefaultGeometry::kConRodLength, 1};
+    SweepAxis pistonMassKg  {DefaultGeometry::kPistonMass, DefaultGeometry::kPistonMass, 1};
+    SweepAxis rpm           {1000.0f, 8000.0f, 8};
+    float load = 0.0f;                     // throttle 0…1 for the gas force
+    std::size_t samplesPerCycle = 720;     // over 720°
+    bool sensitivities = false;            // also fill SweepCell::sensitivity
+
+    [[nodiscard]] std::size_t cells() const {
+        return crankThrowM.points * conRodLengthM.points * pistonMassKg.points * rpm.points;
+    }
+};
+
+struct SweepCell {
+    CrankGeometry geometry;
+    float rpm = 0.0f;
+    CyclePeaks peaks;
+    CycleSensitivity sensitivity;   // zero unless SweepGrid::sensitivities
+};
+
+class ParameterSweep {
+public:
+    // Cells come back in grid order: throw varies fastest, RPM slowest.
+    // threads = 0 uses every hardware thread. Returns nullopt for an empty
+    // grid or any cell with a non-physical geometry (rod ≤ throw, mass ≤ 0).
+    static std::optional<std::vector<SweepCell>> run(const SweepGrid& grid, unsigned threads = 0);
+};
@@ -0,0 +1,55 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+// ── Philox4x32-10 counter-based random numbers ──
+// Salmon et al., "Parallel random numbers: as easy as 1, 2, 3" (SC'11).
+// The output is a pure function of (key, counter): sample i of a run keyed
+// by its seed draws from counter i no matter which thread evaluates it or in
+// what order, which makes parallel Monte Carlo reproducible by construction.
+class Philox4x32 {
+public:
+    using Block = std::array<uint32_t, 4>;
+
+    explicit constexpr Philox4x32(uint64_t seed)
+        : mKey{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)}
+    {}
+
+    [[nodiscard]] constexpr Block operator()(uint64_t counterLo, uint64_t counterHi = 0) const {
+        Block c{static_cast<uint32_t>(counterLo), static_cast<uint32_t>(counterLo >> 32),
+                static_cast<uint32_t>(counterHi), static_cast<uint32_t>(counterHi >> 32)};
+        std::array<uint32_t, 2> k = mKey;
+        for (int r = 0; r < 10; ++r) {
+            uint64_t p0 = static_cast<uint64_t>(kMul0) * c[0];
+            uint64_t p1 = static_cast<uint64_t>(kMul1) * c[2];
+            c = {static_cast<uint32_t>(p1 >> 32) ^ c[1] ^ k[0], static_cast<uint32_t>(p1),
+                 static_cast<uint32_t>(p0 >> 32) ^ c[3] ^ k[1], static_cast<uint32_t>(p0)};
+            k[0] += kWeyl0;
+            k[1] += kWeyl1;
+        }
+        return c;
+    }
+
+    // Uniform in the open interval (0, 1): 24 random mantissa bits, centred
+    // in their cell so neither endpoint is reachable.
+    [[nodiscard]] static constexpr float toUnit(uint32_t x) {
+        return (static_cast<float>(x >> 8) + 0.5f) * (1.0f / 16777216.0f);
+    }
+
+    // Two independent standard normals from two uniforms (Box–Muller).
+    static void toNormal(uint32_t a, uint32_t b, float& n0, float& n1) {
+        float r = std::sqrt(-2.0f * std::log(toUnit(a)));
+        float t = 6.28318530717958647692f * toUnit(b);
+        n0 = r * std::cos(t);
+        n1 = r * std::sin(t);
+    }
+
+private:
+    static constexpr uint32_t kMul0  = 0xD2511F53u;
+    static constexpr uint32_t kMul1  = 0xCD9E8D57u;
+    static constexpr uint32_t kWeyl0 = 0x9E3779B9u;
+    static constexpr uint32_t kWeyl1 = 0xBB67AE85u;
+
+    std::array<uint32_t, 2> mKey;
+};
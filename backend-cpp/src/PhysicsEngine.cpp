@@ -1,78 +1,479 @@
 #include "PhysicsEngine.h"
 #include <chrono>
+#include "CrankKernel.h"
+#include <limits>
 
-PhysicsEngine::PhysicsEngine()
-    : mStressMaxPa(computeStressMaxPa())
+static_assert(TorsionalModel::kMaxSections == protocol::kMaxShaftSections,
+              "StatePayload torsion arrays must cover every journal section");
+static_assert(OrderTracker::kMaxOrders == protocol::kMaxOrders,
+              "OrdersPayload arrays must cover every tracked order");
+
+namespace {
+
+// Running min/max/sum of one force across the substeps of a tick.
+struct ForceAccumulator {
+    float min = std::numeric_limits<float>::max();
+    float max = std::numeric_limits<float>::lowest();
+    float sum = 0.0f;
+
+    void add(float v) {
+        min = std::min(min, v);
+        max = std::max(max, v);
+        sum += v;
+    }
+
+    [[nodiscard]] protocol::ForceStats finish(unsigned count) const {
+        return { min, max, sum / static_cast<float>(count) };
+    }
+};
+
+} // namespace
+
+// ── TwinEngine ──
+
+TwinEngine::TwinEngine(float physicsRateHz, const EngineLayout& layout, float crankInertiaKgM2)
+    : mLayout(layout)
 {
+    physicsRateHz = std::clamp(physicsRateHz, kMinPhysicsRateHz, kMaxPhysicsRateHz);
+    mSubsteps = std::max(1u, static_cast<unsigned>(std::lround(physicsRateHz * kDt)));
+    mSubstepDt = kDt / static_cast<float>(mSubsteps);
+    mSubstepAlpha = rpmFilterAlpha(mSubstepDt);
+
     mAtomicRpmTarget.store(kDefaultRpm, std::memory_order_relaxed);
+    mDynamics.configure(crankInertiaKgM2, LoadModel{}, kRpmMax * kTwoPi / 60.0f);
 }
 
-float PhysicsEngine::computeStressMaxPa() {
-    float omegaMax = kRpmMax * kTwoPi / 60.0f;
-    float forceMax = kMass * kRadius * omegaMax * omegaMax;
-    return forceMax / kArea;
+void TwinEngine::setDynamics(SpeedModel model, const LoadModel& load) {
+    // A stopped crank has no starter; begin at the target instead.
+    float rpm = snapshot().rpm;
+    if (rpm <= 0.0f) rpm = rpmTarget();
+    const float omega = rpm * kTwoPi / 60.0f;
+    mSpeedModel = model;
+    mDynamics.configure(mDynamics.inertiaKgM2(), load, kRpmMax * kTwoPi / 60.0f);
+    mDynamics.reset(omega);
 }
 
-void PhysicsEngine::setRpmTarget(float target) {
+void TwinEngine::setRpmTarget(float target) {
     target = std::clamp(target, kRpmMin, kRpmMax);
     mAtomicRpmTarget.store(target, std::memory_order_relaxed);
 }
 
-float PhysicsEngine::rpmTarget() const {
+float TwinEngine::rpmTarget() const {
     return mAtomicRpmTarget.load(std::memory_order_relaxed);
 }
 
-void PhysicsEngine::step() {
+void TwinEngine::setLoad(float load) {
+    mAtomicLoad.store(std::clamp(load, 0.0f, 1.0f), std::memory_order_relaxed);
+}
+
+float TwinEngine::load() const {
+    return mAtomicLoad.load(std::memory_order_relaxed);
+}
+
+protocol::StatePayload TwinEngine::snapshot() const {
+    return mLatestSnapshot.load(std::memory_order_acquire);
+}
+
+void TwinEngine::setStressBasis(std::shared_ptr<const StressBasis> basis) {
+    if (basis) mWebStress.emplace(std::move(basis));
+    else mWebStress.reset();
+}
+
+void TwinEngine::enableEstimator(const EstimatorConfig& config) {
+    if (mSpeedModel != SpeedModel::Torque) setDynamics(SpeedModel::Torque);
+    mEstimator.emplace(estimatorModel(), config);
+    mEstimator->reset(currentEstimate());
+}
+
+void TwinEngine::disableEstimator() {
+    mEstimator.reset();
+    mDynamics.releaseLoad();
+}
+
+void TwinEngine::assimilate(std::span<const SensorSample> samples) {
+    if (!mEstimator) return;
+    mEstimator->update(samples);
+    mEstimator->finishTick(kDt);
+    applyEstimate(mEstimator->estimate());
+}
+
+void TwinEngine::enableRainflow() {
+    resetRainflow();
+    mRainflowOn = true;
+}
+
+void TwinEngine::resetRainflow() {
+    for (auto& counter : mRainflow) counter.reset();
+}
+
+void TwinEngine::enableOrders(std::span<const float> orders) {
+    mOrders.assign(kOrderSignals, OrderTracker(orders));
+}
+
+protocol::OrdersPayload TwinEngine::ordersSnapshot() const {
+    const protocol::StatePayload state = snapshot();
+    protocol::OrdersPayload payload;
+    payload.timestampMs = state.timestampMs;
+    payload.rpm = state.rpm;
+    if (mOrders.empty()) return payload;
+
+    const OrderTracker& torque = mOrders[static_cast<std::size_t>(OrderSignal::EngineTorqueNm)];
+    const OrderTracker& side = mOrders[static_cast<std::size_t>(OrderSignal::SideThrustN)];
+    payload.ready = torque.ready();
+    payload.count = static_cast<uint8_t>(torque.orders());
+    for (std::size_t k = 0; k < torque.orders(); ++k) {
+        payload.order[k] = torque.order(k);
+        payload.torqueAmplitudeNm[k] = torque.amplitude(k);
+        payload.torquePhaseRad[k] = torque.phaseRad(k);
+        payload.sideThrustAmplitudeN[k] = side.amplitude(k);
+        payload.sideThrustPhaseRad[k] = side.phaseRad(k);
+    }
+    return payload;
+}
+
+void TwinEngine::enableAngleGrid(float stepRad) {
+    // Every point a tick can pass at kRpmMax, plus both ends.
+    const float perTick = kRpmMax / 60.0f * kTwoPi * kDt;
+    const auto maxPoints = static_cast<std::size_t>(std::ceil(perTick / stepRad)) + 2;
+    mAngleGrid.emplace(stepRad, maxPoints);
+    mAngleSamples.clear();
+    mAngleSamples.reserve(mAngleGrid->capacity());
+
+    const std::size_t lanes = mAngleGrid->capacity() * mLayout.cylinders();
+    for (auto* v : {&mAngleScratch.angle, &mAngleScratch.omega, &mAngleScratch.gas, &mAngleScratch.piston,
+                    &mAngleScratch.rod, &mAngleScratch.tangential, &mAngleScratch.torque, &mAngleScratch.side}) {
+        v->assign(lanes, 0.0f);
+    }
+}
+
+void TwinEngine::disableAngleGrid() {
+    mAngleGrid.reset();
+    mAngleSamples.clear();
+}
+
+void TwinEngine::enableCapture(std::size_t capacity) {
+    mCapture = std::make_unique<BurstCapture>(capacity, mSubstepDt);
+}
+
+void TwinEngine::publish(const protocol::StatePayload& state) {
+    mHistory.push(state);
+    mLatestSnapshot.store(state, std::memory_order_release);
+}
+
+void TwinEngine::saveCheckpoint(std::vector<uint8_t>& out) const {
+    Checkpoint::begin(out, *this);
+    CheckpointOut io(out);
+    writeState(io);
+}
+
+bool TwinEngine::restoreCheckpoint(std::span<const uint8_t> checkpoint, std::string* error,
+                                   bool requireSealed) {
+    const std::span<const uint8_t> body = Checkpoint::body(checkpoint, *this, requireSealed, error);
+    if (body.empty()) return false;
+    if (!readState(body)) {
+        if (error) *error = "corrupt checkpoint body";
+        return false;
+    }
+    // A held load belongs to the estimator that set it.
+    if (mEstimator) {
+        if (mSpeedModel != SpeedModel::Torque) setDynamics(SpeedModel::Torque);
+        mEstimator->reset(currentEstimate());
+    } else {
+        mDynamics.releaseLoad();
+    }
+    for (auto& tracker : mOrders) tracker.reset();
+    return true;
+}
+
+template <typename Self, typename Io>
+void TwinEngine::visitTwin(Self& self, Io& io) {
+    uint8_t speedModel = static_cast<uint8_t>(self.mSpeedModel);
+    io(speedModel);
+    if (speedModel > static_cast<uint8_t>(SpeedModel::Torque)) return io.fail();
+    CrankDynamics::visitState(self.mDynamics, io);
+
+    float rpmTarget = self.mAtomicRpmTarget.load(std::memory_order_relaxed);
+    float load = self.mAtomicLoad.load(std::memory_order_relaxed);
+    float cycleAngleRad = self.mAtomicCycleAngleRad.load(std::memory_order_relaxed);
+    protocol::StatePayload latest = self.snapshot();
+    io(rpmTarget);
+    io(load);
+    io(cycleAngleRad);
+    visitStatePayload(latest, io);
+
+    visitRing(self.mHistory, io, [](auto& state, Io& io) { visitStatePayload(state, io); });
+    RevolutionAggregator::visitState(self.mRevolutions, io);
+    visitRing(self.mRevolutionHistory, io, [](auto& rev, Io& io) { visitRevolutionPayload(rev, io); });
+    visitFlag(self.mRainflowOn, io);
+    for (auto& counter : self.mRainflow) RainflowCounter::visitState(counter, io);
+
+    if constexpr (Io::kReading) {
+        self.mSpeedModel = static_cast<SpeedModel>(speedModel);
+        self.mAtomicRpmTarget.store(rpmTarget, std::memory_order_relaxed);
+        self.mAtomicLoad.store(load, std::memory_order_relaxed);
+        self.mAtomicCycleAngleRad.store(cycleAngleRad, std::memory_order_relaxed);
+        self.mLatestSnapshot.store(latest, std::memory_order_release);
+    }
+}
+
+// ── BasicPhysicsEngine ──
+
+template <typename Geometry, typename Phase>
+BasicPhysicsEngine<Geometry, Phase>::BasicPhysicsEngine(float physicsRateHz, const EngineLayout& layout)
+    : TwinEngine(physicsRateHz, layout, computeCrankInertia(layout))
+    , mTorsion(TorsionalParams::of<Geometry>(), mLayout.throws(), mSubstepDt)
+    , mStressMaxPa(computeStressMaxPa())
+{
+    for (std::size_t s = 0; s < kFatigueSignals; ++s) {
+        mRainflow[s] = RainflowCounter(rainflowSpec(static_cast<FatigueSignal>(s)));
+    }
+    for (std::size_t c = 0; c < mLayout.cylinders(); ++c) {
+        mBoreAxisSin[c] = std::sin(mLayout.boreAxisRad()[c]);
+        mBoreAxisCos[c] = std::cos(mLayout.boreAxisRad()[c]);
+    }
+
+    // Build the shared pressure table here rather than inside the first tick.
+    (void)GasPressureTable::instance<Geometry>();
+}
+
+template <typename Geometry, typename Phase>
+float BasicPhysicsEngine<Geometry, Phase>::computeStressMaxPa() {
+    float omegaMax = kRpmMax * kTwoPi / 60.0f;
+    float forceMax = kMass * kRadius * omegaMax * omegaMax;
+    return forceMax / kArea;
+}
+
+template <typename Geometry, typename Phase>
+RainflowSpec BasicPhysicsEngine<Geometry, Phase>::rainflowSpec(FatigueSignal signal, bool withGas) {
+    RainflowSpec spec;
+    if (signal == FatigueSignal::StressPa) {
+        spec.rangeMax = computeStressMaxPa();
+        spec.meanMin = 0.0f;
+        spec.meanMax = spec.rangeMax;
+        return spec;
+    }
+
+    // Rod load swings from the inertia pull at TDC to gas plus inertia push;
+    // 1/cos φ adds at most 1/√(1 - λ²).
+    const float omegaMax = kRpmMax * kTwoPi / 60.0f;
+    const float inertiaN = kPistonMass * kCrankThrow * omegaMax * omegaMax * (1.0f + kLambda);
+    const float gasN = withGas ? (GasPressureTable::instance<Geometry>().peakPa()
+                                  - GasPressureTable::kCrankcasePa) * kBoreArea
+                               : 0.0f;
+    float range = (gasN + 2.0f * inertiaN) / std::sqrt(1.0f - kLambda * kLambda);
+    if (signal == FatigueSignal::TorqueNm) range *= kCrankThrow;
+    spec.rangeMax = range;
+    spec.meanMin = -0.5f * range;
+    spec.meanMax = 0.5f * range;
+    return spec;
+}
+
+template <typename Geometry, typename Phase>
+float BasicPhysicsEngine<Geometry, Phase>::computeCrankInertia(const EngineLayout& layout) {
+    constexpr float kPerCylinder = 0.5f * kPistonMass * kCrankThrow * kCrankThrow;
+    return Geometry::kPulleyInertia + Geometry::kFlywheelInertia
+           + static_cast<float>(layout.throws()) * Geometry::kThrowInertia
+           + static_cast<float>(layout.cylinders()) * kPerCylinder;
+}
+
+template <typename Geometry, typename Phase>
+EstimatorModel BasicPhysicsEngine<Geometry, Phase>::estimatorModel() const {
+    EstimatorModel model;
+    model.crank = {kCrankThrow, kConRodLength, kPistonMass};
+    model.boreArea = kBoreArea;
+    model.inertiaKgM2 = mDynamics.inertiaKgM2();
+    model.layout = mLayout;
+    model.gas = &GasPressureTable::instance<Geometry>();
+    return model;
+}
+
+template <typename Geometry, typename Phase>
+CrankEstimate BasicPhysicsEngine<Geometry, Phase>::currentEstimate() const {
+    // Under the filter model the net torque is what the load must be absorbing
+    // on average. Speed and throttle are read where setDynamics() and
+    // setLoad() leave them, so seeding works before the first step too.
+    const bool torqueDriven = mSpeedModel == SpeedModel::Torque;
+    const float loadTorque = torqueDriven ? mDynamics.loadTorqueNm() : snapshot().engineTorqueStats.mean;
+    const float omega = torqueDriven ? mDynamics.omega() : mRpm * kTwoPi / 60.0f;
+    return { mCycleAngleRad, omega, loadTorque, load() };
+}
+
+template <typename Geometry, typename Phase>
+void BasicPhysicsEngine<Geometry, Phase>::applyEstimate(const CrankEstimate& estimate) {
+    mPhase.set(estimate.cycleAngleRad);
+    mCycleAngleRad = mPhase.cycleRad();
+    mAngleRad = mPhase.crankRad();
+    mOmegaRadS = estimate.omegaRadS;
+    mRpm = std::clamp(mOmegaRadS * 60.0f / kTwoPi, kRpmMin, kRpmMax);
+    mDynamics.setOmega(mOmegaRadS);
+    mDynamics.holdLoad(estimate.loadTorqueNm);
+    mLoad = estimate.throttle;
+    mAtomicLoad.store(estimate.throttle, std::memory_order_relaxed);
+}
+
+template <typename Geometry, typename Phase>
+void BasicPhysicsEngine<Geometry, Phase>::step() {
     float target = mAtomicRpmTarget.load(std::memory_order_relaxed);
     mRpmTarget = target;
+    mLoad = mAtomicLoad.load(std::memory_order_relaxed);
 
-    // Smooth RPM response: rpm += (target - rpm) * (1 - exp(-dt / tau))
-    float alpha = 1.0f - std::exp(-kDt / kTau);
-    mRpm += (mRpmTarget - mRpm) * alpha;
-    mRpm = std::clamp(mRpm, kRpmMin, kRpmMax);
+    // Load and speed move slowly next to the crank; resolve the pressure
+    // curves once per tick and only interpolate in angle per substep.
+    const GasPressureTable::Slice gas = GasPressureTable::instance<Geometry>().slice(mLoad, mRpm);
+    constexpr float kCycleRad = EngineLayout::kCycleRad;
 
-    mOmegaRadS = mRpm * kTwoPi / 60.0f;
+    ForceAccumulator piston, rod, tangential, torque, side, engineTorque, rpm;
 
-    mAngleRad += mOmegaRadS * kDt;
-    if (mAngleRad >= kTwoPi) mAngleRad -= kTwoPi;
-    if (mAngleRad < 0.0f)    mAngleRad += kTwoPi;
+    // Revolutions that close in this tick; at kRpmMax a tick spans 1.3.
+    std::array<protocol::RevolutionPayload, 4> closed;
+    std::size_t closedCount = 0;
+    float maxShearPa = 0.0f;
+    const bool torqueDriven = mSpeedModel == SpeedModel::Torque;
+    if (mAngleGrid) mAngleGrid->beginTick();
+    BurstCapture* capture = nullptr;
+    if (mCapture) {
+        mCapture->beginTick();
+        if (mCapture->armed()) capture = mCapture.get();
+    }
+    const float targetOmega = mRpmTarget * kTwoPi / 60.0f;
 
-    float force = kMass * kRadius * mOmegaRadS * mOmegaRadS;
-    mStressPa = force / kArea;
-    mStressFactor = std::clamp(mStressPa / mStressMaxPa, 0.0f, 1.0f);
+    const std::size_t cylinders = mLayout.cylinders();
+    const std::size_t throws = mLayout.throws();
+    const uint8_t* throwOf = mLayout.throwOf().data();
+    const float* phase = mLayout.phaseRad().data();
+    const CrankForceArrays cylForces{
+        mCylPistonForceN.data(), mCylRodForceN.data(), mCylTangentialForceN.data(),
+        mCylTorqueNm.data(), mCylSideThrustN.data()};
+
+    // Integrate at the internal rate; the broadcast only sees the decimated
+    // end-of-tick state plus the spread of each force over the substeps.
+    for (unsigned i = 0; i < mSubsteps; ++i) {
+        const float startCycleRad = mCycleAngleRad;
+        const float startOmega = mOmegaRadS;
+        float dAngle;
+        if (torqueDriven) {
+            // Forces at the new angle use the predicted end-of-step speed;
+            // the speed itself is corrected once the torque is known.
+            dAngle = mPhase.advanceBy(mDynamics.advance(mSubstepDt));
+            mOmegaRadS = mDynamics.predictedOmega();
+        } else {
+            // Smooth RPM response: rpm += (target - rpm) * (1 - exp(-h / tau))
+            mRpm += (mRpmTarget - mRpm) * mSubstepAlpha;
+            mRpm = std::clamp(mRpm, kRpmMin, kRpmMax);
+            mOmegaRadS = mRpm * kTwoPi / 60.0f;
+            dAngle = mPhase.advance(mOmegaRadS, mSubstepDt);
+        }
+        mAngleRad = mPhase.crankRad();
+        mCycleAngleRad = mPhase.cycleRad();
 
-    // Crank-slider dynamics (inertial forces only — no gas pressure)
-    // Piston acceleration (2nd-order approximation):
-    //   a = -R·ω²·(cos θ + λ·cos 2θ)
-    float omega2 = mOmegaRadS * mOmegaRadS;
-    float cosTheta = std::cos(mAngleRad);
-    float sinTheta = std::sin(mAngleRad);
-    float pistonAccel = -kCrankThrow * omega2
-                        * (cosTheta + kLambda * std::cos(2.0f * mAngleRad));
-    mPistonForceN = kPistonMass * pistonAccel;
+        // All cylinders in one batch: each sees the crank at its own phase.
+        for (std::size_t c = 0; c < cylinders; ++c) {
+            float cycle = mCycleAngleRad - phase[c];
+            if (cycle < 0.0f) cycle += kCycleRad;
+            mCylAngleRad[c] = cycle;
+            mCylOmegaRadS[c] = mOmegaRadS;
+            mCylGasForceN[c] = (GasPressureTable::pressurePa(gas, cycle)
+                                - GasPressureTable::kCrankcasePa) * kBoreArea;
+        }
+        computeCrankForcesBatch<Geometry>(mCylAngleRad.data(), mCylOmegaRadS.data(),
+                                          mCylGasForceN.data(), cylinders, cylForces);
 
-    // Connecting rod angle from bore axis: φ = asin(λ·sin θ)
-    float sinPhi = kLambda * sinTheta;
-    float phi = std::asin(std::clamp(sinPhi, -1.0f, 1.0f));
-    float cosPhi = std::cos(phi);
+        // Crankshaft torque is the plain sum; the shaking force is the
+        // reaction of every piston's inertia force along its own bore axis.
+        // Gas pressure pushes the head as hard as the piston and cancels
+        // inside the block, so it is taken back out of the piston force.
+        float torqueSum = 0.0f;
+        float shakeX = 0.0f;
+        float shakeY = 0.0f;
+        for (std::size_t c = 0; c < cylinders; ++c) {
+            torqueSum += mCylTorqueNm[c];
+            const float inertiaN = mCylPistonForceN[c] - mCylGasForceN[c];
+            shakeX -= inertiaN * mBoreAxisSin[c];
+            shakeY -= inertiaN * mBoreAxisCos[c];
+        }
+        mEngineTorqueNm = torqueSum;
+        mShakingForceXN = shakeX;
+        mShakingForceYN = shakeY;
 
-    // Rod force (along rod axis): F_rod = F_piston / cos φ
-    mRodForceN = (cosPhi > 1e-4f) ? mPistonForceN / cosPhi : 0.0f;
+        if (torqueDriven) {
+            mDynamics.correct(torqueSum, targetOmega, mSubstepDt);
+            mOmegaRadS = mDynamics.omega();
+            mRpm = mOmegaRadS * 60.0f / kTwoPi;
+        }
 
-    // Tangential force at crank pin (perpendicular to crank arm, drives rotation):
-    //   F_t = F_rod · sin(θ + φ)
-    float thetaPlusPhi = mAngleRad + phi;
-    mTangentialForceN = mRodForceN * std::sin(thetaPlusPhi);
+        // Cylinders sharing a throw (V engines) load it together.
+        if (throws == cylinders) {
+            mTorsion.step(mCylTorqueNm.data());
+        } else {
+            std::fill_n(mThrowTorqueNm.begin(), throws, 0.0f);
+            for (std::size_t c = 0; c < cylinders; ++c) mThrowTorqueNm[throwOf[c]] += mCylTorqueNm[c];
+            mTorsion.step(mThrowTorqueNm.data());
+        }
 
-    // Instantaneous torque: T = F_t · R
-    mTorqueNm = mTangentialForceN * kCrankThrow;
+        if (mAngleGrid) {
+            mAngleGrid->cross(startCycleRad, dAngle, static_cast<float>(i) * mSubstepDt, mSubstepDt,
+                              startOmega, mOmegaRadS);
+        }
 
-    // Side thrust on cylinder wall: F_side = F_piston · tan φ
-    mSideThrustN = (cosPhi > 1e-4f) ? mPistonForceN * sinPhi / cosPhi : 0.0f;
+        if (mRevolutions.add(mSubstepDt, dAngle, mAngleRad,
+                             {torqueSum, mCylRodForceN[0], mCylSideThrustN[0]})
+            && closedCount < closed.size()) {
+            closed[closedCount++] = mRevolutions.completed();
+        }
+
+        const float stressPa = kMass * kRadius * mOmegaRadS * mOmegaRadS / kArea;
+        if (mRainflowOn) {
+            mRainflow[static_cast<std::size_t>(FatigueSignal::StressPa)].push(stressPa);
+            mRainflow[static_cast<std::size_t>(FatigueSignal::RodForceN)].push(mCylRodForceN[0]);
+            mRainflow[static_cast<std::size_t>(FatigueSignal::TorqueNm)].push(mCylTorqueNm[0]);
+        }
+        if (!mOrders.empty()) {
+            mOrders[static_cast<std::size_t>(OrderSignal::EngineTorqueNm)].push(mCycleAngleRad, torqueSum);
+            mOrders[static_cast<std::size_t>(OrderSignal::SideThrustN)].push(mCycleAngleRad, mCylSideThrustN[0]);
+        }
+        const float shearPa = mTorsion.maxShearStressPa();
+        maxShearPa = std::max(maxShearPa, shearPa);
+        if (capture) {
+            capture->record({mCycleAngleRad, mOmegaRadS,
+                             mCylGasForceN[0] / kBoreArea + GasPressureTable::kCrankcasePa,
+                             mCylPistonForceN[0], mCylRodForceN[0], mCylTangentialForceN[0],
+                             mCylTorqueNm[0], mCylSideThrustN[0], torqueSum, stressPa, shearPa},
+                            mRpm);
+        }
+
+        piston.add(mCylPistonForceN[0]);
+        rod.add(mCylRodForceN[0]);
+        tangential.add(mCylTangentialForceN[0]);
+        torque.add(mCylTorqueNm[0]);
+        side.add(mCylSideThrustN[0]);
+        engineTorque.add(torqueSum);
+        rpm.add(mRpm);
+    }
+
+    mCylinderPressurePa = mCylGasForceN[0] / kBoreArea + GasPressureTable::kCrankcasePa;
+    if (mAngleGrid) evaluateAngleGrid(gas);
+
+    // Scalar force fields describe cylinder 1, the one the dashboard draws.
+    mPistonForceN     = mCylPistonForceN[0];
+    mRodForceN        = mCylRodForceN[0];
+    mTangentialForceN = mCylTangentialForceN[0];
+    mTorqueNm         = mCylTorqueNm[0];
+    mSideThrustN      = mCylSideThrustN[0];
+
+    float force = kMass * kRadius * mOmegaRadS * mOmegaRadS;
+    mStressPa = force / kArea;
+    mStressFactor = std::clamp(mStressPa / mStressMaxPa, 0.0f, 1.0f);
 
     auto now = std::chrono::steady_clock::now().time_since_epoch();
     auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now).count();
 
+    if (capture) capture->endTick(static_cast<uint64_t>(ms));
+
+    for (std::size_t r = 0; r < closedCount; ++r) {
+        closed[r].timestampMs = static_cast<uint64_t>(ms);
+        mRevolutionHistory.push(closed[r]);
+    }
+
     protocol::StatePayload state{};
     state.rpm = mRpm;
     state.angleRad = mAngleRad;
@@ -84,11 +485,203 @@ void PhysicsEngine::step() {
     state.torqueNm = mTorqueNm;
     state.sideThrustN = mSideThrustN;
     state.timestampMs = static_cast<uint64_t>(ms);
+    state.load = mLoad;
+    state.cylinderPressurePa = mCylinderPressurePa;
+    state.engineTorqueNm = mEngineTorqueNm;
+    state.shakingForceXN = mShakingForceXN;
+    state.shakingForceYN = mShakingForceYN;
+    state.pistonForceStats     = piston.finish(mSubsteps);
+    state.rodForceStats        = rod.finish(mSubsteps);
+    state.tangentialForceStats = tangential.finish(mSubsteps);
+    state.torqueStats          = torque.finish(mSubsteps);
+    state.sideThrustStats      = side.finish(mSubsteps);
+    state.engineTorqueStats    = engineTorque.finish(mSubsteps);
+    state.rpmStats             = rpm.finish(mSubsteps);
+    state.loadTorqueNm         = torqueDriven ? mDynamics.loadTorqueNm() : 0.0f;
 
-    mHistory.push(state);
-    mLatestSnapshot.store(state, std::memory_order_release);
+    state.shaftSections = static_cast<uint8_t>(mTorsion.sections());
+    for (std::size_t i = 0; i < mTorsion.sections(); ++i) {
+        state.twistRad[i] = mTorsion.twistRad(i);
+        state.shearStressPa[i] = mTorsion.shearStressPa(i);
+    }
+    state.maxShearStressPa = maxShearPa;
+
+    if (mWebStress) {
+        // Rod force on the pin in the web frame: cos(θ+φ) resolves it along
+        // the crank arm; compression pushes the pin toward the journal.
+        const float theta = mCylAngleRad[0];
+        const float sinPhi = kLambda * std::sin(theta);
+        const float cosPhi = std::sqrt(std::max(0.0f, 1.0f - sinPhi * sinPhi));
+        const float cosThetaPhi = std::cos(theta) * cosPhi - std::sin(theta) * sinPhi;
+        mWebStress->evaluate({-mRodForceN * cosThetaPhi, mTangentialForceN, mOmegaRadS * mOmegaRadS});
+        state.webStressMaxPa = mWebStress->maxVonMisesPa();
+        state.webHotspotNode = static_cast<int32_t>(mWebStress->hotspotNode());
+    }
+
+    mAtomicCycleAngleRad.store(mCycleAngleRad, std::memory_order_relaxed);
+    publish(state);
 }
 
-protocol::StatePayload PhysicsEngine::snapshot() const {
-    return mLatestSnapshot.load(std::memory_order_acquire);
+template <typename Geometry, typename Phase>
+std::unique_ptr<TwinEngine> BasicPhysicsEngine<Geometry, Phase>::fork() const {
+    std::vector<uint8_t> checkpoint;
+    saveCheckpoint(checkpoint);
+    auto twin = std::make_unique<BasicPhysicsEngine>(physicsRateHz(), mLayout);
+    if (!twin->decode(std::span<const uint8_t>(checkpoint).subspan(Checkpoint::kHeaderBytes))) return nullptr;
+    twin->mDynamics.releaseLoad();
+    return twin;
 }
+
+template <typename Geometry, typename Phase>
+void BasicPhysicsEngine<Geometry, Phase>::writeState(CheckpointOut& io) const {
+    visitState(*this, io);
+}
+
+template <typename Geometry, typename Phase>
+bool BasicPhysicsEngine<Geometry, Phase>::readState(std::span<const uint8_t> body) {
+    // Validate on a scratch twin so that a bad body leaves this one as it
+    // was. The twin holds the history rings, so it goes on the heap: this
+    // runs on the I/O thread for every sandbox fork.
+    auto scratch = std::make_unique<BasicPhysicsEngine>(physicsRateHz(), mLayout);
+    return scratch->decode(body) && decode(body);
+}
+
+template <typename Geometry, typename Phase>
+bool BasicPhysicsEngine<Geometry, Phase>::decode(std::span<const uint8_t> body) {
+    CheckpointIn io(body);
+    visitState(*this, io);
+    return io.finished();
+}
+
+template <typename Geometry, typename Phase>
+template <typename Self, typename Io>
+void BasicPhysicsEngine<Geometry, Phase>::visitState(Self& self, Io& io) {
+    visitTwin(self, io);
+    Phase::visitState(self.mPhase, io);
+    io(self.mRpm);
+    io(self.mRpmTarget);
+    io(self.mAngleRad);
+    io(self.mCycleAngleRad);
+    io(self.mLoad);
+    io(self.mCylinderPressurePa);
+    io(self.mOmegaRadS);
+    io(self.mStressPa);
+    io(self.mStressFactor);
+    io(self.mPistonForceN);
+    io(self.mRodForceN);
+    io(self.mTangentialForceN);
+    io(self.mTorqueNm);
+    io(self.mSideThrustN);
+    io(self.mEngineTorqueNm);
+    io(self.mShakingForceXN);
+    io(self.mShakingForceYN);
+    TorsionalModel::visitState(self.mTorsion, io);
+}
+
+template <typename Geometry, typename Phase>
+void BasicPhysicsEngine<Geometry, Phase>::evaluateAngleGrid(const GasPressureTable::Slice& gas) {
+    const std::size_t points = mAngleGrid->count();
+    const std::size_t cylinders = mLayout.cylinders();
+    const float* phase = mLayout.phaseRad().data();
+    const float* gridAngle = mAngleGrid->cycleAngleRad();
+    const float* gridOmega = mAngleGrid->omegaRadS();
+    AngleScratch& x = mAngleScratch;
+    constexpr float kCycleRad = EngineLayout::kCycleRad;
+
+    // Cylinder-major lanes: cylinder 1's points come first and contiguous.
+    for (std::size_t c = 0; c < cylinders; ++c) {
+        for (std::size_t p = 0; p < points; ++p) {
+            const std::size_t lane = c * points + p;
+            float cycle = gridAngle[p] - phase[c];
+            if (cycle < 0.0f) cycle += kCycleRad;
+            x.angle[lane] = cycle;
+            x.omega[lane] = gridOmega[p];
+            x.gas[lane] = (GasPressureTable::pressurePa(gas, cycle) - GasPressureTable::kCrankcasePa) * kBoreArea;
+        }
+    }
+    computeCrankForcesBatch<Geometry>(x.angle.data(), x.omega.data(), x.gas.data(), points * cylinders,
+                                      {x.piston.data(), x.rod.data(), x.tangential.data(),
+                                       x.torque.data(), x.side.data()});
+
+    mAngleSamples.resize(points);
+    for (std::size_t p = 0; p < points; ++p) {
+        float engineTorque = 0.0f;
+        for (std::size_t c = 0; c < cylinders; ++c) engineTorque += x.torque[c * points + p];
+        protocol::AngleSample& s = mAngleSamples[p];
+        s.timeS = mAngleGrid->timeS()[p];
+        s.cycleAngleRad = gridAngle[p];
+        s.omegaRadS = gridOmega[p];
+        s.cylinderPressurePa = x.gas[p] / kBoreArea + GasPressureTable::kCrankcasePa;
+        s.pistonForceN = x.piston[p];
+        s.rodForceN = x.rod[p];
+        s.tangentialForceN = x.tangential[p];
+        s.torqueNm = x.torque[p];
+        s.sideThrustN = x.side[p];
+        s.engineTorqueNm = engineTorque;
+    }
+}
+
+template <typename Geometry, typename Phase>
+void BasicPhysicsEngine<Geometry, Phase>::queryForces(float load, std::span<const protocol::ForcePoint> points,
+                                                      std::span<protocol::ForceSample> out) const {
+    // Stack scratch for one batched call, so any thread can query.
+    constexpr std::size_t kLanes = 512;
+    using Lanes = std::array<float, kLanes>;
+    Lanes angle, omega, gas, piston, rod, tangential, torque, side;
+
+    const GasPressureTable& table = GasPressureTable::instance<Geometry>();
+    const std::size_t cylinders = mLayout.cylinders();
+    const std::size_t perBatch = kLanes / cylinders;
+    const std::size_t count = std::min(points.size(), out.size());
+    const float* phase = mLayout.phaseRad().data();
+    constexpr float kCycleRad = EngineLayout::kCycleRad;
+    load = std::clamp(load, 0.0f, 1.0f);
+
+    for (std::size_t first = 0; first < count; first += perBatch) {
+        const std::size_t n = std::min(perBatch, count - first);
+
+        // Cylinder-major lanes, as in evaluateAngleGrid().
+        for (std::size_t p = 0; p < n; ++p) {
+            const protocol::ForcePoint& q = points[first + p];
+            const GasPressureTable::Slice slice = table.slice(load, q.rpm);
+            float base = std::fmod(q.cycleAngleRad, kCycleRad);
+            if (base < 0.0f) base += kCycleRad;
+            for (std::size_t c = 0; c < cylinders; ++c) {
+                const std::size_t lane = c * n + p;
+                float cycle = base - phase[c];
+                if (cycle < 0.0f) cycle += kCycleRad;
+                angle[lane] = cycle;
+                omega[lane] = q.rpm * kTwoPi / 60.0f;
+                gas[lane] = (GasPressureTable::pressurePa(slice, cycle) - GasPressureTable::kCrankcasePa) * kBoreArea;
+            }
+        }
+        computeCrankForcesBatch<Geometry>(angle.data(), omega.data(), gas.data(), n * cylinders,
+                                          {piston.data(), rod.data(), tangential.data(), torque.data(), side.data()});
+
+        for (std::size_t p = 0; p < n; ++p) {
+            float engineTorque = 0.0f;
+            for (std::size_t c = 0; c < cylinders; ++c) engineTorque += torque[c * n + p];
+            protocol::ForceSample& s = out[first + p];
+            s.rpm = points[first + p].rpm;
+            s.cycleAngleRad = angle[p];
+            s.cylinderPressurePa = gas[p] / kBoreArea + GasPressureTable::kCrankcasePa;
+            s.pistonForceN = piston[p];
+            s.rodForceN = rod[p];
+            s.tangentialForceN = tangential[p];
+            s.torqueNm = torque[p];
+            s.sideThrustN = side[p];
+            s.engineTorqueNm = engineTorque;
+        }
+    }
+}
+
+#define TWIN_INSTANTIATE_ENGINE(G)                        \
+    template class BasicPhysicsEngine<G, FloatPhase>;     \
+    template class BasicPhysicsEngine<G, DoublePhase>;    \
+    template class BasicPhysicsEngine<G, FixedPhase>;
+
+TWIN_INSTANTIATE_ENGINE(DefaultGeometry)
+TWIN_INSTANTIATE_ENGINE(CompactGeometry)
+TWIN_INSTANTIATE_ENGINE(HeavyDutyGeometry)
+
+#undef TWIN_INSTANTIATE_ENGINE
@@ -3,49 +3,351 @@
 #include <cstdint>
 #include <cmath>
 #include <algorithm>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
 #include <thread>
+#include "AngleGrid.h"
+#include "BurstCapture.h"
+#include "Checkpoint.h"
+#include "CrankChain.h"
+#include "CrankDynamics.h"
+#include "CrankPhase.h"
+#include "EngineLayout.h"
+#include "GasPressure.h"
+#include "Geometry.h"
+#include "OrderTracker.h"
 #include "Protocol.h"
+#include "Rainflow.h"
+#include "RevolutionStats.h"
 #include "RingBuffer.h"
+#include "StateEstimator.h"
+#include "TorsionalModel.h"
+#include "WebStress.h"
 
-class PhysicsEngine {
-public:
-    // Rotating assembly (centrifugal stress model)
-    static constexpr float kMass        = 2.5f;
-    static constexpr float kRadius      = 0.08f;
-    static constexpr float kArea        = 0.0004f;
+using CrankForces = BasicCrankForces<float>;
 
-    // Crank-slider mechanism
-    static constexpr float kCrankThrow    = 0.04f;    // 40 mm throw → 80 mm stroke
-    static constexpr float kConRodLength  = 0.128f;   // 128 mm connecting rod
-    static constexpr float kPistonMass    = 0.4f;     // 400 g piston + wrist pin
-    static constexpr float kLambda        = kCrankThrow / kConRodLength;
+// Signals counted for fatigue: centrifugal stress, and cylinder 1's rod force
+// and torque.
+enum class FatigueSignal : uint8_t { StressPa, RodForceN, TorqueNm };
+inline constexpr std::size_t kFatigueSignals = 3;
+inline constexpr std::array<const char*, kFatigueSignals> kFatigueSignalNames = {
+    "stress_pa", "rod_force_n", "torque_nm"};
 
+// Signals tracked by engine order: whole-engine torque and cylinder 1's side
+// thrust.
+enum class OrderSignal : uint8_t { EngineTorqueNm, SideThrustN };
+inline constexpr std::size_t kOrderSignals = 2;
+
+// ── Geometry-independent engine interface ──
+// Owns everything the server and tools touch without knowing the variant:
+// timing constants, the cross-thread RPM/load targets, history and the
+// published snapshot. step() is the only virtual call per tick; everything
+// inside it is specialized per geometry in BasicPhysicsEngine.
+class TwinEngine {
+public:
     static constexpr float kTau         = 0.35f;
     static constexpr float kRpmMin      = 0.0f;
     static constexpr float kRpmMax      = 8000.0f;
     static constexpr float kDefaultRpm  = 1200.0f;
+    static constexpr float kDefaultLoad = 0.0f;   // throttle fraction 0…1
     static constexpr float kTwoPi       = 2.0f * 3.14159265358979323846f;
-    static constexpr float kDt          = 0.01f; // 100 Hz
+    static constexpr float kDt          = 0.01f; // 100 Hz broadcast tick
     static constexpr std::size_t kHistorySize = 1000; // 10s at 100Hz
+    static constexpr std::size_t kRevolutionHistorySize = 1024;
+
+    // Internal integration rate; step() runs rate·kDt substeps per tick.
+    static constexpr float kMinPhysicsRateHz     = 1000.0f;
+    static constexpr float kMaxPhysicsRateHz     = 50000.0f;
+    static constexpr float kDefaultPhysicsRateHz = 10000.0f;
+
+    virtual ~TwinEngine() = default;
 
-    PhysicsEngine();
+    TwinEngine(const TwinEngine&) = delete;
+    TwinEngine& operator=(const TwinEngine&) = delete;
+
+    [[nodiscard]] virtual std::string_view variant() const = 0;
+    // Number format of the crank phase accumulator (CrankPhase.h).
+    [[nodiscard]] virtual std::string_view phaseFormat() const = 0;
+    [[nodiscard]] virtual const TorsionalModel& torsion() const = 0;
+
+    [[nodiscard]] unsigned substepsPerTick() const { return mSubsteps; }
+    [[nodiscard]] float physicsRateHz() const { return 1.0f / mSubstepDt; }
+    [[nodiscard]] const EngineLayout& layout() const { return mLayout; }
 
     void setRpmTarget(float target);
     [[nodiscard]] float rpmTarget() const;
 
-    void step();
+    void setLoad(float load);
+    [[nodiscard]] float load() const;
+
+    virtual void step() = 0;
 
     [[nodiscard]] protocol::StatePayload snapshot() const;
 
+    // ── Checkpoints (Checkpoint.h) ──
+    // The complete twin state as one unsealed checkpoint in `out` (cleared):
+    // crank phase and speed, targets, crank dynamics, torsion, rainflow
+    // counts and whether counting is on, revolution tracking, the
+    // published snapshot and both histories. Call from the stepping thread between steps; nothing
+    // allocates once `out` has room.
+    void saveCheckpoint(std::vector<uint8_t>& out) const;
+
+    // Replaces the state with a checkpoint of this variant, phase format,
+    // substep count and layout. The whole checkpoint is decoded into a
+    // scratch twin first, so on false this one is untouched. The estimator
+    // and order trackers restart from the restored state; the other extras
+    // hold no state between ticks. Call from the stepping thread. Only an
+    // in-memory checkpoint straight from saveCheckpoint() may pass
+    // requireSealed = false; anything read from disk must be sealed.
+    bool restoreCheckpoint(std::span<const uint8_t> checkpoint, std::string* error = nullptr,
+                           bool requireSealed = true);
+
+    // A new twin of this type with this one's checkpointed state, for
+    // what-if runs, or nullptr if that state does not decode. Extras are
+    // not copied. Call from the stepping thread.
+    [[nodiscard]] virtual std::unique_ptr<TwinEngine> fork() const = 0;
+
+    // ── Force queries ──
+    // The force chain at arbitrary operating points, without stepping. Each
+    // point puts cylinder 1 at cycleAngleRad (from its firing TDC, wrapped
+    // into 0…4π) turning steadily at rpm, and the other cylinders at their
+    // phases from it. Gas force comes from the geometry's pressure table at
+    // the point's rpm and `load`. Every cylinder of a run of points goes
+    // through one computeCrankForcesBatch() call. Fills
+    // min(points.size(), out.size()) samples; reads only constants, so any
+    // thread, and nothing allocates.
+    virtual void queryForces(float load, std::span<const protocol::ForcePoint> points,
+                             std::span<protocol::ForceSample> out) const = 0;
+
+    // Filter (default) or torque-driven crank speed. Switching keeps the
+    // current speed, or starts a stopped crank at the RPM target; call from
+    // the stepping thread.
+    void setDynamics(SpeedModel model, const LoadModel& load = {});
+    [[nodiscard]] SpeedModel speedModel() const { return mSpeedModel; }
+
+    // Rotating inertia about the crank axis: pulley, throws, flywheel and the
+    // mean reciprocating share ½·m·R² per cylinder.
+    [[nodiscard]] float crankInertiaKgM2() const { return mDynamics.inertiaKgM2(); }
+
+    // Reconstructs cylinder 1's crank-web stress field from this basis at the
+    // end of every tick. Set it before stepping starts; nullptr detaches.
+    void setStressBasis(std::shared_ptr<const StressBasis> basis);
+    [[nodiscard]] const StressField* webStress() const { return mWebStress ? &*mWebStress : nullptr; }
+
+    // Data assimilation: seeds an extended Kalman filter from the current
+    // state. After each step(), assimilate() fuses the sensor samples taken
+    // during that tick (timeS from its start) and moves the crank angle, speed
+    // and throttle to the posterior; the next tick starts from there. The twin
+    // runs the filter's own model in between: torque dynamics with the
+    // estimated load torque in place of the load model.
+    void enableEstimator(const EstimatorConfig& config = {});
+    void disableEstimator();
+    void assimilate(std::span<const SensorSample> samples);
+    [[nodiscard]] const CrankEstimator* estimator() const { return mEstimator ? &*mEstimator : nullptr; }
+
+    // Rainflow counts of each fatigue signal over every substep since
+    // enableRainflow() or resetRainflow(). Off until enabled; call from the
+    // stepping thread. rainflow() is nullptr while off.
+    void enableRainflow();
+    void disableRainflow() { mRainflowOn = false; }
+    [[nodiscard]] const RainflowCounter* rainflow(FatigueSignal signal) const {
+        if (!mRainflowOn) return nullptr;
+        return &mRainflow[static_cast<std::size_t>(signal)];
+    }
+    void resetRainflow();
+
+    // Engine-order analysis of each OrderSignal, fed every substep and
+    // resampled in crank angle (OrderTracker.h). Off until enabled; call from
+    // the stepping thread. orders() is nullptr while off.
+    static constexpr std::array<float, 8> kDefaultOrders = {0.5f, 1.0f, 1.5f, 2.0f, 3.0f, 4.0f, 6.0f, 8.0f};
+    void enableOrders(std::span<const float> orders = kDefaultOrders);
+    void disableOrders() { mOrders.clear(); }
+    [[nodiscard]] const OrderTracker* orders(OrderSignal signal) const {
+        if (mOrders.empty()) return nullptr;
+        return &mOrders[static_cast<std::size_t>(signal)];
+    }
+    [[nodiscard]] protocol::OrdersPayload ordersSnapshot() const;
+
+    // Crank-angle output: each tick, the force chain evaluated at exactly
+    // the grid angles (every stepRad of cylinder 1's cycle) the crank passed
+    // in that tick, oldest first. Off until enabled; call from the stepping
+    // thread. angleSamples() is empty while off.
+    void enableAngleGrid(float stepRad);
+    void disableAngleGrid();
+    [[nodiscard]] const CrankAngleGrid* angleGrid() const { return mAngleGrid ? &*mAngleGrid : nullptr; }
+    [[nodiscard]] std::span<const protocol::AngleSample> angleSamples() const { return mAngleSamples; }
+
+    // Triggered burst capture at the substep rate (BurstCapture.h), with
+    // room for `capacity` samples per capture. Enable before stepping
+    // starts; arming and reading captures are then safe from one other
+    // thread. capture() is nullptr while off.
+    void enableCapture(std::size_t capacity = BurstCapture::kDefaultCapacity);
+    [[nodiscard]] BurstCapture* capture() { return mCapture ? mCapture.get() : nullptr; }
+    [[nodiscard]] const BurstCapture* capture() const { return mCapture ? mCapture.get() : nullptr; }
+
     using History = RingBuffer<protocol::StatePayload, kHistorySize>;
     [[nodiscard]] const History& history() const { return mHistory; }
 
+    // One summary per completed crank revolution (RevolutionStats.h), and how
+    // many have completed in all; the newest revolutions() - n records are
+    // the ones since an earlier count n. Read from the stepping thread.
+    using RevolutionHistory = RingBuffer<protocol::RevolutionPayload, kRevolutionHistorySize>;
+    [[nodiscard]] const RevolutionHistory& revolutionHistory() const { return mRevolutionHistory; }
+    [[nodiscard]] uint64_t revolutions() const { return mRevolutions.revolutions(); }
+
+    // RPM filter gain for a step of length dt: 1 - exp(-dt / tau)
+    static float rpmFilterAlpha(float dt = kDt) { return 1.0f - std::exp(-dt / kTau); }
+
+protected:
+    TwinEngine(float physicsRateHz, const EngineLayout& layout, float crankInertiaKgM2);
+
+    // Appends to history and makes the state visible to snapshot().
+    void publish(const protocol::StatePayload& state);
+
+    // Estimator hooks: the variant's process model, its state as an estimate,
+    // and writing a posterior back.
+    [[nodiscard]] virtual EstimatorModel estimatorModel() const = 0;
+    [[nodiscard]] virtual CrankEstimate currentEstimate() const = 0;
+    virtual void applyEstimate(const CrankEstimate& estimate) = 0;
+
+    // Checkpoint body in both directions; see saveCheckpoint(). readState()
+    // is all-or-nothing.
+    virtual void writeState(CheckpointOut& io) const = 0;
+    virtual bool readState(std::span<const uint8_t> body) = 0;
+
+    // The part of the body held here, visited by the variants' own visit.
+    template <typename Self, typename Io>
+    static void visitTwin(Self& self, Io& io);
+
+    unsigned mSubsteps;
+    float mSubstepDt;
+    float mSubstepAlpha;
+    EngineLayout mLayout;
+
+    History mHistory;
+    RevolutionAggregator mRevolutions;
+    RevolutionHistory mRevolutionHistory;
+    std::optional<StressField> mWebStress;
+    std::optional<CrankEstimator> mEstimator;
+    std::array<RainflowCounter, kFatigueSignals> mRainflow;   // bins sized at construction
+    bool mRainflowOn = false;
+    std::vector<OrderTracker> mOrders;   // kOrderSignals when enabled
+
+    // Angle grid and this tick's samples; the scratch holds every cylinder
+    // at every grid point for one batched kernel call.
+    std::optional<CrankAngleGrid> mAngleGrid;
+    std::vector<protocol::AngleSample> mAngleSamples;
+    struct AngleScratch {
+        std::vector<float> angle, omega, gas, piston, rod, tangential, torque, side;
+    } mAngleScratch;
+
+    std::unique_ptr<BurstCapture> mCapture;
+
+    SpeedModel mSpeedModel = SpeedModel::Filter;
+    CrankDynamics mDynamics;
+
+    std::atomic<protocol::StatePayload> mLatestSnapshot{};
+    std::atomic<float> mAtomicRpmTarget{kDefaultRpm};
+    std::atomic<float> mAtomicLoad{kDefaultLoad};
+    std::atomic<float> mAtomicCycleAngleRad{0.0f};   // published with the snapshot
+};
+
+// ── Crank-slider twin specialized on a geometry policy (see Geometry.h) ──
+// Phase is the crank angle's number format (CrankPhase.h). The rest of the
+// state and the force chain stay float in every variant.
+template <typename Geometry, typename Phase = FloatPhase>
+class BasicPhysicsEngine final : public TwinEngine {
+public:
+    using GeometryType = Geometry;
+    using PhaseType = Phase;
+
+    // Rotating assembly (centrifugal stress model)
+    static constexpr float kMass        = Geometry::kMass;
+    static constexpr float kRadius      = Geometry::kRadius;
+    static constexpr float kArea        = Geometry::kArea;
+
+    // Crank-slider mechanism
+    static constexpr float kCrankThrow    = Geometry::kCrankThrow;
+    static constexpr float kConRodLength  = Geometry::kConRodLength;
+    static constexpr float kPistonMass    = Geometry::kPistonMass;
+    static constexpr float kLambda        = kCrankThrow / kConRodLength;
+
+    // Combustion chamber
+    static constexpr float kBore             = Geometry::kBore;
+    static constexpr float kBoreArea         = 0.25f * 3.14159265358979323846f * kBore * kBore;
+    static constexpr float kCompressionRatio = Geometry::kCompressionRatio;
+
+    explicit BasicPhysicsEngine(float physicsRateHz = kDefaultPhysicsRateHz,
+                                const EngineLayout& layout = EngineLayout::singleCylinder());
+
+    [[nodiscard]] std::string_view variant() const override { return Geometry::kName; }
+    [[nodiscard]] std::string_view phaseFormat() const override { return Phase::kName; }
+    [[nodiscard]] const TorsionalModel& torsion() const override { return mTorsion; }
+
+    void step() override;
+    [[nodiscard]] std::unique_ptr<TwinEngine> fork() const override;
+    void queryForces(float load, std::span<const protocol::ForcePoint> points,
+                     std::span<protocol::ForceSample> out) const override;
+
     static float computeStressMaxPa();
+    static float computeCrankInertia(const EngineLayout& layout);
+
+    // Rainflow bins covering everything the signal can reach up to kRpmMax:
+    // for the forces, gas peak plus the inertia swing (withGas = false for
+    // the gas-free EngineFleet).
+    static RainflowSpec rainflowSpec(FatigueSignal signal, bool withGas = true);
+
+    // Crank-slider dynamics. Stateless so that EngineFleet and offline tools
+    // share the exact math. Positive piston force loads the rod in compression;
+    // gasForceN = (p_cyl - p_crankcase)·A_bore adds to the inertial term.
+    // The chain is crankForceChain() (CrankChain.h) on this policy's constants.
+    static CrankForces computeCrankForces(float angleRad, float omegaRadS, float gasForceN = 0.0f) {
+        return crankForceChain<float>(kCrankThrow, kConRodLength, kPistonMass,
+                                      angleRad, omegaRadS, gasForceN);
+    }
 
 private:
+    [[nodiscard]] EstimatorModel estimatorModel() const override;
+    [[nodiscard]] CrankEstimate currentEstimate() const override;
+    void applyEstimate(const CrankEstimate& estimate) override;
+
+    void writeState(CheckpointOut& io) const override;
+    bool readState(std::span<const uint8_t> body) override;
+    bool decode(std::span<const uint8_t> body);
+    template <typename Self, typename Io>
+    static void visitState(Self& self, Io& io);
+
+    void evaluateAngleGrid(const GasPressureTable::Slice& gas);
+
+    // Per-cylinder scratch for the batched force evaluation; sized for the
+    // largest layout so the substep loop never allocates.
+    using CylinderArray = std::array<float, EngineLayout::kMaxCylinders>;
+    CylinderArray mCylAngleRad{};
+    CylinderArray mCylOmegaRadS{};
+    CylinderArray mCylGasForceN{};
+    CylinderArray mCylPistonForceN{};
+    CylinderArray mCylRodForceN{};
+    CylinderArray mCylTangentialForceN{};
+    CylinderArray mCylTorqueNm{};
+    CylinderArray mCylSideThrustN{};
+    CylinderArray mThrowTorqueNm{};
+    CylinderArray mBoreAxisSin{};
+    CylinderArray mBoreAxisCos{};
+
+    // Crankshaft twist, driven by the per-throw torque every substep.
+    TorsionalModel mTorsion;
+
     float mRpm              = 0.0f;
     float mRpmTarget        = kDefaultRpm;
+    // Accumulated crank phase, and its float readouts for the substep.
+    Phase mPhase;
     float mAngleRad         = 0.0f;
+    float mCycleAngleRad    = 0.0f;   // 0…4π, four-stroke cycle of cylinder 1
+    float mLoad             = kDefaultLoad;
+    float mCylinderPressurePa = 0.0f;
     float mOmegaRadS        = 0.0f;
     float mStressPa         = 0.0f;
     float mStressFactor     = 0.0f;
@@ -58,8 +360,11 @@ private:
     float mTorqueNm         = 0.0f;
     float mSideThrustN      = 0.0f;
 
-    History mHistory;
-
-    std::atomic<protocol::StatePayload> mLatestSnapshot{};
-    std::atomic<float> mAtomicRpmTarget{kDefaultRpm};
+    // Whole-engine outputs summed over all cylinders
+    float mEngineTorqueNm   = 0.0f;
+    float mShakingForceXN   = 0.0f;
+    float mShakingForceYN   = 0.0f;
 };
+
+// The geometry the server runs by default; most tools use this alias.
+using PhysicsEngine = BasicPhysicsEngine<DefaultGeometry>;
@@ -1,13 +1,40 @@
 #pragma once
+#include <algorithm>
 #include <cstdint>
 #include <array>
+#include <bit>
+#include <cmath>
 #include <cstdio>
+#include <cstring>
+#include <span>
 #include <string_view>
 #include <optional>
+#include <vector>
 #include <nlohmann/json.hpp>
 
 namespace protocol {
 
+// Outbound messages are serialized into fixed buffers of this size.
+inline constexpr std::size_t kMaxMessageSize = 2048;
+
+// Crankshaft journal sections: pulley, up to 16 throws, flywheel.
+inline constexpr std::size_t kMaxShaftSections = 17;
+
+// Engine orders carried by one "orders" message.
+inline constexpr std::size_t kMaxOrders = 16;
+
+// Revolution summaries carried by one "revolutions" message.
+inline constexpr std::size_t kMaxRevolutionsPerMessage = 8;
+
+using MessageBuffer = std::array<char, kMaxMessageSize>;
+
+// Spread of one force over the physics substeps of a broadcast tick.
+struct ForceStats {
+    float min = 0.0f;
+    float max = 0.0f;
+    float mean = 0.0f;
+};
+
 struct StatePayload {
     float rpm = 0.0f;
     float angleRad = 0.0f;
@@ -19,27 +46,184 @@ struct StatePayload {
     float torqueNm = 0.0f;
     float sideThrustN = 0.0f;
     uint64_t timestampMs = 0;
+
+    // Throttle fraction and cylinder 1 absolute in-cylinder pressure
+    float load = 0.0f;
+    float cylinderPressurePa = 0.0f;
+
+    // Whole-engine outputs summed over all cylinders; the force fields above
+    // are cylinder 1. Shaking force is x lateral, y along cylinder 1's bore.
+    float engineTorqueNm = 0.0f;
+    float shakingForceXN = 0.0f;
+    float shakingForceYN = 0.0f;
+
+    // Per-tick min/max/mean over all substeps; the scalar fields above are
+    // the decimated (end-of-tick) values.
+    ForceStats pistonForceStats;
+    ForceStats rodForceStats;
+    ForceStats tangentialForceStats;
+    ForceStats torqueStats;
+    ForceStats sideThrustStats;
+    ForceStats engineTorqueStats;
+
+    // Crank speed spread over the tick (the cyclic fluctuation under torque
+    // dynamics) and the load model's torque at the end of the tick.
+    ForceStats rpmStats;
+    float loadTorqueNm = 0.0f;
+
+    // Crankshaft torsion per journal section, pulley end first: twist and
+    // elastic shear stress at the end of the tick, and the largest |shear|
+    // any section reached during the tick's substeps.
+    uint8_t shaftSections = 0;
+    std::array<float, kMaxShaftSections> twistRad{};
+    std::array<float, kMaxShaftSections> shearStressPa{};
+    float maxShearStressPa = 0.0f;
+
+    // Crank-web stress field of cylinder 1 (WebStress.h): peak von Mises
+    // stress and the mesh node where it sits. -1 when no basis is loaded.
+    float webStressMaxPa = 0.0f;
+    int32_t webHotspotNode = -1;
+};
+
+// Amplitude and phase of each tracked engine order over the last four-stroke
+// cycle (OrderTracker.h): x(φ) ≈ Σ amplitude·cos(order·φ + phase), φ the
+// cycle angle from cylinder 1's firing TDC. Whole-engine torque and
+// cylinder 1's side thrust.
+struct OrdersPayload {
+    uint64_t timestampMs = 0;
+    float rpm = 0.0f;
+    bool ready = false;   // a full cycle has been resampled
+    uint8_t count = 0;
+    std::array<float, kMaxOrders> order{};
+    std::array<float, kMaxOrders> torqueAmplitudeNm{};
+    std::array<float, kMaxOrders> torquePhaseRad{};
+    std::array<float, kMaxOrders> sideThrustAmplitudeN{};
+    std::array<float, kMaxOrders> sideThrustPhaseRad{};
+};
+
+// Aggregates over one crank revolution (RevolutionStats.h). Torque is the
+// whole engine; rod force and side thrust are cylinder 1.
+struct RevolutionPayload {
+    uint64_t index = 0;          // revolutions completed before this one
+    uint64_t timestampMs = 0;    // end of the tick it completed in
+    float durationS = 0.0f;
+    float rpm = 0.0f;            // 60 / duration
+    float torqueMeanNm = 0.0f;
+    float torqueRmsNm = 0.0f;
+    float torquePeakNm = 0.0f;
+    float rodForceMaxN = 0.0f;   // peak compression
+    float sideThrustMaxN = 0.0f; // peak |side thrust|
 };
 
 struct SetRpmPayload {
     float rpmTarget = 0.0f;
 };
 
+struct SetLoadPayload {
+    float load = 0.0f;
+};
+
 struct ReplayPayload {
     std::string mode;  // "live", "freeze", "seek"
     uint64_t tMs = 0;
 };
 
+// Sandbox twin to open (SandboxPool.h): a fork of the live twin's
+// checkpointed state, or a fresh engine.
+struct SandboxCreatePayload {
+    bool fromLive = true;
+};
+
+// Reply to sandbox_create / sandbox_close. status is "open", "closed",
+// "full" (no room in the pool), "failed" (the live twin's checkpoint did not
+// restore) or "disabled" (server runs without one).
+struct SandboxInfo {
+    std::string_view status;
+    uint64_t id = 0;
+    unsigned worker = 0;
+    bool fromLive = true;
+};
+
+// Outbound streams. A new session gets "state" only; the others are opted
+// into, and "state" can be dropped for the summaries.
+enum class Topic : uint8_t { State, Orders, Revolutions, Angle, Capture };
+inline constexpr std::size_t kTopics = 5;
+
+inline std::optional<Topic> topicFromName(std::string_view name) {
+    if (name == "state") return Topic::State;
+    if (name == "orders") return Topic::Orders;
+    if (name == "revolutions") return Topic::Revolutions;
+    if (name == "angle") return Topic::Angle;
+    if (name == "capture") return Topic::Capture;
+    return std::nullopt;
+}
+
+struct SubscribePayload {
+    Topic topic = Topic::State;
+};
+
+// ── Burst capture triggers (BurstCapture.h) ──
+// Signals a trigger can watch, in CaptureSample field order after the
+// angle and speed. Forces are cylinder 1; stress is the centrifugal stress
+// and shear the largest torsional shear over the journal sections.
+enum class CaptureSignal : uint8_t {
+    CylinderPressurePa, PistonForceN, RodForceN, TangentialForceN, TorqueNm,
+    SideThrustN, EngineTorqueNm, StressPa, ShearStressPa
+};
+inline constexpr std::array<std::string_view, 9> kCaptureSignalNames = {
+    "cylinder_pressure", "piston_force", "rod_force", "tangential_force", "torque",
+    "side_thrust", "engine_torque", "stress", "shear_stress"};
+
+inline std::optional<CaptureSignal> captureSignalFromName(std::string_view name) {
+    for (std::size_t k = 0; k < kCaptureSignalNames.size(); ++k) {
+        if (name == kCaptureSignalNames[k]) return static_cast<CaptureSignal>(k);
+    }
+    return std::nullopt;
+}
+
+// level: the signal crosses `threshold` in the edge's direction.
+// slope: its rate of change (units per second) crosses `threshold`, rising
+//   meaning faster increase and falling faster decrease.
+// rpm_band: the crank speed enters [rpm_min, rpm_max]; edge is ignored.
+// The band also gates level and slope triggers. pre_samples substeps before
+// the trigger and post_samples from it on are kept (1000 each by default,
+// 0.1 s at 10 kHz); rearm keeps capturing after each one, otherwise the
+// trigger fires once.
+struct CaptureTrigger {
+    enum class Kind : uint8_t { Level, Slope, RpmBand };
+    enum class Edge : uint8_t { Rising, Falling, Either };
+
+    Kind kind = Kind::Level;
+    Edge edge = Edge::Rising;
+    CaptureSignal signal = CaptureSignal::StressPa;
+    float threshold = 0.0f;
+    float rpmMin = 0.0f;
+    float rpmMax = 1e9f;
+    uint32_t preSamples = 1000;
+    uint32_t postSamples = 1000;
+    bool rearm = false;
+};
+
 // ── Zero-copy-ish serialization into a pre-allocated buffer ──
-// Returns the number of chars written (excluding null terminator).
-inline std::size_t serializeState(const StatePayload& s, std::array<char, 512>& buf) {
+// Returns the number of chars written (excluding null terminator). A
+// sandbox's stream uses the same payload under type "sandbox_state".
+inline std::size_t serializeState(const StatePayload& s, MessageBuffer& buf, const char* type = "state") {
+    auto d = [](float v) { return static_cast<double>(v); };
     int n = std::snprintf(
         buf.data(), buf.size(),
-        R"({"type":"state","payload":{)"
+        R"({"type":"%s","payload":{)"
         R"("rpm":%.2f,"angle_rad":%.6f,"stress_pa":%.2f,"stress_factor":%.6f,)"
         R"("piston_force_n":%.2f,"rod_force_n":%.2f,"tangential_force_n":%.2f,)"
         R"("torque_nm":%.4f,"side_thrust_n":%.2f,)"
-        R"("timestamp_ms":%llu}})",
+        R"("timestamp_ms":%llu,)"
+        R"("load":%.3f,"cylinder_pressure_pa":%.0f,)"
+        R"("engine_torque_nm":%.4f,"shaking_force_n":[%.2f,%.2f],)"
+        R"("rpm_stats":[%.2f,%.2f,%.2f],"load_torque_nm":%.3f,)"
+        R"("force_stats":{)"
+        R"("piston_force_n":[%.2f,%.2f,%.2f],"rod_force_n":[%.2f,%.2f,%.2f],)"
+        R"("tangential_force_n":[%.2f,%.2f,%.2f],"torque_nm":[%.4f,%.4f,%.4f],)"
+        R"("side_thrust_n":[%.2f,%.2f,%.2f],"engine_torque_nm":[%.4f,%.4f,%.4f]},)",
+        type,
         static_cast<double>(s.rpm),
         static_cast<double>(s.angleRad),
         static_cast<double>(s.stressPa),
@@ -49,24 +233,442 @@ inline std::size_t serializeState(const StatePayload& s, std::array<char, 512>&
         static_cast<double>(s.tangentialForceN),
         static_cast<double>(s.torqueNm),
         static_cast<double>(s.sideThrustN),
-        static_cast<unsigned long long>(s.timestampMs)
+        static_cast<unsigned long long>(s.timestampMs),
+        d(s.load), d(s.cylinderPressurePa),
+        d(s.engineTorqueNm), d(s.shakingForceXN), d(s.shakingForceYN),
+        d(s.rpmStats.min), d(s.rpmStats.max), d(s.rpmStats.mean), d(s.loadTorqueNm),
+        d(s.pistonForceStats.min), d(s.pistonForceStats.max), d(s.pistonForceStats.mean),
+        d(s.rodForceStats.min), d(s.rodForceStats.max), d(s.rodForceStats.mean),
+        d(s.tangentialForceStats.min), d(s.tangentialForceStats.max), d(s.tangentialForceStats.mean),
+        d(s.torqueStats.min), d(s.torqueStats.max), d(s.torqueStats.mean),
+        d(s.sideThrustStats.min), d(s.sideThrustStats.max), d(s.sideThrustStats.mean),
+        d(s.engineTorqueStats.min), d(s.engineTorqueStats.max), d(s.engineTorqueStats.mean)
     );
-    return (n > 0 && static_cast<std::size_t>(n) < buf.size())
-        ? static_cast<std::size_t>(n)
-        : 0;
+    if (n <= 0 || static_cast<std::size_t>(n) >= buf.size()) return 0;
+
+    // Variable-length tail: torsion arrays sized by the layout. Any overflow
+    // pushes len to buf.size() and the message is dropped like above.
+    std::size_t len = static_cast<std::size_t>(n);
+    auto text = [&](std::string_view t) {
+        if (len + t.size() >= buf.size()) { len = buf.size(); return; }
+        std::memcpy(buf.data() + len, t.data(), t.size());
+        len += t.size();
+        buf[len] = '\0';
+    };
+    auto number = [&](double v, int precision, bool scientific) {
+        if (len >= buf.size()) return;
+        int m = std::snprintf(buf.data() + len, buf.size() - len,
+                              scientific ? "%.*e" : "%.*f", precision, v);
+        len = (m > 0 && len + static_cast<std::size_t>(m) < buf.size())
+            ? len + static_cast<std::size_t>(m) : buf.size();
+    };
+    auto array = [&](const std::array<float, kMaxShaftSections>& values, int precision,
+                     bool scientific) {
+        text("[");
+        for (std::size_t i = 0; i < s.shaftSections; ++i) {
+            if (i > 0) text(",");
+            number(d(values[i]), precision, scientific);
+        }
+        text("]");
+    };
+    text(R"("torsion":{"twist_rad":)");
+    array(s.twistRad, 4, true);
+    text(R"(,"shear_pa":)");
+    array(s.shearStressPa, 0, false);
+    text(R"(,"max_shear_pa":)");
+    number(d(s.maxShearStressPa), 0, false);
+    text("}");
+    if (s.webHotspotNode >= 0) {
+        text(R"(,"web_stress":{"max_pa":)");
+        number(d(s.webStressMaxPa), 0, false);
+        text(R"(,"hotspot_node":)");
+        number(static_cast<double>(s.webHotspotNode), 0, false);
+        text("}");
+    }
+    text("}}");
+
+    return len < buf.size() ? len : 0;
+}
+
+// {"type":"orders",...}; same buffer contract as serializeState().
+inline std::size_t serializeOrders(const OrdersPayload& o, MessageBuffer& buf) {
+    int n = std::snprintf(buf.data(), buf.size(),
+                          R"({"type":"orders","payload":{"timestamp_ms":%llu,"rpm":%.2f,"ready":%s,)",
+                          static_cast<unsigned long long>(o.timestampMs), static_cast<double>(o.rpm),
+                          o.ready ? "true" : "false");
+    if (n <= 0 || static_cast<std::size_t>(n) >= buf.size()) return 0;
+
+    std::size_t len = static_cast<std::size_t>(n);
+    auto text = [&](std::string_view t) {
+        if (len + t.size() >= buf.size()) { len = buf.size(); return; }
+        std::memcpy(buf.data() + len, t.data(), t.size());
+        len += t.size();
+        buf[len] = '\0';
+    };
+    auto array = [&](const std::array<float, kMaxOrders>& values, int precision) {
+        text("[");
+        for (std::size_t i = 0; i < o.count && len < buf.size(); ++i) {
+            if (i > 0) text(",");
+            if (len >= buf.size()) break;
+            int m = std::snprintf(buf.data() + len, buf.size() - len, "%.*f", precision,
+                                  static_cast<double>(values[i]));
+            len = (m > 0 && len + static_cast<std::size_t>(m) < buf.size())
+                ? len + static_cast<std::size_t>(m) : buf.size();
+        }
+        text("]");
+    };
+    text(R"("orders":)");
+    array(o.order, 1);
+    text(R"(,"torque_nm":{"amplitude":)");
+    array(o.torqueAmplitudeNm, 4);
+    text(R"(,"phase_rad":)");
+    array(o.torquePhaseRad, 4);
+    text(R"(},"side_thrust_n":{"amplitude":)");
+    array(o.sideThrustAmplitudeN, 2);
+    text(R"(,"phase_rad":)");
+    array(o.sideThrustPhaseRad, 4);
+    text("}}}");
+
+    return len < buf.size() ? len : 0;
+}
+
+// {"type":"revolutions","payload":[...]}, oldest first; at most
+// kMaxRevolutionsPerMessage records. Same buffer contract as serializeState().
+inline std::size_t serializeRevolutions(const RevolutionPayload* records, std::size_t count,
+                                        MessageBuffer& buf) {
+    count = std::min(count, kMaxRevolutionsPerMessage);
+    std::size_t len = 0;
+    auto text = [&](std::string_view t) {
+        if (len + t.size() >= buf.size()) { len = buf.size(); return; }
+        std::memcpy(buf.data() + len, t.data(), t.size());
+        len += t.size();
+        buf[len] = '\0';
+    };
+    text(R"({"type":"revolutions","payload":[)");
+    for (std::size_t i = 0; i < count && len < buf.size(); ++i) {
+        const RevolutionPayload& r = records[i];
+        int m = std::snprintf(
+            buf.data() + len, buf.size() - len,
+            R"(%s{"index":%llu,"timestamp_ms":%llu,"duration_s":%.6f,"rpm":%.2f,)"
+            R"("torque_nm":{"mean":%.4f,"rms":%.4f,"peak":%.4f},)"
+            R"("rod_force_max_n":%.2f,"side_thrust_max_n":%.2f})",
+            i == 0 ? "" : ",", static_cast<unsigned long long>(r.index),
+            static_cast<unsigned long long>(r.timestampMs), static_cast<double>(r.durationS),
+            static_cast<double>(r.rpm), static_cast<double>(r.torqueMeanNm),
+            static_cast<double>(r.torqueRmsNm), static_cast<double>(r.torquePeakNm),
+            static_cast<double>(r.rodForceMaxN), static_cast<double>(r.sideThrustMaxN));
+        len = (m > 0 && len + static_cast<std::size_t>(m) < buf.size())
+            ? len + static_cast<std::size_t>(m) : buf.size();
+    }
+    text("]}");
+
+    return len < buf.size() ? len : 0;
 }
 
-inline std::string_view stateView(const std::array<char, 512>& buf, std::size_t len) {
+inline std::string_view stateView(const MessageBuffer& buf, std::size_t len) {
     return { buf.data(), len };
 }
 
+// ── Binary sensor frames ──
+// Measurement data for the twin's estimator arrives as binary WebSocket
+// messages on connections that negotiate kSensorSubprotocol. One message is
+// a header and `count` fixed-size records, little-endian:
+//   header  u32 magic "TWSF", u16 version, u16 count
+//   record  u64 timestamp_ns, f32 value, u8 kind, u8 cylinder, u16 reserved
+// Timestamps are the sender's monotonic clock; kind follows
+// SensorSample::Kind (0 angle rad, 1 speed rad/s, 2 pressure Pa abs,
+// 3 rod strain) and cylinder is 0-based.
+inline constexpr std::string_view kSensorSubprotocol = "twin-sensors.v1";
+inline constexpr uint32_t kSensorFrameMagic   = 0x46535754;   // "TWSF"
+inline constexpr uint16_t kSensorFrameVersion = 1;
+inline constexpr std::size_t kSensorHeaderBytes = 8;
+inline constexpr std::size_t kSensorRecordBytes = 16;
+inline constexpr std::size_t kMaxSensorRecords  = 0xFFFF;
+static_assert(std::endian::native == std::endian::little, "sensor frames are decoded in place");
+
+struct SensorRecord {
+    uint64_t timestampNs = 0;
+    float value = 0.0f;
+    uint8_t kind = 0;
+    uint8_t cylinder = 0;
+};
+
+// Number of records in a well-formed frame, nullopt otherwise.
+inline std::optional<std::size_t> sensorFrameRecords(const uint8_t* data, std::size_t len) {
+    if (len < kSensorHeaderBytes) return std::nullopt;
+    uint32_t magic;
+    uint16_t version, count;
+    std::memcpy(&magic, data, 4);
+    std::memcpy(&version, data + 4, 2);
+    std::memcpy(&count, data + 6, 2);
+    if (magic != kSensorFrameMagic || version != kSensorFrameVersion) return std::nullopt;
+    if (len != kSensorHeaderBytes + count * kSensorRecordBytes) return std::nullopt;
+    return count;
+}
+
+// Record `index` of a frame sensorFrameRecords() accepted.
+inline SensorRecord sensorRecord(const uint8_t* data, std::size_t index) {
+    const uint8_t* at = data + kSensorHeaderBytes + index * kSensorRecordBytes;
+    SensorRecord r;
+    std::memcpy(&r.timestampNs, at, 8);
+    std::memcpy(&r.value, at + 8, 4);
+    r.kind = at[12];
+    r.cylinder = at[13];
+    return r;
+}
+
+// Writes a frame of up to kMaxSensorRecords records; `out` must hold
+// kSensorHeaderBytes + count·kSensorRecordBytes. Returns the bytes written.
+inline std::size_t encodeSensorFrame(const SensorRecord* records, std::size_t count, uint8_t* out) {
+    count = std::min(count, kMaxSensorRecords);
+    const auto count16 = static_cast<uint16_t>(count);
+    std::memcpy(out, &kSensorFrameMagic, 4);
+    std::memcpy(out + 4, &kSensorFrameVersion, 2);
+    std::memcpy(out + 6, &count16, 2);
+    for (std::size_t i = 0; i < count; ++i) {
+        uint8_t* at = out + kSensorHeaderBytes + i * kSensorRecordBytes;
+        std::memcpy(at, &records[i].timestampNs, 8);
+        std::memcpy(at + 8, &records[i].value, 4);
+        at[12] = records[i].kind;
+        at[13] = records[i].cylinder;
+        at[14] = 0;
+        at[15] = 0;
+    }
+    return kSensorHeaderBytes + count * kSensorRecordBytes;
+}
+
+// ── Crank-angle frames (binary) ──
+// Sessions subscribed to "angle" also receive one binary message per tick
+// with the force chain evaluated on a fixed crank-angle grid (AngleGrid.h),
+// little-endian:
+//   header  u32 magic "TWAF", u16 version, u16 count, u64 timestamp_ms
+//   record  f32 × 10 in AngleSample order
+// cycle_angle_rad is cylinder 1's four-stroke angle from its firing TDC;
+// time_s is from the start of the tick. Engine torque is all cylinders, the
+// other forces are cylinder 1.
+inline constexpr uint32_t kAngleFrameMagic   = 0x46415754;   // "TWAF"
+inline constexpr uint16_t kAngleFrameVersion = 1;
+inline constexpr std::size_t kAngleHeaderBytes = 16;
+inline constexpr std::size_t kAngleRecordBytes = 40;
+
+struct AngleSample {
+    float timeS = 0.0f;
+    float cycleAngleRad = 0.0f;
+    float omegaRadS = 0.0f;
+    float cylinderPressurePa = 0.0f;
+    float pistonForceN = 0.0f;
+    float rodForceN = 0.0f;
+    float tangentialForceN = 0.0f;
+    float torqueNm = 0.0f;
+    float sideThrustN = 0.0f;
+    float engineTorqueNm = 0.0f;
+};
+static_assert(sizeof(AngleSample) == kAngleRecordBytes, "angle records are copied as is");
+
+[[nodiscard]] inline constexpr std::size_t angleFrameBytes(std::size_t count) {
+    return kAngleHeaderBytes + std::min<std::size_t>(count, 0xFFFF) * kAngleRecordBytes;
+}
+
+// Writes up to 65535 samples; `out` must hold angleFrameBytes(count).
+// Returns the bytes written.
+inline std::size_t encodeAngleFrame(uint64_t timestampMs, const AngleSample* samples, std::size_t count,
+                                    uint8_t* out) {
+    count = std::min<std::size_t>(count, 0xFFFF);
+    const auto count16 = static_cast<uint16_t>(count);
+    std::memcpy(out, &kAngleFrameMagic, 4);
+    std::memcpy(out + 4, &kAngleFrameVersion, 2);
+    std::memcpy(out + 6, &count16, 2);
+    std::memcpy(out + 8, &timestampMs, 8);
+    if (count > 0) std::memcpy(out + kAngleHeaderBytes, samples, count * kAngleRecordBytes);
+    return angleFrameBytes(count);
+}
+
+// ── Force queries ──
+// {"type":"force_query","payload":{"load":0.8,"rpm":[..],"cycle_angle_rad":[..]}}
+// asks for the force chain at each (rpm, cycle angle) pair without stepping
+// (TwinEngine::queryForces). The reply is one binary message, little-endian:
+//   header  u32 magic "TWFQ", u16 version, u16 count, f32 load
+//   record  f32 × 9 in ForceSample order, one per point, in request order
+// cycle_angle_rad is cylinder 1's four-stroke angle from its firing TDC.
+// Engine torque is all cylinders, the other forces are cylinder 1.
+inline constexpr uint32_t kForceFrameMagic   = 0x51465754;   // "TWFQ"
+inline constexpr uint16_t kForceFrameVersion = 1;
+inline constexpr std::size_t kForceHeaderBytes = 12;
+inline constexpr std::size_t kForceRecordBytes = 36;
+inline constexpr std::size_t kMaxForcePoints   = 4096;
+
+struct ForcePoint {
+    float rpm = 0.0f;
+    float cycleAngleRad = 0.0f;
+};
+
+struct ForceQueryPayload {
+    float load = 0.0f;
+    std::vector<ForcePoint> points;
+};
+
+struct ForceSample {
+    float rpm = 0.0f;
+    float cycleAngleRad = 0.0f;
+    float cylinderPressurePa = 0.0f;
+    float pistonForceN = 0.0f;
+    float rodForceN = 0.0f;
+    float tangentialForceN = 0.0f;
+    float torqueNm = 0.0f;
+    float sideThrustN = 0.0f;
+    float engineTorqueNm = 0.0f;
+};
+static_assert(sizeof(ForceSample) == kForceRecordBytes, "force records are copied as is");
+
+[[nodiscard]] inline constexpr std::size_t forceFrameBytes(std::size_t count) {
+    return kForceHeaderBytes + std::min(count, kMaxForcePoints) * kForceRecordBytes;
+}
+
+// Writes up to kMaxForcePoints samples; `out` must hold forceFrameBytes(count).
+// Returns the bytes written.
+inline std::size_t encodeForceFrame(float load, const ForceSample* samples, std::size_t count, uint8_t* out) {
+    count = std::min(count, kMaxForcePoints);
+    const auto count16 = static_cast<uint16_t>(count);
+    std::memcpy(out, &kForceFrameMagic, 4);
+    std::memcpy(out + 4, &kForceFrameVersion, 2);
+    std::memcpy(out + 6, &count16, 2);
+    std::memcpy(out + 8, &load, 4);
+    if (count > 0) std::memcpy(out + kForceHeaderBytes, samples, count * kForceRecordBytes);
+    return forceFrameBytes(count);
+}
+
+// ── Burst captures ──
+// A completed capture is announced to "capture" subscribers as
+//   {"type":"capture","payload":{"sequence":..,"timestamp_ms":..,...}}
+// and fetched with {"type":"capture_get","payload":{"sequence":N}} (0 or no
+// payload for the newest), answered by one binary message, little-endian:
+//   header  u32 magic "TWCF", u16 version, u8 signal, u8 kind,
+//           u32 count, u32 trigger_index, u64 sequence, u64 timestamp_ms,
+//           f32 dt_s, f32 trigger_value
+//   record  f32 × 11 in CaptureSample order, one per physics substep
+// Record i lies (i - trigger_index)·dt_s from the trigger; timestamp_ms is
+// the end of the tick the trigger fell in. An unknown or overwritten
+// sequence gets a header with count 0.
+inline constexpr uint32_t kCaptureFrameMagic   = 0x46435754;   // "TWCF"
+inline constexpr uint16_t kCaptureFrameVersion = 1;
+inline constexpr std::size_t kCaptureHeaderBytes = 40;
+inline constexpr std::size_t kCaptureRecordBytes = 44;
+
+struct CaptureSample {
+    float cycleAngleRad = 0.0f;
+    float omegaRadS = 0.0f;
+    float cylinderPressurePa = 0.0f;
+    float pistonForceN = 0.0f;
+    float rodForceN = 0.0f;
+    float tangentialForceN = 0.0f;
+    float torqueNm = 0.0f;
+    float sideThrustN = 0.0f;
+    float engineTorqueNm = 0.0f;
+    float stressPa = 0.0f;
+    float shearStressPa = 0.0f;
+
+    [[nodiscard]] float value(CaptureSignal signal) const {
+        switch (signal) {
+        case CaptureSignal::CylinderPressurePa: return cylinderPressurePa;
+        case CaptureSignal::PistonForceN:       return pistonForceN;
+        case CaptureSignal::RodForceN:          return rodForceN;
+        case CaptureSignal::TangentialForceN:   return tangentialForceN;
+        case CaptureSignal::TorqueNm:           return torqueNm;
+        case CaptureSignal::SideThrustN:        return sideThrustN;
+        case CaptureSignal::EngineTorqueNm:     return engineTorqueNm;
+        case CaptureSignal::StressPa:           return stressPa;
+        case CaptureSignal::ShearStressPa:      return shearStressPa;
+        }
+        return 0.0f;
+    }
+};
+static_assert(sizeof(CaptureSample) == kCaptureRecordBytes, "capture records are copied as is");
+
+// Everything about a completed capture except its samples.
+struct CaptureInfo {
+    uint64_t sequence = 0;       // 1 for the first capture
+    uint64_t timestampMs = 0;
+    float dtS = 0.0f;
+    float triggerValue = 0.0f;
+    float rpm = 0.0f;            // at the trigger
+    uint32_t count = 0;
+    uint32_t triggerIndex = 0;
+    CaptureTrigger trigger;
+};
+
+[[nodiscard]] inline constexpr std::size_t captureFrameBytes(std::size_t count) {
+    return kCaptureHeaderBytes + count * kCaptureRecordBytes;
+}
+
+// Writes the header and the records, given as up to two runs (the capture
+// ring unrolled); `out` must hold captureFrameBytes(a.size() + b.size()).
+inline std::size_t encodeCaptureFrame(const CaptureInfo& info, std::span<const CaptureSample> a,
+                                      std::span<const CaptureSample> b, uint8_t* out) {
+    const auto count = static_cast<uint32_t>(a.size() + b.size());
+    const auto signal = static_cast<uint8_t>(info.trigger.signal);
+    const auto kind = static_cast<uint8_t>(info.trigger.kind);
+    std::memcpy(out, &kCaptureFrameMagic, 4);
+    std::memcpy(out + 4, &kCaptureFrameVersion, 2);
+    out[6] = signal;
+    out[7] = kind;
+    std::memcpy(out + 8, &count, 4);
+    std::memcpy(out + 12, &info.triggerIndex, 4);
+    std::memcpy(out + 16, &info.sequence, 8);
+    std::memcpy(out + 24, &info.timestampMs, 8);
+    std::memcpy(out + 32, &info.dtS, 4);
+    std::memcpy(out + 36, &info.triggerValue, 4);
+    uint8_t* at = out + kCaptureHeaderBytes;
+    if (!a.empty()) std::memcpy(at, a.data(), a.size_bytes());
+    if (!b.empty()) std::memcpy(at + a.size_bytes(), b.data(), b.size_bytes());
+    return captureFrameBytes(count);
+}
+
+// {"type":"capture",...} announcing a completed capture; same buffer
+// contract as serializeState().
+inline std::size_t serializeCaptureInfo(const CaptureInfo& c, MessageBuffer& buf) {
+    constexpr std::array<const char*, 3> kKinds = {"level", "slope", "rpm_band"};
+    const std::string_view signal = c.trigger.kind == CaptureTrigger::Kind::RpmBand
+        ? std::string_view("rpm") : kCaptureSignalNames[static_cast<std::size_t>(c.trigger.signal)];
+    int n = std::snprintf(
+        buf.data(), buf.size(),
+        R"({"type":"capture","payload":{"sequence":%llu,"timestamp_ms":%llu,"samples":%u,)"
+        R"("trigger_index":%u,"dt_s":%.8f,"signal":"%.*s","kind":"%s","trigger_value":%.4f,"rpm":%.2f}})",
+        static_cast<unsigned long long>(c.sequence), static_cast<unsigned long long>(c.timestampMs),
+        static_cast<unsigned>(c.count), static_cast<unsigned>(c.triggerIndex), static_cast<double>(c.dtS),
+        static_cast<int>(signal.size()), signal.data(),
+        kKinds[static_cast<std::size_t>(c.trigger.kind)], static_cast<double>(c.triggerValue),
+        static_cast<double>(c.rpm));
+    if (n <= 0 || static_cast<std::size_t>(n) >= buf.size()) return 0;
+    return static_cast<std::size_t>(n);
+}
+
+// {"type":"sandbox",...}; same buffer contract as serializeState().
+inline std::size_t serializeSandboxInfo(const SandboxInfo& info, MessageBuffer& buf) {
+    int n = std::snprintf(buf.data(), buf.size(),
+                          R"({"type":"sandbox","payload":{"status":"%.*s","id":%llu,"worker":%u,"from":"%s"}})",
+                          static_cast<int>(info.status.size()), info.status.data(),
+                          static_cast<unsigned long long>(info.id), info.worker,
+                          info.fromLive ? "live" : "fresh");
+    if (n <= 0 || static_cast<std::size_t>(n) >= buf.size()) return 0;
+    return static_cast<std::size_t>(n);
+}
+
 // ── Parsing incoming client messages ──
-enum class ClientMsgType { SetRpm, Replay, Unknown };
+enum class ClientMsgType {
+    SetRpm, SetLoad, Replay, Subscribe, Unsubscribe, CaptureArm, CaptureDisarm, CaptureGet,
+    SandboxCreate, SandboxClose, ForceQuery, Unknown
+};
 
 struct ClientMessage {
     ClientMsgType type = ClientMsgType::Unknown;
     SetRpmPayload setRpm;
+    SetLoadPayload setLoad;
     ReplayPayload replay;
+    SubscribePayload subscribe;
+    CaptureTrigger captureArm;
+    uint64_t captureSequence = 0;   // capture_get; 0 for the newest
+    SandboxCreatePayload sandboxCreate;
+    ForceQueryPayload forceQuery;
 };
 
 inline std::optional<ClientMessage> parseClientMessage(std::string_view raw) {
@@ -80,6 +682,11 @@ inline std::optional<ClientMessage> parseClientMessage(std::string_view raw) {
             msg.setRpm.rpmTarget = j.at("payload").at("rpm_target").get<float>();
             return msg;
         }
+        if (typeStr == "set_load") {
+            msg.type = ClientMsgType::SetLoad;
+            msg.setLoad.load = j.at("payload").at("load").get<float>();
+            return msg;
+        }
         if (typeStr == "replay") {
             msg.type = ClientMsgType::Replay;
             msg.replay.mode = j.at("payload").at("mode").get<std::string>();
@@ -88,6 +695,87 @@ inline std::optional<ClientMessage> parseClientMessage(std::string_view raw) {
             }
             return msg;
         }
+        if (typeStr == "subscribe" || typeStr == "unsubscribe") {
+            auto topic = topicFromName(j.at("payload").at("topic").get<std::string>());
+            if (!topic) return std::nullopt;
+            msg.type = typeStr == "subscribe" ? ClientMsgType::Subscribe : ClientMsgType::Unsubscribe;
+            msg.subscribe.topic = *topic;
+            return msg;
+        }
+        if (typeStr == "capture_arm") {
+            // {"signal":"rod_force","kind":"level","edge":"rising","threshold":2e4,
+            //  "rpm_min":..,"rpm_max":..,"pre_samples":..,"post_samples":..,"rearm":false}
+            const auto& p = j.at("payload");
+            CaptureTrigger& t = msg.captureArm;
+            const std::string kind = p.value("kind", std::string("level"));
+            const std::string edge = p.value("edge", std::string("rising"));
+            if (kind == "level") t.kind = CaptureTrigger::Kind::Level;
+            else if (kind == "slope") t.kind = CaptureTrigger::Kind::Slope;
+            else if (kind == "rpm_band") t.kind = CaptureTrigger::Kind::RpmBand;
+            else return std::nullopt;
+            if (edge == "rising") t.edge = CaptureTrigger::Edge::Rising;
+            else if (edge == "falling") t.edge = CaptureTrigger::Edge::Falling;
+            else if (edge == "either") t.edge = CaptureTrigger::Edge::Either;
+            else return std::nullopt;
+            if (t.kind != CaptureTrigger::Kind::RpmBand) {
+                auto signal = captureSignalFromName(p.at("signal").get<std::string>());
+                if (!signal) return std::nullopt;
+                t.signal = *signal;
+                t.threshold = p.at("threshold").get<float>();
+            }
+            t.rpmMin = p.value("rpm_min", t.rpmMin);
+            t.rpmMax = p.value("rpm_max", t.rpmMax);
+            t.preSamples = p.value("pre_samples", t.preSamples);
+            t.postSamples = p.value("post_samples", t.postSamples);
+            t.rearm = p.value("rearm", false);
+            msg.type = ClientMsgType::CaptureArm;
+            return msg;
+        }
+        if (typeStr == "capture_disarm") {
+            msg.type = ClientMsgType::CaptureDisarm;
+            return msg;
+        }
+        if (typeStr == "capture_get") {
+            msg.type = ClientMsgType::CaptureGet;
+            if (j.contains("payload")) msg.captureSequence = j["payload"].value("sequence", uint64_t{0});
+            return msg;
+        }
+        if (typeStr == "sandbox_create") {
+            // {"from":"live"} (default) or {"from":"fresh"}
+            const std::string from = j.contains("payload") ? j["payload"].value("from", std::string("live"))
+                                                           : std::string("live");
+            if (from != "live" && from != "fresh") return std::nullopt;
+            msg.type = ClientMsgType::SandboxCreate;
+            msg.sandboxCreate.fromLive = from == "live";
+            return msg;
+        }
+        if (typeStr == "sandbox_close") {
+            msg.type = ClientMsgType::SandboxClose;
+            return msg;
+        }
+        if (typeStr == "force_query") {
+            const auto& p = j.at("payload");
+            const auto& rpm = p.at("rpm");
+            const auto& angle = p.at("cycle_angle_rad");
+            if (!rpm.is_array() || !angle.is_array() || rpm.size() != angle.size()
+                || rpm.empty() || rpm.size() > kMaxForcePoints) {
+                return std::nullopt;
+            }
+            // Out-of-range numbers arrive as inf; the angle wrap would turn them
+            // into NaN and the table lookup into a bad index.
+            const float load = p.value("load", 0.0f);
+            if (!std::isfinite(load)) return std::nullopt;
+            msg.type = ClientMsgType::ForceQuery;
+            msg.forceQuery.load = std::clamp(load, 0.0f, 1.0f);
+            msg.forceQuery.points.resize(rpm.size());
+            for (std::size_t i = 0; i < rpm.size(); ++i) {
+                const float r = rpm[i].get<float>();
+                const float a = angle[i].get<float>();
+                if (!std::isfinite(r) || !std::isfinite(a)) return std::nullopt;
+                msg.forceQuery.points[i] = {r, a};
+            }
+            return msg;
+        }
         return std::nullopt;
     } catch (...) {
         return std::nullopt;
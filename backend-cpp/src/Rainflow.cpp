@@ -0,0 +1,121 @@
+#include "Rainflow.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+RainflowCounter::RainflowCounter(const RainflowSpec& spec)
+    : mSpec(spec)
+{
+    mSpec.rangeBins = std::max<uint16_t>(mSpec.rangeBins, 1);
+    mSpec.meanBins = std::max<uint16_t>(mSpec.meanBins, 1);
+    const float binWidth = mSpec.rangeMax / static_cast<float>(mSpec.rangeBins);
+    mGate = mSpec.gate > 0.0f ? mSpec.gate : 0.5f * binWidth;
+    mRangeScale = mSpec.rangeMax > 0.0f ? static_cast<float>(mSpec.rangeBins) / mSpec.rangeMax : 0.0f;
+    const float meanSpan = mSpec.meanMax - mSpec.meanMin;
+    mMeanScale = meanSpan > 0.0f ? static_cast<float>(mSpec.meanBins) / meanSpan : 0.0f;
+    mHalfCycles.assign(static_cast<std::size_t>(mSpec.rangeBins) * mSpec.meanBins, 0);
+}
+
+void RainflowCounter::reset() {
+    mDirection = 0;
+    mCandidate = 0.0f;
+    mStarted = false;
+    mResidueSize = 0;
+    std::fill(mHalfCycles.begin(), mHalfCycles.end(), 0u);
+    mTotalHalfCycles = 0;
+}
+
+void RainflowCounter::start(float x) {
+    // The first sample is the first turning point; the direction is set by
+    // the first move past the gate.
+    if (!mStarted) {
+        mStarted = true;
+        addTurningPoint(x);
+        return;
+    }
+    const float origin = mResidue[mResidueSize - 1];
+    if (x - origin >= mGate) {
+        mDirection = 1;
+        mCandidate = x;
+    } else if (origin - x >= mGate) {
+        mDirection = -1;
+        mCandidate = x;
+    }
+}
+
+void RainflowCounter::reverse(float x, int direction) {
+    addTurningPoint(mCandidate);
+    mDirection = direction;
+    mCandidate = x;
+}
+
+std::size_t RainflowCounter::binOf(float from, float to) const {
+    const float range = std::abs(to - from) * mRangeScale;
+    const float mean = (0.5f * (from + to) - mSpec.meanMin) * mMeanScale;
+    const auto r = static_cast<std::size_t>(std::min(range, static_cast<float>(mSpec.rangeBins - 1)));
+    const auto m = static_cast<std::size_t>(std::clamp(mean, 0.0f, static_cast<float>(mSpec.meanBins - 1)));
+    return r * mSpec.meanBins + m;
+}
+
+void RainflowCounter::addTurningPoint(float p) {
+    if (mResidueSize == kResidueCapacity) {
+        // Full: the oldest reversal can no longer close, count it as half.
+        ++mHalfCycles[binOf(mResidue[0], mResidue[1])];
+        ++mTotalHalfCycles;
+        std::copy(mResidue.begin() + 1, mResidue.end(), mResidue.begin());
+        --mResidueSize;
+    }
+    mResidue[mResidueSize++] = p;
+
+    // Four-point rule on the top of the stack.
+    while (mResidueSize >= 4) {
+        const float a = mResidue[mResidueSize - 4];
+        const float b = mResidue[mResidueSize - 3];
+        const float c = mResidue[mResidueSize - 2];
+        const float d = mResidue[mResidueSize - 1];
+        const float inner = std::abs(c - b);
+        if (inner > std::abs(b - a) || inner > std::abs(d - c)) break;
+        mHalfCycles[binOf(b, c)] += 2;
+        mTotalHalfCycles += 2;
+        mResidue[mResidueSize - 3] = d;
+        mResidueSize -= 2;
+    }
+}
+
+std::vector<float> RainflowCounter::matrix(bool includeResidue) const {
+    std::vector<float> cycles(mHalfCycles.size());
+    for (std::size_t i = 0; i < cycles.size(); ++i) cycles[i] = 0.5f * static_cast<float>(mHalfCycles[i]);
+    if (includeResidue) {
+        for (std::size_t i = 1; i < mResidueSize; ++i) cycles[binOf(mResidue[i - 1], mResidue[i])] += 0.5f;
+        if (mDirection != 0) cycles[binOf(mResidue[mResidueSize - 1], mCandidate)] += 0.5f;
+    }
+    return cycles;
+}
+
+float RainflowCounter::rangeAt(std::size_t rangeBin) const {
+    return (static_cast<float>(rangeBin) + 0.5f) * mSpec.rangeMax / static_cast<float>(mSpec.rangeBins);
+}
+
+float RainflowCounter::meanAt(std::size_t meanBin) const {
+    return mSpec.meanMin + (static_cast<float>(meanBin) + 0.5f) * (mSpec.meanMax - mSpec.meanMin)
+                           / static_cast<float>(mSpec.meanBins);
+}
+
+bool RainflowCounter::writeCsv(const std::string& path, std::span<const RainflowCounter* const> counters,
+                               std::span<const char* const> names) {
+    std::FILE* out = std::fopen(path.c_str(), "w");
+    if (!out) return false;
+    std::fputs("signal,range,mean,cycles\n", out);
+    for (std::size_t s = 0; s < counters.size(); ++s) {
+        const RainflowCounter& counter = *counters[s];
+        const auto cycles = counter.matrix();
+        const std::size_t meanBins = counter.spec().meanBins;
+        for (std::size_t i = 0; i < cycles.size(); ++i) {
+            if (cycles[i] == 0.0f) continue;
+            std::fprintf(out, "%s,%.6g,%.6g,%.1f\n", names[s], counter.rangeAt(i / meanBins),
+                         counter.meanAt(i % meanBins), cycles[i]);
+        }
+    }
+    std::fclose(out);
+    return true;
+}
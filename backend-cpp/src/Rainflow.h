@@ -0,0 +1,132 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+#include "Checkpoint.h"
+
+// ── Streaming rainflow cycle counting ──
+// Counts load cycles in a signal sample by sample, for fatigue. Samples pass
+// a turning-point detector with a hysteresis gate (reversals smaller than the
+// gate are noise and never reach the counter); each confirmed peak or valley
+// goes onto the residue stack, and the four-point rule closes cycles there:
+// for the last four points a b c d, if |c-b| ≤ |b-a| and |c-b| ≤ |d-c|, b-c is
+// a full cycle and both points leave the stack. A sample costs a compare or
+// two; a turning point amortized O(1), since every point is pushed and popped
+// at most once.
+//
+// Cycles go into a range × mean matrix of half-cycle counts. The residue left
+// after the four-point rule is what ASTM E1049 counts as half cycles, which
+// matrix() can include. The stack has a fixed capacity: with the gate at
+// half a range bin it only overflows on pathological signals, and then its
+// oldest reversal is counted as a half cycle and dropped. Memory is fixed at
+// construction, which keeps per-twin counters across a fleet predictable.
+
+struct RainflowSpec {
+    float rangeMax = 1.0f;      // top range bin also collects anything larger
+    float meanMin  = -1.0f;     // means outside [meanMin, meanMax] go to the edge bins
+    float meanMax  = 1.0f;
+    uint16_t rangeBins = 32;
+    uint16_t meanBins  = 16;
+    float gate = 0.0f;          // hysteresis; 0 = half a range bin
+};
+
+class RainflowCounter {
+public:
+    static constexpr std::size_t kResidueCapacity = 64;
+
+    explicit RainflowCounter(const RainflowSpec& spec = {});
+
+    void push(float x) {
+        if (mDirection > 0) {
+            if (x > mCandidate) mCandidate = x;
+            else if (mCandidate - x >= mGate) reverse(x, -1);
+        } else if (mDirection < 0) {
+            if (x < mCandidate) mCandidate = x;
+            else if (x - mCandidate >= mGate) reverse(x, 1);
+        } else {
+            start(x);
+        }
+    }
+
+    [[nodiscard]] const RainflowSpec& spec() const { return mSpec; }
+
+    // Closed half cycles in one bin (two per full cycle).
+    [[nodiscard]] uint32_t halfCycles(std::size_t rangeBin, std::size_t meanBin) const {
+        return mHalfCycles[rangeBin * mSpec.meanBins + meanBin];
+    }
+
+    // Cycles per bin, range-major (rangeBins × meanBins); with the residue
+    // (and the still-open reversal) as half cycles unless told otherwise.
+    [[nodiscard]] std::vector<float> matrix(bool includeResidue = true) const;
+
+    // Full cycles closed so far.
+    [[nodiscard]] double cycles() const { return 0.5 * static_cast<double>(mTotalHalfCycles); }
+
+    [[nodiscard]] std::span<const float> residue() const { return { mResidue.data(), mResidueSize }; }
+
+    // Bin centres.
+    [[nodiscard]] float rangeAt(std::size_t rangeBin) const;
+    [[nodiscard]] float meanAt(std::size_t meanBin) const;
+
+    void reset();
+
+    // Heap and object bytes held by one counter.
+    [[nodiscard]] std::size_t bytes() const { return sizeof(*this) + mHalfCycles.size() * sizeof(uint32_t); }
+
+    // Checkpoint hook (Checkpoint.h): counts, residue and the open
+    // excursion. The bins come from the spec, so a read must find as many
+    // as this counter has.
+    template <typename Self, typename Io>
+    static void visitState(Self& self, Io& io) {
+        int32_t direction = self.mDirection;
+        io(direction);
+        if (direction < -1 || direction > 1) return io.fail();
+        io(self.mCandidate);
+        visitFlag(self.mStarted, io);
+        uint32_t residue = static_cast<uint32_t>(self.mResidueSize);
+        io(residue);
+        if (residue > kResidueCapacity) return io.fail();
+        io.array(self.mResidue.data(), residue);
+        uint32_t bins = static_cast<uint32_t>(self.mHalfCycles.size());
+        io(bins);
+        if (bins != self.mHalfCycles.size()) return io.fail();
+        io.array(self.mHalfCycles.data(), bins);
+        io(self.mTotalHalfCycles);
+        if constexpr (Io::kReading) {
+            self.mDirection = direction;
+            self.mResidueSize = residue;
+        }
+    }
+
+    // Writes `counters` as one CSV of signal,range,mean,cycles rows, each
+    // labelled with its entry in `names`: nonzero bins only, residue
+    // included as half cycles. False if `path` cannot be opened.
+    static bool writeCsv(const std::string& path, std::span<const RainflowCounter* const> counters,
+                         std::span<const char* const> names);
+
+private:
+    void start(float x);
+    void reverse(float x, int direction);
+    void addTurningPoint(float p);
+    [[nodiscard]] std::size_t binOf(float from, float to) const;
+
+    RainflowSpec mSpec;
+    float mGate = 0.0f;
+    float mRangeScale = 0.0f;
+    float mMeanScale = 0.0f;
+
+    // Turning-point detector: direction of the open excursion (0 before the
+    // first gate crossing) and its running extreme.
+    int mDirection = 0;
+    float mCandidate = 0.0f;
+    bool mStarted = false;
+
+    std::array<float, kResidueCapacity> mResidue{};
+    std::size_t mResidueSize = 0;
+
+    std::vector<uint32_t> mHalfCycles;
+    uint64_t mTotalHalfCycles = 0;
+};
@@ -0,0 +1,69 @@
+#include "RevolutionStats.h"
+#include <algorithm>
+#include <cmath>
+
+void RevolutionAggregator::Open::begin(const Sample& at) {
+    *this = {};
+    torquePeakNm = at.engineTorqueNm;
+    rodForceMaxN = at.rodForceN;
+    sideThrustMaxN = std::abs(at.sideThrustN);
+}
+
+void RevolutionAggregator::Open::include(const Sample& from, const Sample& to, double dt) {
+    // Trapezoids between consecutive samples; the extremes are taken at the
+    // samples themselves.
+    const double a = from.engineTorqueNm;
+    const double b = to.engineTorqueNm;
+    timeS += dt;
+    torqueIntegral += 0.5 * (a + b) * dt;
+    torqueSqIntegral += 0.5 * (a * a + b * b) * dt;
+    torquePeakNm = std::max(torquePeakNm, to.engineTorqueNm);
+    rodForceMaxN = std::max(rodForceMaxN, to.rodForceN);
+    sideThrustMaxN = std::max(sideThrustMaxN, std::abs(to.sideThrustN));
+}
+
+bool RevolutionAggregator::add(float dt, float dAngleRad, float angleRad, const Sample& sample) {
+    if (!mHasPrevious) {
+        mHasPrevious = true;
+        mPrevious = sample;
+        mOpen.begin(sample);
+        return false;
+    }
+
+    // The angle wrapped inside this substep iff it ended less than one step
+    // past zero while moving forward.
+    const bool crossed = dAngleRad > 0.0f && angleRad < dAngleRad;
+    if (!crossed) {
+        mOpen.include(mPrevious, sample, dt);
+        mPrevious = sample;
+        return false;
+    }
+
+    const float after = angleRad / dAngleRad;   // share of the substep past 2π
+    const float before = 1.0f - after;
+    auto lerp = [&](float x0, float x1) { return x0 + (x1 - x0) * before; };
+    const Sample boundary{lerp(mPrevious.engineTorqueNm, sample.engineTorqueNm),
+                          lerp(mPrevious.rodForceN, sample.rodForceN),
+                          lerp(mPrevious.sideThrustN, sample.sideThrustN)};
+    mOpen.include(mPrevious, boundary, static_cast<double>(dt) * before);
+
+    const bool report = mPrimed && mOpen.timeS > 0.0;
+    if (report) {
+        const double period = mOpen.timeS;
+        mCompleted = {};
+        mCompleted.index = mRevolutions++;
+        mCompleted.durationS = static_cast<float>(period);
+        mCompleted.rpm = static_cast<float>(60.0 / period);
+        mCompleted.torqueMeanNm = static_cast<float>(mOpen.torqueIntegral / period);
+        mCompleted.torqueRmsNm = static_cast<float>(std::sqrt(std::max(0.0, mOpen.torqueSqIntegral / period)));
+        mCompleted.torquePeakNm = mOpen.torquePeakNm;
+        mCompleted.rodForceMaxN = mOpen.rodForceMaxN;
+        mCompleted.sideThrustMaxN = mOpen.sideThrustMaxN;
+    }
+    mPrimed = true;
+
+    mOpen.begin(boundary);
+    mOpen.include(boundary, sample, static_cast<double>(dt) * after);
+    mPrevious = sample;
+    return report;
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <cstdint>
+#include "Checkpoint.h"
+#include "Protocol.h"
+
+// ── Per-revolution aggregates of the force chain ──
+// Reduces the substep stream to one protocol::RevolutionPayload per crank
+// revolution: mean, RMS and peak of the whole-engine torque, peak rod
+// compression and peak |side thrust| of cylinder 1, and the revolution's
+// period. A revolution ends where the crank angle passes 2π; the substep
+// that crosses it is split at the interpolated crossing, so each revolution
+// integrates exactly its own time and both sides see the boundary value.
+// O(1) per substep, no allocation.
+class RevolutionAggregator {
+public:
+    struct Sample {
+        float engineTorqueNm = 0.0f;
+        float rodForceN = 0.0f;
+        float sideThrustN = 0.0f;
+    };
+
+    // One substep of length dt that turned the crank by dAngleRad and ended
+    // at angleRad ∈ [0, 2π) with `sample`. True when a revolution closed
+    // inside it; completed() then holds that revolution. The partial
+    // revolution before the first crossing is not reported.
+    bool add(float dt, float dAngleRad, float angleRad, const Sample& sample);
+
+    [[nodiscard]] const protocol::RevolutionPayload& completed() const { return mCompleted; }
+    [[nodiscard]] uint64_t revolutions() const { return mRevolutions; }
+
+    // Checkpoint hook (Checkpoint.h): the open revolution and the count.
+    template <typename Self, typename Io>
+    static void visitState(Self& self, Io& io) {
+        io(self.mOpen.timeS);
+        io(self.mOpen.torqueIntegral);
+        io(self.mOpen.torqueSqIntegral);
+        io(self.mOpen.torquePeakNm);
+        io(self.mOpen.rodForceMaxN);
+        io(self.mOpen.sideThrustMaxN);
+        io(self.mPrevious);
+        visitFlag(self.mHasPrevious, io);
+        visitFlag(self.mPrimed, io);
+        io(self.mRevolutions);
+        visitRevolutionPayload(self.mCompleted, io);
+    }
+
+private:
+    struct Open {
+        double timeS = 0.0;
+        double torqueIntegral = 0.0;     // ∫T dt
+        double torqueSqIntegral = 0.0;   // ∫T² dt
+        float torquePeakNm = 0.0f;
+        float rodForceMaxN = 0.0f;
+        float sideThrustMaxN = 0.0f;
+
+        void begin(const Sample& at);
+        void include(const Sample& from, const Sample& to, double dt);
+    };
+
+    Open mOpen;
+    Sample mPrevious;
+    bool mHasPrevious = false;
+    bool mPrimed = false;             // a crossing has been seen
+    uint64_t mRevolutions = 0;
+    protocol::RevolutionPayload mCompleted;
+};
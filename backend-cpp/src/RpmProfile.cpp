@@ -0,0 +1,104 @@
+#include "RpmProfile.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+std::optional<RpmProfile> RpmProfile::parse(std::istream& in, std::string* error) {
+    std::vector<Point> points;
+    std::string line;
+    std::size_t lineNo = 0;
+    bool headerSkipped = false;
+    auto fail = [&](const char* what) -> std::optional<RpmProfile> {
+        if (error) *error = "line " + std::to_string(lineNo) + ": " + what;
+        return std::nullopt;
+    };
+
+    while (std::getline(in, line)) {
+        ++lineNo;
+        auto hash = line.find('#');
+        if (hash != std::string::npos) line.erase(hash);
+        if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+
+        std::replace(line.begin(), line.end(), ',', ' ');
+        std::istringstream fields(line);
+        Point p;
+        if (!(fields >> p.timeS >> p.rpm)) {
+            if (points.empty() && !headerSkipped) {
+                headerSkipped = true;
+                continue;
+            }
+            return fail("expected time_s,rpm[,load]");
+        }
+        if (!(fields >> p.load)) p.load = 0.0f;
+        if (!std::isfinite(p.timeS) || !std::isfinite(p.rpm) || !std::isfinite(p.load)) {
+            return fail("non-finite value");
+        }
+        if (!points.empty() && p.timeS < points.back().timeS) {
+            return fail("time goes backwards");
+        }
+        points.push_back(p);
+    }
+
+    auto profile = fromPoints(std::move(points));
+    if (!profile && error) *error = "no breakpoints";
+    return profile;
+}
+
+std::optional<RpmProfile> RpmProfile::fromFile(const std::string& path, std::string* error) {
+    std::ifstream in(path);
+    if (!in) {
+        if (error) *error = "cannot open " + path;
+        return std::nullopt;
+    }
+    return parse(in, error);
+}
+
+std::optional<RpmProfile> RpmProfile::fromPoints(std::vector<Point> points) {
+    if (points.empty()) return std::nullopt;
+    for (std::size_t i = 1; i < points.size(); ++i) {
+        if (points[i].timeS < points[i - 1].timeS) return std::nullopt;
+    }
+    for (Point& p : points) p.load = std::clamp(p.load, 0.0f, 1.0f);
+
+    RpmProfile profile;
+    profile.mPoints = std::move(points);
+    return profile;
+}
+
+RpmProfile RpmProfile::dutyCycle() {
+    return *fromPoints({
+        {   0.0,  800.0f, 0.05f},   // idle
+        {  60.0,  800.0f, 0.05f},
+        {  70.0, 3500.0f, 0.80f},   // pull away
+        {  90.0, 2200.0f, 0.30f},   // urban cruise
+        { 180.0, 2200.0f, 0.30f},
+        { 190.0,  900.0f, 0.00f},   // stop
+        { 220.0,  800.0f, 0.05f},
+        { 240.0, 5500.0f, 1.00f},   // motorway on-ramp
+        { 260.0, 3000.0f, 0.45f},   // motorway cruise
+        { 480.0, 3000.0f, 0.45f},
+        { 500.0, 6500.0f, 0.90f},   // overtake
+        { 520.0, 3000.0f, 0.45f},
+        { 570.0, 1500.0f, 0.00f},   // coast down
+        { 600.0,  800.0f, 0.05f},
+    });
+}
+
+RpmProfile::Demand RpmProfile::at(double timeS, std::size_t& cursor) const {
+    const double duration = durationS();
+    if (mLoop && duration > 0.0 && timeS > duration) {
+        timeS = std::fmod(timeS, duration);
+    }
+
+    const std::size_t last = mPoints.size() - 1;
+    if (cursor > last || mPoints[cursor].timeS > timeS) cursor = 0;
+    while (cursor < last && mPoints[cursor + 1].timeS <= timeS) ++cursor;
+
+    const Point& a = mPoints[cursor];
+    if (cursor == last || timeS <= a.timeS) return {a.rpm, a.load};
+
+    const Point& b = mPoints[cursor + 1];
+    float t = static_cast<float>((timeS - a.timeS) / (b.timeS - a.timeS));
+    return {a.rpm + t * (b.rpm - a.rpm), a.load + t * (b.load - a.load)};
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <cstddef>
+#include <istream>
+#include <optional>
+#include <string>
+#include <vector>
+
+// ── Time-varying RPM / load demand for offline runs ──
+// A piecewise-linear schedule of (time, rpm target, load) breakpoints. Before
+// the first breakpoint the first values hold; after the last the last values
+// hold, or the schedule repeats when looping is enabled.
+//
+// Text form, one breakpoint per line:
+//   time_s,rpm[,load]
+// Blank lines, '#' comments and a non-numeric header line are ignored. Load
+// defaults to 0 and is clamped to 0…1; times must not decrease.
+class RpmProfile {
+public:
+    struct Point {
+        double timeS = 0.0;
+        float rpm = 0.0f;
+        float load = 0.0f;
+    };
+
+    struct Demand {
+        float rpm = 0.0f;
+        float load = 0.0f;
+    };
+
+    // Returns nullopt on malformed input; `error` then names the offending line.
+    static std::optional<RpmProfile> parse(std::istream& in, std::string* error = nullptr);
+    static std::optional<RpmProfile> fromFile(const std::string& path, std::string* error = nullptr);
+
+    // Needs at least one point; times must be non-decreasing.
+    static std::optional<RpmProfile> fromPoints(std::vector<Point> points);
+
+    // Ten-minute urban/highway mix used when no profile is given.
+    static RpmProfile dutyCycle();
+
+    [[nodiscard]] double durationS() const { return mPoints.back().timeS; }
+    [[nodiscard]] const std::vector<Point>& points() const { return mPoints; }
+
+    void setLooping(bool loop) { mLoop = loop; }
+    [[nodiscard]] bool looping() const { return mLoop; }
+
+    // Demand at time t. `cursor` caches the active segment between calls, so
+    // a monotonic sweep costs O(1) per lookup; start it at 0.
+    [[nodiscard]] Demand at(double timeS, std::size_t& cursor) const;
+
+private:
+    RpmProfile() = default;
+
+    std::vector<Point> mPoints;
+    bool mLoop = false;
+};
@@ -0,0 +1,152 @@
+#include "SandboxPool.h"
+#include <algorithm>
+#include "EngineRegistry.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+
+// Sandboxes yield to every normal-priority thread, the live loop first.
+void lowerPriority() {
+#if defined(_WIN32)
+    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_BELOW_NORMAL);
+#elif defined(__linux__)
+    sched_param param{};
+    pthread_setschedparam(pthread_self(), SCHED_IDLE, &param);
+#endif
+}
+
+} // namespace
+
+SandboxPool::SandboxPool(SandboxConfig config, unsigned threads, std::size_t maxSandboxes)
+    : mConfig(std::move(config))
+    , mCapacity(maxSandboxes)
+{
+    if (threads == 0) {
+        const unsigned hardware = std::thread::hardware_concurrency();
+        threads = hardware > 2 ? hardware - 2 : 1;
+    }
+    mWorkers.reserve(threads);
+    for (unsigned w = 0; w < threads; ++w) {
+        auto worker = std::make_unique<Worker>();
+        worker->thread = std::jthread([&worker = *worker](std::stop_token stop) { run(worker, stop); });
+        mWorkers.push_back(std::move(worker));
+    }
+}
+
+SandboxPool::~SandboxPool() {
+    // Stop every worker before joining any of them.
+    for (auto& worker : mWorkers) worker->thread.request_stop();
+}
+
+std::optional<SandboxPool::Sandbox> SandboxPool::create(std::span<const uint8_t> checkpoint, Sink sink,
+                                                        std::string* error) {
+    std::size_t open = mOpen.load(std::memory_order_relaxed);
+    do {
+        if (open >= mCapacity) {
+            if (error) *error = "full";
+            return std::nullopt;
+        }
+    } while (!mOpen.compare_exchange_weak(open, open + 1, std::memory_order_relaxed));
+
+    // Built here, on the caller's thread, so a worker's tick never waits on
+    // an allocation.
+    std::shared_ptr<TwinEngine> engine = EngineRegistry::create(
+        mConfig.variant, mConfig.physicsRateHz, mConfig.layout, mConfig.phaseFormat);
+    if (!engine) {
+        mOpen.fetch_sub(1, std::memory_order_relaxed);
+        if (error) *error = "unknown engine " + mConfig.variant + "/" + mConfig.phaseFormat;
+        return std::nullopt;
+    }
+    engine->setDynamics(mConfig.speedModel, mConfig.loadModel);
+    if (!checkpoint.empty() && !engine->restoreCheckpoint(checkpoint, error, false)) {
+        mOpen.fetch_sub(1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+
+    auto least = std::min_element(mWorkers.begin(), mWorkers.end(), [](const auto& a, const auto& b) {
+        return a->count.load(std::memory_order_relaxed) < b->count.load(std::memory_order_relaxed);
+    });
+    Worker& worker = **least;
+    Sandbox sandbox{mNextId.fetch_add(1, std::memory_order_relaxed),
+                    static_cast<unsigned>(least - mWorkers.begin()), engine};
+    worker.count.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard lk(worker.mutex);
+        worker.incoming.push_back({sandbox.id, std::move(engine), std::move(sink)});
+    }
+    return sandbox;
+}
+
+void SandboxPool::close(const Sandbox& sandbox) {
+    if (sandbox.worker >= mWorkers.size()) return;
+    Worker& worker = *mWorkers[sandbox.worker];
+    {
+        std::lock_guard lk(worker.mutex);
+        worker.closing.push_back(sandbox.id);
+    }
+    worker.count.fetch_sub(1, std::memory_order_relaxed);
+    mOpen.fetch_sub(1, std::memory_order_relaxed);
+}
+
+SandboxPool::TickStats SandboxPool::takeTickStats() {
+    TickStats stats;
+    for (auto& worker : mWorkers) {
+        stats.maxTick = std::max(stats.maxTick,
+                                 std::chrono::microseconds(worker->maxTickUs.exchange(0, std::memory_order_relaxed)));
+        stats.overruns += worker->overruns.exchange(0, std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+void SandboxPool::run(Worker& worker, std::stop_token stop) {
+    using Clock = std::chrono::steady_clock;
+    constexpr auto kTick = std::chrono::microseconds(static_cast<int64_t>(TwinEngine::kDt * 1e6f));
+    lowerPriority();
+
+    std::vector<Entry> active;
+    std::vector<Entry> incoming;
+    std::vector<uint64_t> closing;
+    auto deadline = Clock::now();
+    while (!stop.stop_requested()) {
+        {
+            std::lock_guard lk(worker.mutex);
+            incoming.swap(worker.incoming);
+            closing.swap(worker.closing);
+        }
+        for (Entry& entry : incoming) active.push_back(std::move(entry));
+        incoming.clear();
+        if (!closing.empty()) {
+            std::erase_if(active, [&](const Entry& entry) {
+                return std::find(closing.begin(), closing.end(), entry.id) != closing.end();
+            });
+            closing.clear();
+        }
+
+        const auto start = Clock::now();
+        for (Entry& entry : active) {
+            entry.engine->step();
+            entry.sink(entry.engine->snapshot());
+        }
+        const auto now = Clock::now();
+        if (!active.empty()) {
+            const int64_t us = std::chrono::duration_cast<std::chrono::microseconds>(now - start).count();
+            if (us > worker.maxTickUs.load(std::memory_order_relaxed)) {
+                worker.maxTickUs.store(us, std::memory_order_relaxed);
+            }
+        }
+
+        // A late shard drops the ticks it missed rather than bursting.
+        deadline += kTick;
+        if (deadline < now) {
+            if (!active.empty()) worker.overruns.fetch_add(1, std::memory_order_relaxed);
+            deadline = now;
+        }
+        std::this_thread::sleep_until(deadline);
+    }
+}
@@ -0,0 +1,106 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+#include "PhysicsEngine.h"
+
+// Engine setup shared by every sandbox in a pool; the server passes its own.
+struct SandboxConfig {
+    std::string variant = std::string(DefaultGeometry::kName);
+    std::string phaseFormat = FloatPhase::kName;
+    float physicsRateHz = TwinEngine::kDefaultPhysicsRateHz;
+    EngineLayout layout = EngineLayout::singleCylinder();
+    SpeedModel speedModel = SpeedModel::Filter;
+    LoadModel loadModel;
+};
+
+// ── Private what-if twins beside the live one ──
+// Each sandbox is a full TwinEngine of the pool's configuration, started
+// fresh or restored from a checkpoint of the live twin. Sandboxes are spread
+// over a fixed set of worker threads, each placed on the worker with the
+// fewest. A worker steps its shard at 100 Hz on its own clock and hands
+// every snapshot to the sandbox's sink, on the worker thread. The live
+// twin's thread never touches the pool: it only encodes the checkpoint
+// between steps (CheckpointRequests), which create() decodes on the
+// caller's thread, and the workers run at the lowest scheduling priority
+// (SCHED_IDLE on Linux, below normal on Windows), so they only get the CPU
+// time the live loop and the I/O thread leave over.
+//
+// create() and close() are safe from any thread and only exchange a short
+// list with the worker. The owner keeps the returned engine to set its
+// targets (TwinEngine's setters are atomic); everything else about the
+// engine belongs to the worker.
+class SandboxPool {
+public:
+    using Sink = std::function<void(const protocol::StatePayload&)>;
+
+    struct Sandbox {
+        uint64_t id = 0;
+        unsigned worker = 0;
+        std::shared_ptr<TwinEngine> engine;
+    };
+
+    // threads = 0 leaves two hardware threads to the live loop and the I/O
+    // thread, and uses at least one. At most maxSandboxes are open at once.
+    SandboxPool(SandboxConfig config, unsigned threads, std::size_t maxSandboxes);
+    ~SandboxPool();
+
+    SandboxPool(const SandboxPool&) = delete;
+    SandboxPool& operator=(const SandboxPool&) = delete;
+
+    // Builds and schedules a sandbox, restored from `checkpoint` (in memory,
+    // sealed or not) or fresh when it is empty. Returns nullopt when the pool is full, the
+    // configuration names no engine or the checkpoint does not restore into
+    // it; `error` says which.
+    std::optional<Sandbox> create(std::span<const uint8_t> checkpoint, Sink sink, std::string* error = nullptr);
+
+    // The worker drops the sandbox before its next tick; a tick already
+    // under way may still reach the sink once.
+    void close(const Sandbox& sandbox);
+
+    [[nodiscard]] std::size_t size() const { return mOpen.load(std::memory_order_relaxed); }
+    [[nodiscard]] std::size_t capacity() const { return mCapacity; }
+    [[nodiscard]] unsigned threads() const { return static_cast<unsigned>(mWorkers.size()); }
+
+    // Longest single tick of any worker (its whole shard) since the last
+    // call, and the ticks that overran kDt in that time.
+    struct TickStats {
+        std::chrono::microseconds maxTick{0};
+        uint64_t overruns = 0;
+    };
+    TickStats takeTickStats();
+
+private:
+    struct Entry {
+        uint64_t id = 0;
+        std::shared_ptr<TwinEngine> engine;
+        Sink sink;
+    };
+
+    struct Worker {
+        std::mutex mutex;   // guards incoming and closing
+        std::vector<Entry> incoming;
+        std::vector<uint64_t> closing;
+        std::atomic<std::size_t> count{0};
+        std::atomic<int64_t> maxTickUs{0};
+        std::atomic<uint64_t> overruns{0};
+        std::jthread thread;   // last: joined before the rest is destroyed
+    };
+
+    static void run(Worker& worker, std::stop_token stop);
+
+    SandboxConfig mConfig;
+    std::size_t mCapacity;
+    std::atomic<std::size_t> mOpen{0};
+    std::atomic<uint64_t> mNextId{1};
+    std::vector<std::unique_ptr<Worker>> mWorkers;
+};
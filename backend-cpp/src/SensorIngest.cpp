@@ -0,0 +1,67 @@
+#include "SensorIngest.h"
+#include <algorithm>
+#include <cmath>
+#include "Protocol.h"
+
+SensorIngest::SensorIngest()
+    : mQueue(std::make_unique<SpscQueue<Queued, kQueueCapacity>>())
+{
+    mTick.reserve(kMaxSamplesPerTick);
+}
+
+bool SensorIngest::pushFrame(const uint8_t* data, std::size_t len) {
+    const auto count = protocol::sensorFrameRecords(data, len);
+    if (!count) {
+        mMalformed.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    for (std::size_t i = 0; i < *count; ++i) {
+        if (protocol::sensorRecord(data, i).kind >= SensorSample::kKinds) {
+            mMalformed.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    }
+
+    const std::size_t pushed = mQueue->pushBatch(*count, [data](std::size_t i) {
+        const protocol::SensorRecord r = protocol::sensorRecord(data, i);
+        Queued q;
+        q.timestampNs = r.timestampNs;
+        q.sample.kind = static_cast<SensorSample::Kind>(r.kind);
+        q.sample.cylinder = r.cylinder;
+        q.sample.value = r.value;
+        return q;
+    });
+    mReceived.fetch_add(pushed, std::memory_order_relaxed);
+    if (pushed < *count) mDropped.fetch_add(*count - pushed, std::memory_order_relaxed);
+    return true;
+}
+
+std::span<const SensorSample> SensorIngest::drainTick(float tickS) {
+    const auto tickNs = static_cast<uint64_t>(std::llround(static_cast<double>(tickS) * 1e9));
+    mTick.clear();
+
+    while (mTick.size() < kMaxSamplesPerTick) {
+        const Queued* q = mQueue->front();
+        if (!q) break;
+
+        const uint64_t t = q->timestampNs;
+        if (!mSynced || t + kResyncNs < mWindowStartNs || t >= mWindowStartNs + tickNs + kResyncNs) {
+            mWindowStartNs = t;
+            mSynced = true;
+        }
+        if (t >= mWindowStartNs + tickNs) break;   // a later tick's
+
+        SensorSample s = q->sample;
+        s.timeS = static_cast<float>(static_cast<double>(static_cast<int64_t>(t - mWindowStartNs)) * 1e-9);
+        mTick.push_back(s);
+        mQueue->pop();
+    }
+    if (mSynced) mWindowStartNs += tickNs;
+
+    // Several senders interleave; the estimator wants time order.
+    auto byTime = [](const SensorSample& a, const SensorSample& b) { return a.timeS < b.timeS; };
+    if (!std::is_sorted(mTick.begin(), mTick.end(), byTime)) {
+        std::sort(mTick.begin(), mTick.end(), byTime);
+    }
+    return mTick;
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+#include "SpscQueue.h"
+#include "StateEstimator.h"
+
+// ── Sensor ingestion: I/O thread → physics thread ──
+// The I/O thread decodes binary sensor frames (Protocol.h) straight into a
+// lock-free SPSC queue; the physics thread drains one tick's worth per step
+// and hands it to TwinEngine::assimilate(). Nothing allocates per frame or
+// per sample: the queue and the per-tick buffer are sized at construction,
+// and records that do not fit are dropped and counted.
+//
+// Ticks are windows on the sender's clock. The first sample opens the first
+// window and each drainTick() advances it by one tick, so a sender running in
+// real time stays aligned with the 100 Hz loop. Late samples get a negative
+// timeS (the estimator applies them at once); a timestamp more than
+// kResyncNs away from the window restarts the alignment, e.g. after the
+// sender restarts.
+class SensorIngest {
+public:
+    static constexpr std::size_t kQueueCapacity     = std::size_t{1} << 17;   // ~130 ms at 1 MS/s
+    static constexpr std::size_t kMaxSamplesPerTick = std::size_t{1} << 15;
+    static constexpr uint64_t kResyncNs = 1'000'000'000;
+
+    SensorIngest();
+
+    // Producer, one thread. Returns false (and enqueues nothing) for a
+    // malformed frame or one with an unknown sensor kind.
+    bool pushFrame(const uint8_t* data, std::size_t len);
+
+    // Consumer, one thread: the samples of the next tick window, sorted by
+    // time, timeS relative to the window start. Valid until the next call.
+    [[nodiscard]] std::span<const SensorSample> drainTick(float tickS);
+
+    [[nodiscard]] uint64_t received() const { return mReceived.load(std::memory_order_relaxed); }
+    [[nodiscard]] uint64_t dropped() const { return mDropped.load(std::memory_order_relaxed); }
+    [[nodiscard]] uint64_t malformed() const { return mMalformed.load(std::memory_order_relaxed); }
+    [[nodiscard]] std::size_t queued() const { return mQueue->size(); }
+
+private:
+    struct Queued {
+        uint64_t timestampNs = 0;
+        SensorSample sample;
+    };
+
+    std::unique_ptr<SpscQueue<Queued, kQueueCapacity>> mQueue;
+
+    // Consumer state
+    std::vector<SensorSample> mTick;
+    bool mSynced = false;
+    uint64_t mWindowStartNs = 0;
+
+    std::atomic<uint64_t> mReceived{0};
+    std::atomic<uint64_t> mDropped{0};
+    std::atomic<uint64_t> mMalformed{0};
+};
@@ -0,0 +1,65 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// ── Bounded single-producer / single-consumer queue ──
+// Lock-free ring of Capacity slots (a power of two). The producer publishes
+// a whole batch with one release store, the consumer frees slots one at a
+// time; each side caches the other's index and only reloads it when the ring
+// looks full (or empty). No allocation after construction, so allocate the
+// queue itself once, on the heap for large capacities.
+template <typename T, std::size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+
+public:
+    // Producer: writes make(i) for i = 0… while there is room, up to `count`
+    // items, and publishes them together. Returns how many were written.
+    template <typename Make>
+    std::size_t pushBatch(std::size_t count, Make&& make) {
+        const std::size_t head = mHead.load(std::memory_order_relaxed);
+        if (Capacity - (head - mCachedTail) < count) {
+            mCachedTail = mTail.load(std::memory_order_acquire);
+        }
+        const std::size_t n = std::min(count, Capacity - (head - mCachedTail));
+        for (std::size_t i = 0; i < n; ++i) {
+            mSlots[(head + i) & kMask] = make(i);
+        }
+        mHead.store(head + n, std::memory_order_release);
+        return n;
+    }
+
+    // Consumer: oldest item, or nullptr if empty.
+    [[nodiscard]] const T* front() {
+        const std::size_t tail = mTail.load(std::memory_order_relaxed);
+        if (tail == mCachedHead) {
+            mCachedHead = mHead.load(std::memory_order_acquire);
+            if (tail == mCachedHead) return nullptr;
+        }
+        return &mSlots[tail & kMask];
+    }
+
+    // Consumer: drops the item front() returned.
+    void pop() {
+        mTail.store(mTail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Items in flight; exact only when called from one side with the other idle.
+    [[nodiscard]] std::size_t size() const {
+        return mHead.load(std::memory_order_acquire) - mTail.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] static constexpr std::size_t capacity() { return Capacity; }
+
+private:
+    static constexpr std::size_t kMask = Capacity - 1;
+
+    // Producer and consumer indices on separate cache lines.
+    alignas(64) std::atomic<std::size_t> mHead{0};
+    std::size_t mCachedTail = 0;
+    alignas(64) std::atomic<std::size_t> mTail{0};
+    std::size_t mCachedHead = 0;
+    alignas(64) std::array<T, Capacity> mSlots{};
+};
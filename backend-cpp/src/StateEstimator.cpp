@@ -0,0 +1,222 @@
+#include "StateEstimator.h"
+#include <algorithm>
+#include "GasPressure.h"
+
+namespace {
+
+constexpr float kTwoPi    = 2.0f * 3.14159265358979323846f;
+constexpr float kCycleRad = EngineLayout::kCycleRad;
+
+// Finite-difference steps for the Jacobians: well inside one 0.5° cell of the
+// pressure table and large enough to stay clear of float rounding.
+constexpr float kAngleStep    = 2e-3f;    // rad
+constexpr float kOmegaStep    = 0.5f;     // rad/s
+constexpr float kThrottleStep = 0.01f;
+
+float wrapCycle(float a) {
+    a = std::fmod(a, kCycleRad);
+    return a < 0.0f ? a + kCycleRad : a;
+}
+
+} // namespace
+
+CrankEstimator::CrankEstimator(const EstimatorModel& model, const EstimatorConfig& config)
+    : mModel(model)
+    , mConfig(config)
+{
+    mPhase = mModel.layout.phaseRad();
+}
+
+void CrankEstimator::reset(const CrankEstimate& seed) {
+    mX << wrapCycle(seed.cycleAngleRad), std::max(seed.omegaRadS, 0.0f),
+          seed.loadTorqueNm, std::clamp(seed.throttle, 0.0f, 1.0f);
+    const CrankEstimate& s = mConfig.initialSigma;
+    mP = State(s.cycleAngleRad, s.omegaRadS, s.loadTorqueNm, s.throttle).cwiseAbs2().asDiagonal();
+    mTimeS = 0.0f;
+}
+
+CrankEstimate CrankEstimator::estimate() const {
+    return { mX(0), mX(1), mX(2), mX(3) };
+}
+
+float CrankEstimator::expected(SensorSample::Kind kind, std::size_t cylinder) const {
+    return measurement(mX, kind, cylinder);
+}
+
+void CrankEstimator::update(std::span<const SensorSample> samples) {
+    for (const SensorSample& s : samples) {
+        predictTo(s.timeS);
+        correct(s);
+    }
+}
+
+void CrankEstimator::finishTick(float tickS) {
+    predictTo(tickS);
+    mTimeS -= tickS;
+}
+
+void CrankEstimator::predictTo(float timeS) {
+    const float gap = timeS - mTimeS;
+    if (!(gap > 0.0f)) return;
+    const auto steps = static_cast<unsigned>(std::ceil(gap / mConfig.maxPredictStepS));
+    const float h = gap / static_cast<float>(steps);
+    for (unsigned i = 0; i < steps; ++i) predict(h);
+    mTimeS = timeS;
+}
+
+// ── Model ──
+
+float CrankEstimator::engineTorque(const State& x) const {
+    std::array<float, EngineLayout::kMaxCylinders> angle, omega, gasForce;
+    std::array<float, EngineLayout::kMaxCylinders> piston, rod, tangential, torque, side;
+    const std::size_t cylinders = mModel.layout.cylinders();
+
+    GasPressureTable::Slice slice;
+    if (mModel.gas) slice = mModel.gas->slice(x(3), x(1) * 60.0f / kTwoPi);
+    for (std::size_t c = 0; c < cylinders; ++c) {
+        angle[c] = wrapCycle(x(0) - mPhase[c]);
+        omega[c] = x(1);
+        gasForce[c] = mModel.gas ? (GasPressureTable::pressurePa(slice, angle[c])
+                                    - GasPressureTable::kCrankcasePa) * mModel.boreArea
+                                 : 0.0f;
+    }
+    computeCrankForcesBatch(mModel.crank, angle.data(), omega.data(), gasForce.data(), cylinders,
+                            {piston.data(), rod.data(), tangential.data(), torque.data(), side.data()});
+
+    float sum = 0.0f;
+    for (std::size_t c = 0; c < cylinders; ++c) sum += torque[c];
+    return sum;
+}
+
+float CrankEstimator::measurement(const State& x, SensorSample::Kind kind, std::size_t cylinder) const {
+    switch (kind) {
+    case SensorSample::Kind::CrankAngle:
+        return std::fmod(x(0), kTwoPi);
+    case SensorSample::Kind::CrankSpeed:
+        return x(1);
+    case SensorSample::Kind::CylinderPressure:
+    case SensorSample::Kind::RodStrain:
+        break;
+    }
+
+    const float cycle = wrapCycle(x(0) - mPhase[cylinder]);
+    float pressure = GasPressureTable::kCrankcasePa;
+    if (mModel.gas) {
+        pressure = GasPressureTable::pressurePa(mModel.gas->slice(x(3), x(1) * 60.0f / kTwoPi), cycle);
+    }
+    if (kind == SensorSample::Kind::CylinderPressure) return pressure;
+
+    const float omega = x(1);
+    const float gasForce = (pressure - GasPressureTable::kCrankcasePa) * mModel.boreArea;
+    float piston, rod, tangential, torque, side;
+    computeCrankForcesBatch(mModel.crank, &cycle, &omega, &gasForce, 1,
+                            {&piston, &rod, &tangential, &torque, &side});
+    return rod / mConfig.rodAxialStiffnessN;
+}
+
+// ── Filter ──
+
+void CrankEstimator::predict(float dt) {
+    const float inverseInertia = 1.0f / mModel.inertiaKgM2;
+
+    // ∂T/∂θ, ∂T/∂ω, ∂T/∂u by forward differences; throttle steps back near 1
+    // where the table clamps.
+    const float torque = engineTorque(mX);
+    State x = mX;
+    x(0) += kAngleStep;
+    const float dTdAngle = (engineTorque(x) - torque) / kAngleStep;
+    x = mX;
+    x(1) += kOmegaStep;
+    const float dTdOmega = (engineTorque(x) - torque) / kOmegaStep;
+    x = mX;
+    const float du = mX(3) + kThrottleStep <= 1.0f ? kThrottleStep : -kThrottleStep;
+    x(3) += du;
+    const float dTdThrottle = (engineTorque(x) - torque) / du;
+
+    const float accel = (torque - mX(2)) * inverseInertia;
+    mX(0) = wrapCycle(mX(0) + dt * mX(1) + 0.5f * dt * dt * accel);
+    mX(1) = std::max(mX(1) + dt * accel, 0.0f);
+
+    Covariance phi = Covariance::Identity();
+    phi(0, 1) = dt;
+    phi(1, 0) = dt * dTdAngle * inverseInertia;
+    phi(1, 1) += dt * dTdOmega * inverseInertia;
+    phi(1, 2) = -dt * inverseInertia;
+    phi(1, 3) = dt * dTdThrottle * inverseInertia;
+
+    mP = phi * mP * phi.transpose();
+    mP(1, 1) += mConfig.omegaNoise * dt;
+    mP(2, 2) += mConfig.loadTorqueNoise * dt;
+    mP(3, 3) += mConfig.throttleNoise * dt;
+}
+
+void CrankEstimator::correct(const SensorSample& sample) {
+    InnovationStats& stats = mStats[static_cast<std::size_t>(sample.kind)];
+    const std::size_t cylinder = sample.cylinder;
+    if (cylinder >= mModel.layout.cylinders() || !std::isfinite(sample.value)) {
+        ++stats.rejected;
+        return;
+    }
+
+    Eigen::Matrix<float, 1, kStates> h = Eigen::Matrix<float, 1, kStates>::Zero();
+    const float predicted = measurement(mX, sample.kind, cylinder);
+    float innovation = sample.value - predicted;
+    float variance = 0.0f;
+
+    switch (sample.kind) {
+    case SensorSample::Kind::CrankAngle:
+        // The sensor sees one revolution; compare on the circle.
+        innovation = std::remainder(innovation, kTwoPi);
+        h(0) = 1.0f;
+        variance = mConfig.angleSigmaRad * mConfig.angleSigmaRad;
+        break;
+    case SensorSample::Kind::CrankSpeed:
+        h(1) = 1.0f;
+        variance = mConfig.speedSigmaRadS * mConfig.speedSigmaRadS;
+        break;
+    case SensorSample::Kind::CylinderPressure:
+    case SensorSample::Kind::RodStrain: {
+        State x = mX;
+        x(0) += kAngleStep;
+        h(0) = (measurement(x, sample.kind, cylinder) - predicted) / kAngleStep;
+        x = mX;
+        x(1) += kOmegaStep;
+        h(1) = (measurement(x, sample.kind, cylinder) - predicted) / kOmegaStep;
+        x = mX;
+        const float du = mX(3) + kThrottleStep <= 1.0f ? kThrottleStep : -kThrottleStep;
+        x(3) += du;
+        h(3) = (measurement(x, sample.kind, cylinder) - predicted) / du;
+        const float sigma = sample.kind == SensorSample::Kind::CylinderPressure
+                          ? mConfig.pressureSigmaPa : mConfig.strainSigma;
+        variance = sigma * sigma;
+        break;
+    }
+    }
+
+    const State ph = mP * h.transpose();
+    const float s = h.dot(ph) + variance;
+    const float nis = innovation * innovation / s;
+    if (!(nis <= mConfig.gateNis)) {
+        if (++stats.consecutiveRejected <= mConfig.maxConsecutiveRejections || !std::isfinite(nis)) {
+            ++stats.rejected;
+            return;
+        }
+        ++stats.forced;
+    }
+    stats.consecutiveRejected = 0;
+
+    // Joseph form keeps P symmetric positive definite in float.
+    const State gain = ph / s;
+    mX += gain * innovation;
+    mX(0) = wrapCycle(mX(0));
+    mX(1) = std::max(mX(1), 0.0f);
+    mX(3) = std::clamp(mX(3), 0.0f, 1.0f);
+
+    const Covariance a = Covariance::Identity() - gain * h;
+    mP = a * mP * a.transpose() + (variance * gain) * gain.transpose();
+
+    ++stats.accepted;
+    stats.sum += innovation;
+    stats.sumSquares += static_cast<double>(innovation) * innovation;
+    stats.sumNis += nis;
+}
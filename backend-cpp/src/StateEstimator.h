@@ -0,0 +1,154 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <Eigen/Core>
+#include "CrankKernel.h"
+#include "EngineLayout.h"
+
+class GasPressureTable;
+
+// ── Extended Kalman filter for the crank state ──
+// Keeps the twin locked to a real engine by fusing its sensor streams.
+//
+// State x = [θ, ω, T_load, u]: four-stroke cycle angle of cylinder 1 (0…4π),
+// crank speed, load torque on the shaft and throttle fraction. Process model
+// (the torque-driven dynamics of CrankDynamics.h):
+//   θ̇ = ω,   ω̇ = (T_engine(θ, ω, u) - T_load) / J,   T_load, u random walks
+// T_engine sums every cylinder's inertia and gas torque from the batch force
+// kernel and the shared GasPressureTable; its Jacobian is taken by finite
+// differences through the same code.
+//
+// Measurements are scalar and applied one at a time in Joseph form, so an
+// update needs no matrix inverse. Samples sharing a timestamp share one
+// prediction, which is what makes a batch of channels per instant cheap.
+// Innovations beyond `gateNis` are rejected and counted, unless a channel
+// keeps disagreeing long enough to mean the twin has lost lock. Every
+// matrix is a fixed-size Eigen type and nothing allocates after construction.
+
+// One sensor reading.
+struct SensorSample {
+    enum class Kind : uint8_t {
+        CrankAngle,         // rad, crank angle 0…2π from TDC of cylinder 1
+        CrankSpeed,         // rad/s
+        CylinderPressure,   // Pa absolute
+        RodStrain,          // axial strain of the connecting rod (+ = compression)
+    };
+    static constexpr std::size_t kKinds = 4;
+
+    Kind kind = Kind::CrankAngle;
+    uint8_t cylinder = 0;   // 0-based; pressure and strain only
+    float timeS = 0.0f;     // seconds since the start of the tick being assimilated
+    float value = 0.0f;
+};
+
+struct CrankEstimate {
+    float cycleAngleRad = 0.0f;
+    float omegaRadS     = 0.0f;
+    float loadTorqueNm  = 0.0f;
+    float throttle      = 0.0f;
+};
+
+struct EstimatorConfig {
+    // Prior 1σ when the filter is (re)seeded from the twin's own state
+    CrankEstimate initialSigma{0.05f, 5.0f, 200.0f, 0.2f};
+
+    // Measurement noise, 1σ
+    float angleSigmaRad    = 0.0087f;    // 0.5°
+    float speedSigmaRadS   = 0.5f;
+    float pressureSigmaPa  = 50e3f;      // 0.5 bar
+    float strainSigma      = 2e-6f;
+
+    // Process noise spectral densities
+    float omegaNoise       = 1.0f;       // (rad/s²)²·s, unmodelled torque
+    float loadTorqueNoise  = 1e6f;       // (N·m)²/s
+    float throttleNoise    = 0.5f;       // 1/s
+
+    float gateNis          = 25.0f;      // reject innovations beyond 5σ
+    // After this many consecutive rejections on one channel the model, not
+    // the sensor, is taken to be wrong: the next sample is applied ungated.
+    uint32_t maxConsecutiveRejections = 50;
+    float maxPredictStepS  = 1e-4f;      // long gaps are integrated in steps of this
+    float rodAxialStiffnessN = 210e9f * 2.5e-4f;   // E·A of the rod shank
+};
+
+// Everything the process and measurement models need from one engine.
+struct EstimatorModel {
+    CrankGeometry crank;
+    float boreArea = 0.0f;
+    float inertiaKgM2 = 1.0f;
+    EngineLayout layout = EngineLayout::singleCylinder();
+    const GasPressureTable* gas = nullptr;
+};
+
+// Running innovation statistics of one measurement kind. A well-tuned filter
+// has mean NIS ≈ 1 and innovations centred on 0.
+struct InnovationStats {
+    uint64_t accepted = 0;
+    uint64_t rejected = 0;
+    uint64_t forced = 0;                // ungated after a run of rejections
+    uint32_t consecutiveRejected = 0;
+    double sum = 0.0;
+    double sumSquares = 0.0;
+    double sumNis = 0.0;
+
+    [[nodiscard]] double mean() const { return accepted ? sum / static_cast<double>(accepted) : 0.0; }
+    [[nodiscard]] double rms() const {
+        return accepted ? std::sqrt(sumSquares / static_cast<double>(accepted)) : 0.0;
+    }
+    [[nodiscard]] double meanNis() const { return accepted ? sumNis / static_cast<double>(accepted) : 0.0; }
+};
+
+class CrankEstimator {
+public:
+    static constexpr int kStates = 4;
+    using State = Eigen::Matrix<float, kStates, 1>;
+    using Covariance = Eigen::Matrix<float, kStates, kStates>;
+
+    CrankEstimator(const EstimatorModel& model, const EstimatorConfig& config = {});
+
+    // Restarts from a state with the configured initial covariance.
+    void reset(const CrankEstimate& seed);
+
+    // Fuses samples in time order (times relative to the current tick's
+    // start). A sample older than the filter's time is applied at that time.
+    void update(std::span<const SensorSample> samples);
+
+    // Propagates to `tickS` and makes it the next tick's start.
+    void finishTick(float tickS);
+
+    // Propagates without measurements, within the current tick.
+    void predictTo(float timeS);
+
+    // Model output h(x) for a sensor at the current state; same units as
+    // SensorSample::value.
+    [[nodiscard]] float expected(SensorSample::Kind kind, std::size_t cylinder = 0) const;
+
+    [[nodiscard]] CrankEstimate estimate() const;
+    [[nodiscard]] const Covariance& covariance() const { return mP; }
+    [[nodiscard]] float timeS() const { return mTimeS; }
+
+    [[nodiscard]] const InnovationStats& stats(SensorSample::Kind kind) const {
+        return mStats[static_cast<std::size_t>(kind)];
+    }
+    void resetStats() { mStats = {}; }
+
+private:
+    void predict(float dt);
+    void correct(const SensorSample& sample);
+
+    // Summed engine torque and one cylinder's outputs at an arbitrary state.
+    [[nodiscard]] float engineTorque(const State& x) const;
+    [[nodiscard]] float measurement(const State& x, SensorSample::Kind kind, std::size_t cylinder) const;
+
+    EstimatorModel mModel;
+    EstimatorConfig mConfig;
+    std::array<float, EngineLayout::kMaxCylinders> mPhase{};
+
+    State mX = State::Zero();
+    Covariance mP = Covariance::Identity();
+    float mTimeS = 0.0f;
+    std::array<InnovationStats, SensorSample::kKinds> mStats{};
+};
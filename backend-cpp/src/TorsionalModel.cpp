@@ -0,0 +1,125 @@
+#include "TorsionalModel.h"
+#include <algorithm>
+#include <cmath>
+#include <Eigen/Dense>
+
+namespace {
+
+// e^M by scaling and squaring with a Taylor core; construction-time only.
+Eigen::MatrixXd matrixExp(const Eigen::MatrixXd& m) {
+    const double norm = m.cwiseAbs().rowwise().sum().maxCoeff();
+    const int squarings = norm > 0.5 ? static_cast<int>(std::ceil(std::log2(norm / 0.5))) : 0;
+    const Eigen::MatrixXd a = m / std::ldexp(1.0, squarings);
+
+    const auto n = m.rows();
+    Eigen::MatrixXd result = Eigen::MatrixXd::Identity(n, n);
+    Eigen::MatrixXd term = Eigen::MatrixXd::Identity(n, n);
+    for (int k = 1; k <= 16; ++k) {
+        term = term * a / static_cast<double>(k);
+        result += term;
+    }
+    for (int i = 0; i < squarings; ++i) result = result * result;
+    return result;
+}
+
+} // namespace
+
+TorsionalModel::TorsionalModel(const TorsionalParams& params, std::size_t throws, float dt)
+    : mMasses(throws + 2)
+    , mThrows(throws)
+    , mShearPerRad(16.0f * params.sectionStiffness
+                   / (3.14159265358979323846f * params.journalDiameter
+                      * params.journalDiameter * params.journalDiameter))
+{
+    const auto n = static_cast<Eigen::Index>(mMasses);
+    const auto ns = n - 1;
+    const auto nt = static_cast<Eigen::Index>(throws);
+    const double h = dt;
+
+    Eigen::VectorXd inertia(n);
+    inertia(0) = params.pulleyInertia;
+    inertia.segment(1, nt).setConstant(params.throwInertia);
+    inertia(n - 1) = params.flywheelInertia;
+
+    // Absolute-angle chain matrices: each section couples masses i and i+1.
+    Eigen::MatrixXd k = Eigen::MatrixXd::Zero(n, n);
+    Eigen::MatrixXd c = Eigen::MatrixXd::Zero(n, n);
+    for (Eigen::Index i = 0; i + 1 < n; ++i) {
+        k(i, i) += params.sectionStiffness;     k(i + 1, i + 1) += params.sectionStiffness;
+        k(i, i + 1) -= params.sectionStiffness; k(i + 1, i) -= params.sectionStiffness;
+        c(i, i) += params.sectionDamping;       c(i + 1, i + 1) += params.sectionDamping;
+        c(i, i + 1) -= params.sectionDamping;   c(i + 1, i) -= params.sectionDamping;
+    }
+    for (Eigen::Index i = 1; i <= nt; ++i) c(i, i) += params.throwDamping;
+
+    // θ = S·q: section twists q, measured in the centre-of-inertia frame.
+    Eigen::MatrixXd sum = Eigen::MatrixXd::Zero(n, ns);
+    for (Eigen::Index i = 1; i < n; ++i) sum.block(i, 0, 1, i).setOnes();
+    const Eigen::MatrixXd centre = Eigen::MatrixXd::Identity(n, n)
+        - Eigen::VectorXd::Ones(n) * inertia.transpose() / inertia.sum();
+    const Eigen::MatrixXd sMap = centre * sum;
+
+    Eigen::MatrixXd inject = Eigen::MatrixXd::Zero(n, nt);
+    inject.block(1, 0, nt, nt).setIdentity();
+
+    const Eigen::MatrixXd mr = sMap.transpose() * inertia.asDiagonal() * sMap;
+    const Eigen::MatrixXd kr = sMap.transpose() * k * sMap;
+    const Eigen::MatrixXd cr = sMap.transpose() * c * sMap;
+    const Eigen::MatrixXd br = sMap.transpose() * inject;
+    const Eigen::LDLT<Eigen::MatrixXd> mrInv(mr);
+
+    // State z = [q; h·q̇]: scaling velocities by h keeps every entry of the
+    // float transition matrix O(1), so rounding cannot push a lightly damped
+    // mode outside the unit circle.
+    Eigen::MatrixXd aug = Eigen::MatrixXd::Zero(2 * ns + nt, 2 * ns + nt);
+    aug.block(0, ns, ns, ns) = Eigen::MatrixXd::Identity(ns, ns) / h;
+    aug.block(ns, 0, ns, ns) = -h * mrInv.solve(kr);
+    aug.block(ns, ns, ns, ns) = -mrInv.solve(cr);
+    aug.block(ns, 2 * ns, ns, nt) = h * mrInv.solve(br);
+
+    // e^{[A B; 0 0]·h} = [Ad Bd; 0 I]
+    const Eigen::MatrixXd e = matrixExp(aug * h);
+    mAd = e.block(0, 0, 2 * ns, 2 * ns).cast<float>();
+    mBd = e.block(0, 2 * ns, 2 * ns, nt).cast<float>();
+    mState = StateVector::Zero(2 * ns);
+    mNext = StateVector::Zero(2 * ns);
+
+    // K_r·v = ω²·M_r·v over the elastic modes only.
+    Eigen::GeneralizedSelfAdjointEigenSolver<Eigen::MatrixXd> modes(kr, mr, Eigen::EigenvaluesOnly);
+    for (std::size_t m = 0; m < kMaxModes && static_cast<Eigen::Index>(m) < ns; ++m) {
+        double omega2 = std::max(0.0, modes.eigenvalues()(static_cast<Eigen::Index>(m)));
+        mNaturalHz[m] = static_cast<float>(std::sqrt(omega2) / (2.0 * 3.14159265358979323846));
+    }
+}
+
+void TorsionalModel::step(const float* throwTorqueNm) {
+    // Plain column-wise axpy over the packed column-major storage: at these
+    // sizes (6…36 states) Eigen's runtime-sized GEMV spends more time in
+    // setup than in arithmetic.
+    const auto ns = static_cast<std::size_t>(mState.size());
+    const float* ad = mAd.data();
+    const float* bd = mBd.data();
+    const float* x = mState.data();
+    float* next = mNext.data();
+
+    std::fill(next, next + ns, 0.0f);
+    for (std::size_t j = 0; j < ns; ++j, ad += ns) {
+        const float xj = x[j];
+        for (std::size_t i = 0; i < ns; ++i) next[i] += ad[i] * xj;
+    }
+    for (std::size_t j = 0; j < mThrows; ++j, bd += ns) {
+        const float uj = throwTorqueNm[j];
+        for (std::size_t i = 0; i < ns; ++i) next[i] += bd[i] * uj;
+    }
+    mState.swap(mNext);
+}
+
+void TorsionalModel::reset() {
+    mState.setZero();
+}
+
+float TorsionalModel::maxShearStressPa() const {
+    float m = 0.0f;
+    for (std::size_t s = 0; s < sections(); ++s) m = std::max(m, std::abs(shearStressPa(s)));
+    return m;
+}
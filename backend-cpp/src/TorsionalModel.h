@@ -0,0 +1,96 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <Eigen/Core>
+#include "EngineLayout.h"
+
+// Lumped torsional parameters of one crankshaft; see Geometry.h.
+struct TorsionalParams {
+    float pulleyInertia    = 0.0f;   // kg·m²
+    float throwInertia     = 0.0f;   // kg·m² per throw
+    float flywheelInertia  = 0.0f;   // kg·m²
+    float sectionStiffness = 0.0f;   // N·m/rad per journal section
+    float sectionDamping   = 0.0f;   // N·m·s/rad across each section
+    float throwDamping     = 0.0f;   // N·m·s/rad from each throw to ground
+    float journalDiameter  = 0.0f;   // m
+
+    template <typename Geometry>
+    static constexpr TorsionalParams of() {
+        return { Geometry::kPulleyInertia, Geometry::kThrowInertia, Geometry::kFlywheelInertia,
+                 Geometry::kSectionStiffness, Geometry::kSectionDamping, Geometry::kThrowDamping,
+                 Geometry::kJournalDiameter };
+    }
+};
+
+// ── Crankshaft torsional vibration, lumped multi-mass state space ──
+// Masses along the shaft: pulley, one per throw (EngineLayout::throwOf),
+// flywheel, joined by N+1 elastic journal sections for N throws. The rigid rotation is the RPM
+// model's job, so the state holds only the section twists q: mass angles
+// relative to the centre of inertia are θ = S·q, and projecting
+//   J·θ̈ + C·θ̇ + K·θ = T
+// onto S gives M_r·q̈ + C_r·q̇ + K_r·q = Sᵀ·T. Sᵀ annihilates a uniform
+// (mean) torque, so only the fluctuating part excites twist, and the model
+// has no rigid-body mode to drift. The state z = [q; h·q̇] is advanced with
+// the exact zero-order-hold discretization
+//   z ← Ad·z + Bd·T_throws,   Ad = e^{A·h}, Bd = ∫₀ʰ e^{A·s} ds · B
+// computed once for the step size. Matrices are Eigen fixed-max-size types
+// (sized for EngineLayout::kMaxCylinders), so step() never allocates.
+//
+// Outputs per section i (between mass i and i+1): twist q_i and elastic
+// shear stress τ = 16·k·q_i / (π·d³) at the journal surface.
+class TorsionalModel {
+public:
+    static constexpr std::size_t kMaxMasses   = EngineLayout::kMaxCylinders + 2;
+    static constexpr std::size_t kMaxSections = kMaxMasses - 1;
+    static constexpr std::size_t kMaxModes    = 3;
+
+    TorsionalModel(const TorsionalParams& params, std::size_t throws, float dt);
+
+    // Advances one step with the given per-throw torque (N·m, `throws` values).
+    void step(const float* throwTorqueNm);
+
+    void reset();
+
+    [[nodiscard]] std::size_t sections() const { return mMasses - 1; }
+    [[nodiscard]] float twistRad(std::size_t section) const {
+        return mState(static_cast<Eigen::Index>(section));
+    }
+    [[nodiscard]] float shearStressPa(std::size_t section) const {
+        return mShearPerRad * twistRad(section);
+    }
+    [[nodiscard]] float maxShearStressPa() const;
+
+    // Lowest elastic natural frequencies (undamped), ascending.
+    [[nodiscard]] const std::array<float, kMaxModes>& naturalFrequenciesHz() const {
+        return mNaturalHz;
+    }
+
+    // Checkpoint hook (Checkpoint.h): the twist state z. The matrices follow
+    // from the parameters, so a read must find this model's state size.
+    template <typename Self, typename Io>
+    static void visitState(Self& self, Io& io) {
+        uint32_t size = static_cast<uint32_t>(self.mState.size());
+        io(size);
+        if (size != static_cast<uint32_t>(self.mState.size())) return io.fail();
+        io.array(self.mState.data(), size);
+    }
+
+private:
+    static constexpr int kMaxState = static_cast<int>(2 * kMaxSections);
+    static constexpr int kMaxInputs = static_cast<int>(EngineLayout::kMaxCylinders);
+
+    using StateMatrix = Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor,
+                                      kMaxState, kMaxState>;
+    using InputMatrix = Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor,
+                                      kMaxState, kMaxInputs>;
+    using StateVector = Eigen::Matrix<float, Eigen::Dynamic, 1, Eigen::ColMajor, kMaxState, 1>;
+
+    std::size_t mMasses;
+    std::size_t mThrows;
+    float mShearPerRad;
+    StateMatrix mAd;
+    InputMatrix mBd;
+    StateVector mState;
+    StateVector mNext;
+    std::array<float, kMaxModes> mNaturalHz{};
+};
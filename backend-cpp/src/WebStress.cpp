@@ -0,0 +1,422 @@
+#include "WebStress.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+#include "Geometry.h"
+
+// Basis file layout (little-endian):
+//   char[4]  "TWSB"
+//   uint32   version, nodes N, triangles E, modes M, loads (= WebLoads::kCount)
+//   char[16] variant name, NUL-padded
+//   float    node x, y                    × 2N
+//   uint32   triangle node indices       × 3E
+//   float    W, M × loads, row-major
+//   float    Φ, 3N × M, column-major (σxx | σyy | τxy per column)
+static_assert(std::endian::native == std::endian::little,
+              "StressBasis files are read and written in host byte order");
+
+namespace {
+
+constexpr char kMagic[4] = {'T', 'W', 'S', 'B'};
+constexpr uint32_t kVersion = 1;
+constexpr std::size_t kVariantChars = 16;
+// Far beyond any mesh twin_stressbasis builds; caps what a corrupt header
+// can make fromFile() allocate.
+constexpr uint32_t kMaxNodes = 1u << 20;
+constexpr uint32_t kMaxTriangles = 1u << 21;
+
+struct FileHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t nodes;
+    uint32_t triangles;
+    uint32_t modes;
+    uint32_t loads;
+    char variant[kVariantChars];
+};
+static_assert(sizeof(FileHeader) == 40);
+
+// Half-width of the stadium outline at x: flat between the journal and pin
+// centres, semicircular beyond them.
+double stadiumHalfWidth(const CrankWebSpec& spec, double x) {
+    const double r = spec.halfWidth;
+    double dx = x < 0.0 ? x : x > spec.crankThrow ? x - spec.crankThrow : 0.0;
+    return std::sqrt(std::max(0.0, r * r - dx * dx));
+}
+
+struct Mesh {
+    std::vector<StressBasis::Node> nodes;
+    std::vector<std::array<uint32_t, 3>> triangles;
+};
+
+// Structured mesh: columns clustered toward the rounded ends (Chebyshev
+// spacing), each column split evenly across the local width. The two tip
+// columns collapse to a single node, so the cells next to them become
+// triangle fans.
+Mesh meshStadium(const CrankWebSpec& spec, std::size_t nx, std::size_t ny) {
+    Mesh mesh;
+    const double mid = 0.5 * spec.crankThrow;
+    const double halfLength = mid + spec.halfWidth;
+    const double pi = 3.14159265358979323846;
+
+    auto id = [&](std::size_t i, std::size_t j) -> uint32_t {
+        if (i == 0) return 0;
+        if (i == nx) return static_cast<uint32_t>(1 + (nx - 1) * (ny + 1));
+        return static_cast<uint32_t>(1 + (i - 1) * (ny + 1) + j);
+    };
+
+    for (std::size_t i = 0; i <= nx; ++i) {
+        double x = mid - halfLength * std::cos(pi * static_cast<double>(i) / static_cast<double>(nx));
+        if (i == 0 || i == nx) {
+            mesh.nodes.push_back({static_cast<float>(x), 0.0f});
+            continue;
+        }
+        double hw = stadiumHalfWidth(spec, x);
+        for (std::size_t j = 0; j <= ny; ++j) {
+            double y = hw * (-1.0 + 2.0 * static_cast<double>(j) / static_cast<double>(ny));
+            mesh.nodes.push_back({static_cast<float>(x), static_cast<float>(y)});
+        }
+    }
+
+    for (std::size_t i = 0; i < nx; ++i) {
+        for (std::size_t j = 0; j < ny; ++j) {
+            const uint32_t a = id(i, j), b = id(i + 1, j), c = id(i + 1, j + 1), d = id(i, j + 1);
+            if (a != b && b != c && a != c) mesh.triangles.push_back({a, b, c});
+            if (a != c && c != d && a != d) mesh.triangles.push_back({a, c, d});
+        }
+    }
+    return mesh;
+}
+
+// Constant-strain triangle: strain-displacement matrix and area.
+struct Cst {
+    Eigen::Matrix<double, 3, 6> b;
+    double area;
+};
+
+Cst cstOf(const Mesh& mesh, const std::array<uint32_t, 3>& tri) {
+    const auto& p1 = mesh.nodes[tri[0]];
+    const auto& p2 = mesh.nodes[tri[1]];
+    const auto& p3 = mesh.nodes[tri[2]];
+    const double x1 = p1.x, y1 = p1.y, x2 = p2.x, y2 = p2.y, x3 = p3.x, y3 = p3.y;
+    const double twoA = (x2 - x1) * (y3 - y1) - (x3 - x1) * (y2 - y1);
+    const double bs[3] = {y2 - y3, y3 - y1, y1 - y2};
+    const double cs[3] = {x3 - x2, x1 - x3, x2 - x1};
+
+    Cst e;
+    e.area = 0.5 * twoA;
+    e.b.setZero();
+    for (int n = 0; n < 3; ++n) {
+        e.b(0, 2 * n)     = bs[n] / twoA;
+        e.b(1, 2 * n + 1) = cs[n] / twoA;
+        e.b(2, 2 * n)     = cs[n] / twoA;
+        e.b(2, 2 * n + 1) = bs[n] / twoA;
+    }
+    return e;
+}
+
+template <typename T>
+bool readArray(std::istream& in, std::vector<T>& out, std::size_t count) {
+    out.resize(count);
+    in.read(reinterpret_cast<char*>(out.data()), static_cast<std::streamsize>(count * sizeof(T)));
+    return static_cast<bool>(in);
+}
+
+template <typename T>
+void writeArray(std::ostream& out, const std::vector<T>& v) {
+    out.write(reinterpret_cast<const char*>(v.data()), static_cast<std::streamsize>(v.size() * sizeof(T)));
+}
+
+} // namespace
+
+// ── CrankWebSpec ──
+
+std::optional<CrankWebSpec> CrankWebSpec::forVariant(std::string_view variant) {
+    if (variant == DefaultGeometry::kName)   return of<DefaultGeometry>();
+    if (variant == CompactGeometry::kName)   return of<CompactGeometry>();
+    if (variant == HeavyDutyGeometry::kName) return of<HeavyDutyGeometry>();
+    return std::nullopt;
+}
+
+// ── StressBasis ──
+
+std::optional<StressBasis> StressBasis::build(const CrankWebSpec& spec, std::string_view variant,
+                                              WebMeshSize size, float relTolerance) {
+    if (size.lengthCells < 4 || size.widthCells < 2 || spec.crankThrow <= 0.0f
+        || spec.halfWidth <= 0.0f || spec.thickness <= 0.0f || variant.size() >= kVariantChars) {
+        return std::nullopt;
+    }
+
+    Mesh mesh = meshStadium(spec, size.lengthCells, size.widthCells);
+    const std::size_t nodes = mesh.nodes.size();
+
+    // Clamp the journal; the pin carries the load unless it overlaps the
+    // journal there.
+    std::vector<int> dof(2 * nodes, -1);
+    std::vector<uint32_t> pinNodes;
+    int freeDofs = 0;
+    for (std::size_t n = 0; n < nodes; ++n) {
+        const double x = mesh.nodes[n].x, y = mesh.nodes[n].y;
+        if (std::hypot(x, y) <= spec.journalRadius) continue;
+        dof[2 * n] = freeDofs++;
+        dof[2 * n + 1] = freeDofs++;
+        if (std::hypot(x - spec.crankThrow, y) <= spec.pinRadius) {
+            pinNodes.push_back(static_cast<uint32_t>(n));
+        }
+    }
+    if (pinNodes.empty() || freeDofs == static_cast<int>(2 * nodes)) return std::nullopt;
+
+    // Plane-stress elasticity.
+    const double e = spec.youngsModulusPa, nu = spec.poissonRatio;
+    Eigen::Matrix3d d;
+    d << 1.0, nu, 0.0,
+         nu, 1.0, 0.0,
+         0.0, 0.0, 0.5 * (1.0 - nu);
+    d *= e / (1.0 - nu * nu);
+
+    constexpr std::size_t kLoads = WebLoads::kCount;
+    std::vector<Eigen::Triplet<double>> triplets;
+    triplets.reserve(mesh.triangles.size() * 36);
+    Eigen::MatrixXd rhs = Eigen::MatrixXd::Zero(freeDofs, kLoads);
+
+    for (const auto& tri : mesh.triangles) {
+        const Cst el = cstOf(mesh, tri);
+        if (el.area <= 0.0) return std::nullopt;
+        const Eigen::Matrix<double, 6, 6> ke = spec.thickness * el.area * el.b.transpose() * d * el.b;
+        int map[6];
+        for (int n = 0; n < 3; ++n) {
+            map[2 * n] = dof[2 * tri[n]];
+            map[2 * n + 1] = dof[2 * tri[n] + 1];
+        }
+        for (int r = 0; r < 6; ++r) {
+            if (map[r] < 0) continue;
+            for (int c = 0; c < 6; ++c) {
+                if (map[c] >= 0) triplets.emplace_back(map[r], map[c], ke(r, c));
+            }
+        }
+
+        // Centrifugal body load ρ·ω²·r at unit ω², lumped onto the corners.
+        double cx = 0.0, cy = 0.0;
+        for (uint32_t n : tri) { cx += mesh.nodes[n].x / 3.0; cy += mesh.nodes[n].y / 3.0; }
+        const double share = spec.densityKgM3 * spec.thickness * el.area / 3.0;
+        for (int n = 0; n < 3; ++n) {
+            if (map[2 * n] < 0) continue;
+            rhs(map[2 * n], 2) += share * cx;
+            rhs(map[2 * n + 1], 2) += share * cy;
+        }
+    }
+    for (uint32_t n : pinNodes) {
+        rhs(dof[2 * n], 0) += 1.0 / static_cast<double>(pinNodes.size());
+        rhs(dof[2 * n + 1], 1) += 1.0 / static_cast<double>(pinNodes.size());
+    }
+
+    Eigen::SparseMatrix<double> k(freeDofs, freeDofs);
+    k.setFromTriplets(triplets.begin(), triplets.end());
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> solver(k);
+    if (solver.info() != Eigen::Success) return std::nullopt;
+    const Eigen::MatrixXd u = solver.solve(rhs);
+    if (solver.info() != Eigen::Success) return std::nullopt;
+
+    // Element stresses, averaged onto the nodes by area: rows σxx | σyy | τxy.
+    const auto rows = static_cast<Eigen::Index>(3 * nodes);
+    Eigen::MatrixXd snapshots = Eigen::MatrixXd::Zero(rows, kLoads);
+    Eigen::VectorXd weight = Eigen::VectorXd::Zero(static_cast<Eigen::Index>(nodes));
+    for (const auto& tri : mesh.triangles) {
+        const Cst el = cstOf(mesh, tri);
+        Eigen::Matrix<double, 6, kLoads> ue = Eigen::Matrix<double, 6, kLoads>::Zero();
+        for (int n = 0; n < 3; ++n) {
+            for (int a = 0; a < 2; ++a) {
+                int g = dof[2 * tri[n] + a];
+                if (g >= 0) ue.row(2 * n + a) = u.row(g);
+            }
+        }
+        const Eigen::Matrix<double, 3, kLoads> sigma = d * el.b * ue;
+        for (uint32_t n : tri) {
+            for (int c = 0; c < 3; ++c) {
+                snapshots.row(c * static_cast<Eigen::Index>(nodes) + n) += el.area * sigma.row(c);
+            }
+            weight(n) += el.area;
+        }
+    }
+    for (std::size_t n = 0; n < nodes; ++n) {
+        for (int c = 0; c < 3; ++c) {
+            snapshots.row(c * static_cast<Eigen::Index>(nodes) + static_cast<Eigen::Index>(n)) /=
+                weight(static_cast<Eigen::Index>(n));
+        }
+    }
+
+    // Normalise the load cases (N and rad²/s² differ in scale) before the
+    // SVD so the truncation tolerance compares shapes, not units.
+    const Eigen::VectorXd norms = snapshots.colwise().norm().transpose();
+    if ((norms.array() <= 0.0).any()) return std::nullopt;
+    const Eigen::MatrixXd scaled = snapshots * norms.cwiseInverse().asDiagonal();
+    Eigen::JacobiSVD<Eigen::MatrixXd> svd(scaled, Eigen::ComputeThinU | Eigen::ComputeThinV);
+    const Eigen::VectorXd& s = svd.singularValues();
+    Eigen::Index modes = 0;
+    while (modes < s.size() && s(modes) > relTolerance * s(0)) ++modes;
+
+    StressBasis basis;
+    basis.mVariant = std::string(variant);
+    basis.mNodes = std::move(mesh.nodes);
+    basis.mTriangles = std::move(mesh.triangles);
+    basis.mModes = static_cast<std::size_t>(modes);
+
+    const Eigen::MatrixXd w = s.head(modes).asDiagonal() * svd.matrixV().leftCols(modes).transpose()
+                              * norms.asDiagonal();
+    basis.mLoadToModal.resize(basis.mModes * kLoads);
+    for (Eigen::Index m = 0; m < modes; ++m) {
+        for (Eigen::Index l = 0; l < static_cast<Eigen::Index>(kLoads); ++l) {
+            basis.mLoadToModal[static_cast<std::size_t>(m) * kLoads + static_cast<std::size_t>(l)] =
+                static_cast<float>(w(m, l));
+        }
+        basis.mSingular.push_back(static_cast<float>(s(m)));
+    }
+    basis.mBasis.resize(static_cast<std::size_t>(rows) * basis.mModes);
+    Eigen::Map<Eigen::MatrixXf>(basis.mBasis.data(), rows, modes) =
+        svd.matrixU().leftCols(modes).cast<float>();
+    return basis;
+}
+
+std::optional<StressBasis> StressBasis::fromFile(const std::string& path, std::string* error) {
+    auto fail = [&](const std::string& what) -> std::optional<StressBasis> {
+        if (error) *error = path + ": " + what;
+        return std::nullopt;
+    };
+
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) return fail("cannot open");
+    const std::streamoff fileBytes = in.tellg();
+    in.seekg(0);
+
+    FileHeader h{};
+    in.read(reinterpret_cast<char*>(&h), sizeof(h));
+    if (!in || std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0) return fail("not a stress basis file");
+    if (h.version != kVersion) return fail("unsupported version " + std::to_string(h.version));
+    if (h.loads != WebLoads::kCount) return fail("expected " + std::to_string(WebLoads::kCount) + " load cases");
+    if (h.nodes == 0 || h.modes == 0 || h.modes > h.loads
+        || h.nodes > kMaxNodes || h.triangles > kMaxTriangles) {
+        return fail("bad dimensions");
+    }
+
+    // Sized from the header before anything is allocated from it.
+    const uint64_t payloadBytes =
+        sizeof(float) * 2 * uint64_t{h.nodes} + sizeof(uint32_t) * 3 * uint64_t{h.triangles}
+        + sizeof(float) * uint64_t{h.modes} * h.loads + sizeof(float) * 3 * uint64_t{h.nodes} * h.modes;
+    if (static_cast<uint64_t>(fileBytes) != sizeof(FileHeader) + payloadBytes) {
+        return fail("size does not match its header");
+    }
+
+    StressBasis basis;
+    basis.mVariant.assign(h.variant, std::find(h.variant, h.variant + kVariantChars, '\0'));
+    basis.mModes = h.modes;
+
+    std::vector<float> xy;
+    std::vector<uint32_t> tri;
+    if (!readArray(in, xy, 2 * std::size_t{h.nodes})
+        || !readArray(in, tri, 3 * std::size_t{h.triangles})
+        || !readArray(in, basis.mLoadToModal, std::size_t{h.modes} * h.loads)
+        || !readArray(in, basis.mBasis, 3 * std::size_t{h.nodes} * h.modes)) {
+        return fail("truncated");
+    }
+
+    basis.mNodes.resize(h.nodes);
+    for (std::size_t n = 0; n < h.nodes; ++n) basis.mNodes[n] = {xy[2 * n], xy[2 * n + 1]};
+    basis.mTriangles.resize(h.triangles);
+    for (std::size_t t = 0; t < h.triangles; ++t) {
+        for (int c = 0; c < 3; ++c) {
+            uint32_t n = tri[3 * t + static_cast<std::size_t>(c)];
+            if (n >= h.nodes) return fail("triangle references node " + std::to_string(n));
+            basis.mTriangles[t][static_cast<std::size_t>(c)] = n;
+        }
+    }
+    auto finite = [](float v) { return std::isfinite(v); };
+    if (!std::all_of(basis.mLoadToModal.begin(), basis.mLoadToModal.end(), finite)
+        || !std::all_of(basis.mBasis.begin(), basis.mBasis.end(), finite)) {
+        return fail("non-finite coefficient");
+    }
+    return basis;
+}
+
+bool StressBasis::save(const std::string& path, std::string* error) const {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        if (error) *error = "cannot open " + path;
+        return false;
+    }
+
+    FileHeader h{};
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version = kVersion;
+    h.nodes = static_cast<uint32_t>(mNodes.size());
+    h.triangles = static_cast<uint32_t>(mTriangles.size());
+    h.modes = static_cast<uint32_t>(mModes);
+    h.loads = static_cast<uint32_t>(WebLoads::kCount);
+    std::memcpy(h.variant, mVariant.data(), std::min(mVariant.size(), kVariantChars - 1));
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+
+    std::vector<float> xy;
+    xy.reserve(2 * mNodes.size());
+    for (const Node& n : mNodes) { xy.push_back(n.x); xy.push_back(n.y); }
+    std::vector<uint32_t> tri;
+    tri.reserve(3 * mTriangles.size());
+    for (const auto& t : mTriangles) tri.insert(tri.end(), t.begin(), t.end());
+
+    writeArray(out, xy);
+    writeArray(out, tri);
+    writeArray(out, mLoadToModal);
+    writeArray(out, mBasis);
+    if (!out) {
+        if (error) *error = "write failed: " + path;
+        return false;
+    }
+    return true;
+}
+
+// ── StressField ──
+
+StressField::StressField(std::shared_ptr<const StressBasis> basis)
+    : mBasis(std::move(basis))
+    , mModal(mBasis->modes(), 0.0f)
+    , mSigma(3 * mBasis->nodes(), 0.0f)
+    , mVonMises(mBasis->nodes(), 0.0f)
+{}
+
+void StressField::evaluate(const WebLoads& loads) {
+    const std::size_t modes = mBasis->modes();
+    const std::size_t nodes = mBasis->nodes();
+    const std::size_t rows = 3 * nodes;
+    const auto f = loads.vector();
+
+    for (std::size_t m = 0; m < modes; ++m) {
+        const float* w = mBasis->mLoadToModal.data() + m * WebLoads::kCount;
+        float q = 0.0f;
+        for (std::size_t l = 0; l < WebLoads::kCount; ++l) q += w[l] * f[l];
+        mModal[m] = q;
+    }
+
+    // σ = Φ·q as column-wise axpy over contiguous mode columns.
+    float* sigma = mSigma.data();
+    const float* phi = mBasis->mBasis.data();
+    std::fill(sigma, sigma + rows, 0.0f);
+    for (std::size_t m = 0; m < modes; ++m, phi += rows) {
+        const float q = mModal[m];
+        for (std::size_t r = 0; r < rows; ++r) sigma[r] += phi[r] * q;
+    }
+
+    // Plane-stress von Mises: √(σx² − σx·σy + σy² + 3τ²)
+    const float* sx = sigma;
+    const float* sy = sigma + nodes;
+    const float* txy = sigma + 2 * nodes;
+    float* vm = mVonMises.data();
+    for (std::size_t n = 0; n < nodes; ++n) {
+        vm[n] = std::sqrt(sx[n] * sx[n] - sx[n] * sy[n] + sy[n] * sy[n] + 3.0f * txy[n] * txy[n]);
+    }
+    auto peak = std::max_element(mVonMises.begin(), mVonMises.end());
+    mHotspotNode = static_cast<std::size_t>(peak - mVonMises.begin());
+    mMaxVonMisesPa = *peak;
+}
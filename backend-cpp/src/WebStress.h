@@ -0,0 +1,133 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// ── Reduced-order stress field of one crank web ──
+// The web is modelled as a plane-stress stadium plate in its own rotating
+// frame: main journal centre at the origin, x along the crank arm to the pin
+// at x = throw, y in the direction of rotation. Nodes inside the journal are
+// clamped. The pin reaction is spread evenly over the nodes inside the pin.
+//
+// Offline, StressBasis::build() meshes the web with linear triangles and
+// solves one static FE load case per WebLoads component. It stacks the
+// nodal stress fields into a snapshot matrix S (3·nodes × loads) and keeps
+// the significant left singular vectors: S ≈ Φ·W. At runtime StressField
+// rebuilds every nodal σxx, σyy, τxy as Φ·(W·f), a dense column-axpy over
+// a few modes, and reduces it to von Mises stress and the hotspot.
+
+// Load vector f of the reduced model, in the web frame.
+struct WebLoads {
+    static constexpr std::size_t kCount = 3;
+
+    float pinRadialN     = 0.0f;   // force on the pin along +x (away from the journal)
+    float pinTangentialN = 0.0f;   // force on the pin along +y (direction of rotation)
+    float omega2         = 0.0f;   // ω², scales the centrifugal body load (rad²/s²)
+
+    [[nodiscard]] std::array<float, kCount> vector() const {
+        return {pinRadialN, pinTangentialN, omega2};
+    }
+};
+
+// Web dimensions and material for the offline FE model.
+struct CrankWebSpec {
+    float crankThrow      = 0.0f;   // m, journal centre to pin centre
+    float journalRadius   = 0.0f;   // m
+    float pinRadius       = 0.0f;   // m
+    float halfWidth       = 0.0f;   // m, also the radius of the rounded ends
+    float thickness       = 0.0f;   // m
+    float youngsModulusPa = 210e9f;
+    float poissonRatio    = 0.3f;
+    float densityKgM3     = 7850.0f;
+
+    template <typename Geometry>
+    static constexpr CrankWebSpec of() {
+        return {Geometry::kCrankThrow, 0.5f * Geometry::kJournalDiameter,
+                0.5f * Geometry::kPinDiameter, Geometry::kWebHalfWidth, Geometry::kWebThickness};
+    }
+
+    // Spec of a registered engine variant (EngineRegistry::kVariants).
+    static std::optional<CrankWebSpec> forVariant(std::string_view variant);
+};
+
+// Mesh density: element columns along the web and rows across it.
+struct WebMeshSize {
+    std::size_t lengthCells = 128;
+    std::size_t widthCells  = 32;
+};
+
+class StressBasis {
+public:
+    struct Node {
+        float x = 0.0f;
+        float y = 0.0f;
+    };
+
+    // Meshes and solves the web, then drops modes whose singular value is
+    // below relTolerance of the largest. Returns nullopt for a degenerate
+    // spec or mesh (no free pin nodes, too few cells).
+    static std::optional<StressBasis> build(const CrankWebSpec& spec, std::string_view variant,
+                                            WebMeshSize mesh = {}, float relTolerance = 1e-6f);
+
+    // Compact little-endian binary form; see WebStress.cpp for the layout.
+    static std::optional<StressBasis> fromFile(const std::string& path, std::string* error = nullptr);
+    bool save(const std::string& path, std::string* error = nullptr) const;
+
+    [[nodiscard]] const std::string& variant() const { return mVariant; }
+    [[nodiscard]] std::size_t nodes() const { return mNodes.size(); }
+    [[nodiscard]] std::size_t modes() const { return mModes; }
+    [[nodiscard]] const std::vector<Node>& nodePositions() const { return mNodes; }
+    [[nodiscard]] const std::vector<std::array<uint32_t, 3>>& triangles() const { return mTriangles; }
+
+    // Singular values kept by build(); empty for a basis read from file.
+    [[nodiscard]] const std::vector<float>& singularValues() const { return mSingular; }
+
+private:
+    friend class StressField;
+
+    StressBasis() = default;
+
+    std::string mVariant;
+    std::vector<Node> mNodes;
+    std::vector<std::array<uint32_t, 3>> mTriangles;
+    std::size_t mModes = 0;
+    std::vector<float> mLoadToModal;   // W, modes × WebLoads::kCount, row-major
+    // Φ, column-major: each mode is 3·nodes floats, laid out as all σxx,
+    // then all σyy, then all τxy, so reconstruction streams three arrays.
+    std::vector<float> mBasis;
+    std::vector<float> mSingular;
+};
+
+// ── Per-tick reconstruction ──
+// Owns the field buffers, so evaluate() never allocates. One instance per
+// engine; not thread-safe.
+class StressField {
+public:
+    explicit StressField(std::shared_ptr<const StressBasis> basis);
+
+    void evaluate(const WebLoads& loads);
+
+    [[nodiscard]] const StressBasis& basis() const { return *mBasis; }
+
+    // Results of the last evaluate(), per node.
+    [[nodiscard]] const float* sigmaXXPa() const { return mSigma.data(); }
+    [[nodiscard]] const float* sigmaYYPa() const { return mSigma.data() + mBasis->nodes(); }
+    [[nodiscard]] const float* tauXYPa() const { return mSigma.data() + 2 * mBasis->nodes(); }
+    [[nodiscard]] const std::vector<float>& vonMisesPa() const { return mVonMises; }
+
+    [[nodiscard]] float maxVonMisesPa() const { return mMaxVonMisesPa; }
+    [[nodiscard]] std::size_t hotspotNode() const { return mHotspotNode; }
+
+private:
+    std::shared_ptr<const StressBasis> mBasis;
+    std::vector<float> mModal;
+    std::vector<float> mSigma;
+    std::vector<float> mVonMises;
+    float mMaxVonMisesPa = 0.0f;
+    std::size_t mHotspotNode = 0;
+};
@@ -0,0 +1,234 @@
+// Offline, faster-than-real-time driver for the twin: no networking, no
+// sleeping. Steps an engine (or a fleet) through an RPM/load profile as fast
+// as the core allows, writes decimated state to CSV and reports throughput.
+//
+//   twin_batch [--profile FILE] [--loop] [--duration S] [--output FILE]
+//              [--output-hz HZ] [--physics-hz HZ] [--layout NAME]
+//              [--variant NAME] [--phase float|double|fixed32] [--fleet N]
+//              [--dynamics filter|torque] [--load-model dyno|propeller:TORQUE_NM:RPM]
+//              [--rainflow FILE]
+//
+// Without --profile the built-in ten-minute duty cycle is used. --duration
+// defaults to the profile length; with --loop the profile repeats to fill it.
+// --fleet N runs N EngineFleet twins (100 Hz, no substeps, no load input) and
+// records twin 0. --rainflow writes the run's rainflow matrices (stress, rod
+// force, torque; twin 0 for a fleet) as signal,range,mean,cycles rows.
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "EngineFleet.h"
+#include "EngineRegistry.h"
+#include "RpmProfile.h"
+
+namespace {
+
+struct Options {
+    std::string profilePath;
+    bool loop = false;
+    double durationS = 0.0;
+    std::string outputPath = "twin_batch.csv";
+    float outputHz = 10.0f;
+    float physicsRateHz = TwinEngine::kDefaultPhysicsRateHz;
+    std::string_view layout = "single";
+    std::string_view variant = DefaultGeometry::kName;
+    std::string_view phaseFormat = FloatPhase::kName;
+    std::size_t fleet = 0;
+    SpeedModel speedModel = SpeedModel::Filter;
+    LoadModel loadModel;
+    std::string rainflowPath;
+};
+
+void writeHeader(std::FILE* out) {
+    std::fputs("time_s,rpm_target,rpm,load,angle_rad,piston_force_n,rod_force_n,"
+               "tangential_force_n,torque_nm,side_thrust_n,engine_torque_nm,"
+               "engine_torque_min_nm,engine_torque_max_nm,cylinder_pressure_pa,stress_pa,"
+               "rpm_min,rpm_max,load_torque_nm\n",
+               out);
+}
+
+void writeRow(std::FILE* out, double timeS, float rpmTarget, const protocol::StatePayload& s) {
+    std::fprintf(out, "%.2f,%.1f,%.2f,%.3f,%.5f,%.2f,%.2f,%.2f,%.3f,%.2f,%.3f,%.3f,%.3f,%.0f,%.0f,"
+                      "%.2f,%.2f,%.3f\n",
+                 timeS, rpmTarget, s.rpm, s.load, s.angleRad, s.pistonForceN, s.rodForceN,
+                 s.tangentialForceN, s.torqueNm, s.sideThrustN, s.engineTorqueNm,
+                 s.engineTorqueStats.min, s.engineTorqueStats.max,
+                 s.cylinderPressurePa, s.stressPa,
+                 s.rpmStats.min, s.rpmStats.max, s.loadTorqueNm);
+}
+
+int usage() {
+    std::cerr << "usage: twin_batch [--profile FILE] [--loop] [--duration S] [--output FILE]\n"
+                 "                  [--output-hz HZ] [--physics-hz HZ] [--layout NAME]\n"
+                 "                  [--variant NAME] [--phase float|double|fixed32] [--fleet N]\n"
+                 "                  [--dynamics filter|torque] [--load-model dyno|propeller:TORQUE_NM:RPM]\n"
+                 "                  [--rainflow FILE]\n";
+    return 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg(argv[i]);
+        if (arg == "--loop") {
+            opt.loop = true;
+            continue;
+        }
+        if (i + 1 >= argc) return usage();
+        const char* value = argv[++i];
+        if (arg == "--profile") {
+            opt.profilePath = value;
+        } else if (arg == "--duration") {
+            opt.durationS = std::strtod(value, nullptr);
+        } else if (arg == "--output") {
+            opt.outputPath = value;
+        } else if (arg == "--output-hz") {
+            opt.outputHz = std::strtof(value, nullptr);
+        } else if (arg == "--physics-hz") {
+            opt.physicsRateHz = std::strtof(value, nullptr);
+        } else if (arg == "--layout") {
+            opt.layout = value;
+        } else if (arg == "--variant") {
+            opt.variant = value;
+        } else if (arg == "--phase") {
+            opt.phaseFormat = value;
+        } else if (arg == "--fleet") {
+            opt.fleet = static_cast<std::size_t>(std::strtoull(value, nullptr, 10));
+        } else if (arg == "--dynamics") {
+            auto named = speedModelFromName(value);
+            if (!named) return usage();
+            opt.speedModel = *named;
+        } else if (arg == "--load-model") {
+            auto parsed = LoadModel::parse(value);
+            if (!parsed) return usage();
+            opt.loadModel = *parsed;
+        } else if (arg == "--rainflow") {
+            opt.rainflowPath = value;
+        } else {
+            return usage();
+        }
+    }
+
+    std::optional<RpmProfile> profile = RpmProfile::dutyCycle();
+    if (!opt.profilePath.empty()) {
+        std::string error;
+        profile = RpmProfile::fromFile(opt.profilePath, &error);
+        if (!profile) {
+            std::cerr << opt.profilePath << ": " << error << "\n";
+            return 1;
+        }
+    }
+    profile->setLooping(opt.loop);
+    const double durationS = opt.durationS > 0.0 ? opt.durationS : profile->durationS();
+
+    auto layout = EngineLayout::fromName(opt.layout);
+    if (!layout) {
+        std::cerr << "Unknown layout '" << opt.layout << "' (expected single, inline4, inline6 or v8)\n";
+        return 1;
+    }
+
+    std::unique_ptr<TwinEngine> engine;
+    std::unique_ptr<EngineFleet> fleet;
+    if (opt.fleet > 0) {
+        fleet = std::make_unique<EngineFleet>(opt.fleet);
+        if (!opt.rainflowPath.empty()) fleet->enableRainflow();
+    } else {
+        engine = EngineRegistry::create(opt.variant, opt.physicsRateHz, *layout, opt.phaseFormat);
+        if (!engine) {
+            std::cerr << "Unknown variant '" << opt.variant << "' or phase format '" << opt.phaseFormat << "'\n";
+            return 1;
+        }
+        engine->setDynamics(opt.speedModel, opt.loadModel);
+        if (!opt.rainflowPath.empty()) engine->enableRainflow();
+    }
+
+    std::FILE* out = nullptr;
+    std::vector<char> outBuffer;
+    if (opt.outputHz > 0.0f) {
+        out = std::fopen(opt.outputPath.c_str(), "w");
+        if (!out) {
+            std::cerr << "cannot open " << opt.outputPath << " for writing\n";
+            return 1;
+        }
+        outBuffer.resize(1 << 20);
+        std::setvbuf(out, outBuffer.data(), _IOFBF, outBuffer.size());
+        writeHeader(out);
+    }
+
+    // Simulated time is tick count × kDt in double so a 24 h run does not drift.
+    const auto ticks = static_cast<uint64_t>(std::llround(durationS / TwinEngine::kDt));
+    const uint64_t outputEvery = opt.outputHz > 0.0f
+        ? std::max<uint64_t>(1, static_cast<uint64_t>(std::llround(1.0 / (opt.outputHz * TwinEngine::kDt))))
+        : 0;
+    const uint64_t stepsPerTick = fleet ? fleet->size() : engine->substepsPerTick();
+
+    std::size_t cursor = 0;
+    uint64_t rows = 0;
+    using clock = std::chrono::steady_clock;
+    const auto start = clock::now();
+
+    for (uint64_t tick = 0; tick < ticks; ++tick) {
+        const double timeS = static_cast<double>(tick) * TwinEngine::kDt;
+        const RpmProfile::Demand demand = profile->at(timeS, cursor);
+
+        if (fleet) {
+            fleet->setAllRpmTargets(demand.rpm);
+            fleet->step();
+        } else {
+            engine->setRpmTarget(demand.rpm);
+            engine->setLoad(demand.load);
+            engine->step();
+        }
+
+        if (out && (tick + 1) % outputEvery == 0) {
+            writeRow(out, timeS + TwinEngine::kDt, demand.rpm,
+                     fleet ? fleet->snapshot(0) : engine->snapshot());
+            ++rows;
+        }
+    }
+
+    if (out) std::fclose(out);
+    const double wallS = std::chrono::duration<double>(clock::now() - start).count();
+    const double simS = static_cast<double>(ticks) * TwinEngine::kDt;
+    const double steps = static_cast<double>(ticks) * static_cast<double>(stepsPerTick);
+
+    if (fleet) {
+        std::printf("fleet of %zu twins, 100 Hz\n", fleet->size());
+    } else {
+        std::printf("variant %.*s, layout %.*s, %.0f Hz (%u substeps per tick)\n",
+                    static_cast<int>(engine->variant().size()), engine->variant().data(),
+                    static_cast<int>(opt.layout.size()), opt.layout.data(),
+                    static_cast<double>(engine->physicsRateHz()), engine->substepsPerTick());
+    }
+    std::printf("simulated %.1f s in %.3f s wall: %.0f sim-s/wall-s\n",
+                simS, wallS, simS / wallS);
+    std::printf("%.3e steps/s\n", steps / wallS);
+    if (out) std::printf("wrote %llu rows to %s\n",
+                         static_cast<unsigned long long>(rows), opt.outputPath.c_str());
+
+    if (!opt.rainflowPath.empty()) {
+        std::array<const RainflowCounter*, kFatigueSignals> counters{};
+        for (std::size_t s = 0; s < kFatigueSignals; ++s) {
+            const auto signal = static_cast<FatigueSignal>(s);
+            counters[s] = fleet ? fleet->rainflow(0, signal) : engine->rainflow(signal);
+        }
+        if (!RainflowCounter::writeCsv(opt.rainflowPath, counters, kFatigueSignalNames)) {
+            std::cerr << "cannot open " << opt.rainflowPath << " for writing\n";
+            return 1;
+        }
+        std::printf("rainflow: %.0f stress, %.0f rod force, %.0f torque cycles to %s\n",
+                    counters[0]->cycles(), counters[1]->cycles(), counters[2]->cycles(),
+                    opt.rainflowPath.c_str());
+    }
+    return 0;
+}
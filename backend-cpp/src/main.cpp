@@ -10,13 +10,22 @@
 #include <atomic>
 #include <csignal>
 #include <array>
+#include <algorithm>
+#include <cstdlib>
+#include <optional>
+#include <vector>
+#include <filesystem>
 
 #include <boost/asio.hpp>
 #include <boost/beast.hpp>
 #include <boost/beast/websocket.hpp>
 
+#include "Checkpoint.h"
+#include "EngineRegistry.h"
 #include "PhysicsEngine.h"
 #include "Protocol.h"
+#include "SandboxPool.h"
+#include "SensorIngest.h"
 
 namespace beast = boost::beast;
 namespace ws    = beast::websocket;
@@ -40,62 +49,111 @@ static void signalHandler(int) {
 // Pre-allocate N fixed buffers; rotate on each tick. Shared ownership via
 // shared_ptr ensures the buffer outlives all async writes before reuse.
 struct BroadcastSlot {
-    std::array<char, 512> data{};
+    protocol::MessageBuffer data{};
+    std::size_t len = 0;
+};
+
+// Binary frames vary in size with speed; each slot is sized once for the
+// largest, so a queued write never sees its buffer move.
+struct FrameSlot {
+    explicit FrameSlot(std::size_t capacity = 0) : data(capacity) {}
+    std::vector<uint8_t> data;
     std::size_t len = 0;
 };
 
 static constexpr std::size_t kPoolSize = 4;
 
+template <typename Slot>
 class BroadcastPool {
 public:
-    std::shared_ptr<BroadcastSlot> next() {
+    std::shared_ptr<Slot> next() {
         auto& slot = mSlots[mIdx];
         mIdx = (mIdx + 1) % kPoolSize;
         return slot;
     }
 
-    BroadcastPool() {
-        for (auto& s : mSlots) s = std::make_shared<BroadcastSlot>();
+    template <typename... Args>
+    explicit BroadcastPool(const Args&... args) {
+        for (auto& s : mSlots) s = std::make_shared<Slot>(args...);
     }
 
 private:
-    std::array<std::shared_ptr<BroadcastSlot>, kPoolSize> mSlots;
+    std::array<std::shared_ptr<Slot>, kPoolSize> mSlots;
     std::size_t mIdx = 0;
 };
 
 // ── Per-client WebSocket session ──
 class WsSession : public std::enable_shared_from_this<WsSession> {
 public:
-    WsSession(tcp::socket socket, PhysicsEngine& engine,
-              std::set<std::shared_ptr<WsSession>>& sessions, std::mutex& sessionsMtx)
+    WsSession(tcp::socket socket, TwinEngine& engine, SensorIngest& ingest, SandboxPool* sandboxes,
+              CheckpointRequests& liveCheckpoints, std::set<std::shared_ptr<WsSession>>& sessions,
+              std::mutex& sessionsMtx)
         : mWs(std::move(socket))
         , mEngine(engine)
+        , mIngest(ingest)
+        , mSandboxes(sandboxes)
+        , mLiveCheckpoints(liveCheckpoints)
         , mSessions(sessions)
         , mSessionsMtx(sessionsMtx)
     {
         mWs.binary(false);
         mWs.text(true);
+        mTopics[static_cast<std::size_t>(protocol::Topic::State)].store(true, std::memory_order_relaxed);
     }
 
     void run(beast::http::request<beast::http::string_body> req) {
+        // Sensor feeders ask for the binary subprotocol; they send frames
+        // and do not receive the state broadcast.
+        auto offered = req[beast::http::field::sec_websocket_protocol];
+        const std::string_view offeredView(offered.data(), offered.size());
+        if (offeredView.find(protocol::kSensorSubprotocol) != std::string_view::npos) {
+            mSensorFeed = true;
+            mWs.set_option(ws::stream_base::decorator([](ws::response_type& res) {
+                res.set(beast::http::field::sec_websocket_protocol,
+                        beast::string_view(protocol::kSensorSubprotocol.data(), protocol::kSensorSubprotocol.size()));
+            }));
+            mWs.read_message_max(protocol::kSensorHeaderBytes
+                                 + protocol::kMaxSensorRecords * protocol::kSensorRecordBytes);
+        }
         mWs.async_accept(req,
             beast::bind_front_handler(&WsSession::onAccept, shared_from_this()));
     }
 
+    [[nodiscard]] bool subscribed(protocol::Topic topic) const {
+        return mTopics[static_cast<std::size_t>(topic)].load(std::memory_order_relaxed);
+    }
+
     // Zero-copy broadcast: slot is shared across all clients for this tick
     void sendShared(std::shared_ptr<BroadcastSlot> slot) {
-        net::post(mWs.get_executor(), [self = shared_from_this(), s = std::move(slot)]() {
-            self->mPendingSlots.push_back(std::move(s));
+        const net::const_buffer buffer(slot->data.data(), slot->len);
+        enqueue({std::move(slot), buffer, false});
+    }
+
+    void sendShared(std::shared_ptr<FrameSlot> slot) {
+        const net::const_buffer buffer(slot->data.data(), slot->len);
+        enqueue({std::move(slot), buffer, true});
+    }
+
+private:
+    // A queued write keeps its slot alive until it completes.
+    struct PendingWrite {
+        std::shared_ptr<const void> owner;
+        net::const_buffer buffer;
+        bool binary = false;
+    };
+
+    void enqueue(PendingWrite write) {
+        net::post(mWs.get_executor(), [self = shared_from_this(), w = std::move(write)]() mutable {
+            self->mPendingSlots.push_back(std::move(w));
             if (self->mPendingSlots.size() == 1) {
                 self->doWriteSlot();
             }
         });
     }
 
-private:
     void onAccept(beast::error_code ec) {
         if (ec) return destroy();
-        {
+        if (!mSensorFeed) {
             std::lock_guard lk(mSessionsMtx);
             mSessions.insert(shared_from_this());
         }
@@ -110,17 +168,68 @@ private:
     void onRead(beast::error_code ec, std::size_t) {
         if (ec) return destroy();
 
+        // Frames are decoded in place from the reused read buffer.
+        if (mWs.got_binary()) {
+            if (mSensorFeed) {
+                auto data = mReadBuf.data();
+                mIngest.pushFrame(static_cast<const uint8_t*>(data.data()), data.size());
+            }
+            mReadBuf.consume(mReadBuf.size());
+            return doRead();
+        }
+
         auto raw = beast::buffers_to_string(mReadBuf.data());
         mReadBuf.consume(mReadBuf.size());
 
         auto parsed = protocol::parseClientMessage(raw);
         if (parsed) {
             switch (parsed->type) {
+            // With a sandbox open, the session steers it instead of the live
+            // twin; while a fork is pending, the targets wait for it.
             case protocol::ClientMsgType::SetRpm:
-                mEngine.setRpmTarget(parsed->setRpm.rpmTarget);
+                if (mSandboxPending) mPendingRpm = parsed->setRpm.rpmTarget;
+                else (mSandbox ? *mSandbox->engine : mEngine).setRpmTarget(parsed->setRpm.rpmTarget);
+                break;
+            case protocol::ClientMsgType::SetLoad:
+                if (mSandboxPending) mPendingLoad = parsed->setLoad.load;
+                else (mSandbox ? *mSandbox->engine : mEngine).setLoad(parsed->setLoad.load);
                 break;
             case protocol::ClientMsgType::Replay:
                 break;
+            case protocol::ClientMsgType::Subscribe:
+            case protocol::ClientMsgType::Unsubscribe:
+                mTopics[static_cast<std::size_t>(parsed->subscribe.topic)].store(
+                    parsed->type == protocol::ClientMsgType::Subscribe, std::memory_order_relaxed);
+                break;
+            case protocol::ClientMsgType::CaptureArm:
+                if (BurstCapture* capture = mEngine.capture()) capture->arm(parsed->captureArm);
+                break;
+            case protocol::ClientMsgType::CaptureDisarm:
+                if (BurstCapture* capture = mEngine.capture()) capture->disarm();
+                break;
+            case protocol::ClientMsgType::CaptureGet:
+                // Copied here on the I/O thread; the physics loop never waits.
+                if (BurstCapture* capture = mEngine.capture()) {
+                    auto frame = std::make_shared<std::vector<uint8_t>>();
+                    const std::size_t len = capture->encode(parsed->captureSequence, *frame);
+                    const net::const_buffer buffer(frame->data(), len);
+                    enqueue({std::move(frame), buffer, true});
+                }
+                break;
+            case protocol::ClientMsgType::ForceQuery:
+                answerForceQuery(parsed->forceQuery);
+                break;
+            case protocol::ClientMsgType::SandboxCreate:
+                openSandbox(parsed->sandboxCreate.fromLive);
+                break;
+            case protocol::ClientMsgType::SandboxClose:
+                if (mSandbox || mSandboxPending) {
+                    protocol::SandboxInfo info{"closed", mSandbox ? mSandbox->id : 0,
+                                               mSandbox ? mSandbox->worker : 0, mSandboxFromLive};
+                    closeSandbox();
+                    reply(info);
+                }
+                break;
             default:
                 break;
             }
@@ -128,11 +237,84 @@ private:
         doRead();
     }
 
+    // A force query reads only the geometry's constants, so it is answered
+    // here on the I/O thread and the physics loop never sees it.
+    void answerForceQuery(const protocol::ForceQueryPayload& query) {
+        std::vector<protocol::ForceSample> samples(query.points.size());
+        mEngine.queryForces(query.load, query.points, samples);
+        auto frame = std::make_shared<std::vector<uint8_t>>(protocol::forceFrameBytes(samples.size()));
+        const std::size_t len = protocol::encodeForceFrame(query.load, samples.data(), samples.size(), frame->data());
+        const net::const_buffer buffer(frame->data(), len);
+        enqueue({std::move(frame), buffer, true});
+    }
+
+    // One sandbox per session; opening another replaces it. A fork of the
+    // live twin waits for the physics loop to checkpoint it between steps;
+    // the bytes come back here and are decoded on this thread. Its
+    // snapshots are serialized on the pool's worker thread into the
+    // sandbox's own slots and reach only this session.
+    void openSandbox(bool fromLive) {
+        if (!mSandboxes || mSensorFeed) return reply({"disabled", 0, 0, fromLive});
+        closeSandbox();
+        mSandboxFromLive = fromLive;
+        if (!fromLive) return startSandbox({});
+
+        mSandboxPending = true;
+        mLiveCheckpoints.request([weak = weak_from_this(), request = mSandboxRequest](
+                                     CheckpointRequests::Bytes checkpoint) {
+            auto self = weak.lock();
+            if (!self) return;
+            net::post(self->mWs.get_executor(), [self, request, checkpoint = std::move(checkpoint)] {
+                if (self->mSandboxRequest == request) self->startSandbox(*checkpoint);
+            });
+        });
+    }
+
+    void startSandbox(std::span<const uint8_t> checkpoint) {
+        mSandboxPending = false;
+        auto sink = [weak = weak_from_this(), pool = BroadcastPool<BroadcastSlot>()](
+                        const protocol::StatePayload& state) mutable {
+            auto self = weak.lock();
+            if (!self) return;
+            auto slot = pool.next();
+            slot->len = protocol::serializeState(state, slot->data, "sandbox_state");
+            if (slot->len > 0) self->sendShared(std::move(slot));
+        };
+        std::string error;
+        mSandbox = mSandboxes->create(checkpoint, std::move(sink), &error);
+        if (!mSandbox) {
+            if (error != "full") std::cerr << "Sandbox not opened: " << error << "\n";
+            return reply({error == "full" ? "full" : "failed", 0, 0, mSandboxFromLive});
+        }
+        if (mPendingRpm) mSandbox->engine->setRpmTarget(*mPendingRpm);
+        if (mPendingLoad) mSandbox->engine->setLoad(*mPendingLoad);
+        mPendingRpm.reset();
+        mPendingLoad.reset();
+        reply({"open", mSandbox->id, mSandbox->worker, mSandboxFromLive});
+    }
+
+    void closeSandbox() {
+        ++mSandboxRequest;
+        mSandboxPending = false;
+        mPendingRpm.reset();
+        mPendingLoad.reset();
+        if (!mSandbox) return;
+        mSandboxes->close(*mSandbox);
+        mSandbox.reset();
+    }
+
+    void reply(const protocol::SandboxInfo& info) {
+        auto slot = std::make_shared<BroadcastSlot>();
+        slot->len = protocol::serializeSandboxInfo(info, slot->data);
+        if (slot->len > 0) sendShared(std::move(slot));
+    }
+
     void doWriteSlot() {
         if (mPendingSlots.empty()) return;
-        auto& slot = mPendingSlots.front();
+        const PendingWrite& write = mPendingSlots.front();
+        mWs.binary(write.binary);
         mWs.async_write(
-            net::buffer(slot->data.data(), slot->len),
+            write.buffer,
             beast::bind_front_handler(&WsSession::onWriteSlot, shared_from_this()));
     }
 
@@ -143,6 +325,7 @@ private:
     }
 
     void destroy() {
+        closeSandbox();
         beast::error_code ec;
         mWs.close(ws::close_code::normal, ec);
         std::lock_guard lk(mSessionsMtx);
@@ -151,8 +334,19 @@ private:
 
     ws::stream<beast::tcp_stream> mWs;
     beast::flat_buffer mReadBuf;
-    std::deque<std::shared_ptr<BroadcastSlot>> mPendingSlots;
-    PhysicsEngine& mEngine;
+    std::deque<PendingWrite> mPendingSlots;
+    TwinEngine& mEngine;
+    SensorIngest& mIngest;
+    SandboxPool* mSandboxes;   // nullptr when the server runs without sandboxes
+    CheckpointRequests& mLiveCheckpoints;
+    std::optional<SandboxPool::Sandbox> mSandbox;
+    bool mSandboxFromLive = true;
+    bool mSandboxPending = false;   // waiting for the live twin's checkpoint
+    uint64_t mSandboxRequest = 0;   // bumped by closeSandbox(), to drop a stale checkpoint
+    std::optional<float> mPendingRpm;    // set_rpm / set_load while the fork is pending
+    std::optional<float> mPendingLoad;
+    bool mSensorFeed = false;
+    std::array<std::atomic<bool>, protocol::kTopics> mTopics{};
     std::set<std::shared_ptr<WsSession>>& mSessions;
     std::mutex& mSessionsMtx;
 };
@@ -160,10 +354,14 @@ private:
 // ── HTTP session: upgrades to WS or serves /health ──
 class HttpSession : public std::enable_shared_from_this<HttpSession> {
 public:
-    HttpSession(tcp::socket socket, PhysicsEngine& engine,
-                std::set<std::shared_ptr<WsSession>>& sessions, std::mutex& sessionsMtx)
+    HttpSession(tcp::socket socket, TwinEngine& engine, SensorIngest& ingest, SandboxPool* sandboxes,
+                CheckpointRequests& liveCheckpoints, std::set<std::shared_ptr<WsSession>>& sessions,
+                std::mutex& sessionsMtx)
         : mStream(std::move(socket))
         , mEngine(engine)
+        , mIngest(ingest)
+        , mSandboxes(sandboxes)
+        , mLiveCheckpoints(liveCheckpoints)
         , mSessions(sessions)
         , mSessionsMtx(sessionsMtx)
     {}
@@ -182,7 +380,7 @@ private:
 
         if (beast::websocket::is_upgrade(mReq)) {
             auto session = std::make_shared<WsSession>(
-                mStream.release_socket(), mEngine, mSessions, mSessionsMtx);
+                mStream.release_socket(), mEngine, mIngest, mSandboxes, mLiveCheckpoints, mSessions, mSessionsMtx);
             session->run(std::move(mReq));
             return;
         }
@@ -203,7 +401,10 @@ private:
     beast::tcp_stream mStream;
     beast::flat_buffer mBuf;
     beast::http::request<beast::http::string_body> mReq;
-    PhysicsEngine& mEngine;
+    TwinEngine& mEngine;
+    SensorIngest& mIngest;
+    SandboxPool* mSandboxes;
+    CheckpointRequests& mLiveCheckpoints;
     std::set<std::shared_ptr<WsSession>>& mSessions;
     std::mutex& mSessionsMtx;
 };
@@ -212,11 +413,15 @@ private:
 class Listener : public std::enable_shared_from_this<Listener> {
 public:
     Listener(net::io_context& ioc, tcp::endpoint ep,
-             PhysicsEngine& engine,
-             std::set<std::shared_ptr<WsSession>>& sessions, std::mutex& sessionsMtx)
+             TwinEngine& engine, SensorIngest& ingest, SandboxPool* sandboxes,
+             CheckpointRequests& liveCheckpoints, std::set<std::shared_ptr<WsSession>>& sessions,
+             std::mutex& sessionsMtx)
         : mIoc(ioc)
         , mAcceptor(net::make_strand(ioc))
         , mEngine(engine)
+        , mIngest(ingest)
+        , mSandboxes(sandboxes)
+        , mLiveCheckpoints(liveCheckpoints)
         , mSessions(sessions)
         , mSessionsMtx(sessionsMtx)
     {
@@ -239,21 +444,205 @@ private:
     void onAccept(beast::error_code ec, tcp::socket socket) {
         if (!ec) {
             std::make_shared<HttpSession>(
-                std::move(socket), mEngine, mSessions, mSessionsMtx)->run();
+                std::move(socket), mEngine, mIngest, mSandboxes, mLiveCheckpoints, mSessions, mSessionsMtx)->run();
         }
         doAccept();
     }
 
     net::io_context& mIoc;
     tcp::acceptor mAcceptor;
-    PhysicsEngine& mEngine;
+    TwinEngine& mEngine;
+    SensorIngest& mIngest;
+    SandboxPool* mSandboxes;
+    CheckpointRequests& mLiveCheckpoints;
     std::set<std::shared_ptr<WsSession>>& mSessions;
     std::mutex& mSessionsMtx;
 };
 
-int main() {
+// Comma-separated engine orders ("0.5,1,2"); "off" gives an empty list.
+static std::optional<std::vector<float>> parseOrders(const char* text) {
+    std::vector<float> orders;
+    if (std::string_view(text) == "off") return orders;
+    for (const char* at = text; *at;) {
+        char* end = nullptr;
+        const float order = std::strtof(at, &end);
+        if (end == at || !(order >= 0.0f)) return std::nullopt;
+        orders.push_back(order);
+        at = end;
+        if (*at == ',') ++at;
+        else if (*at) return std::nullopt;
+    }
+    if (orders.empty()) return std::nullopt;
+    return orders;
+}
+
+int main(int argc, char** argv) {
     std::cout << "=== Digital Twin Backend ===\n";
 
+    float physicsRateHz = TwinEngine::kDefaultPhysicsRateHz;
+    EngineLayout layout = EngineLayout::singleCylinder();
+    std::string_view variant = DefaultGeometry::kName;
+    std::string_view phaseFormat = FloatPhase::kName;
+    std::string stressBasisPath;
+    SpeedModel speedModel = SpeedModel::Filter;
+    LoadModel loadModel;
+    bool assimilate = false;
+    std::vector<float> orders(TwinEngine::kDefaultOrders.begin(), TwinEngine::kDefaultOrders.end());
+    float angleGridDeg = 1.0f;
+    std::size_t captureSamples = BurstCapture::kDefaultCapacity;
+    std::size_t maxSandboxes = 8;
+    unsigned sandboxThreads = 0;
+    std::string checkpointPath;
+    float checkpointIntervalS = 10.0f;
+    std::string rainflowPath;
+    for (int i = 1; i < argc; ++i) {
+        if (std::string_view(argv[i]) == "--assimilate") assimilate = true;
+    }
+    for (int i = 1; i + 1 < argc; ++i) {
+        std::string_view arg(argv[i]);
+        if (arg == "--physics-hz") {
+            physicsRateHz = std::strtof(argv[i + 1], nullptr);
+        } else if (arg == "--layout") {
+            auto named = EngineLayout::fromName(argv[i + 1]);
+            if (!named) {
+                std::cerr << "Unknown layout '" << argv[i + 1]
+                          << "' (expected single, inline4, inline6 or v8)\n";
+                return 1;
+            }
+            layout = *named;
+        } else if (arg == "--variant") {
+            variant = argv[i + 1];
+        } else if (arg == "--phase") {
+            phaseFormat = argv[i + 1];
+        } else if (arg == "--stress-basis") {
+            stressBasisPath = argv[i + 1];
+        } else if (arg == "--dynamics") {
+            auto named = speedModelFromName(argv[i + 1]);
+            if (!named) {
+                std::cerr << "Unknown dynamics '" << argv[i + 1] << "' (expected filter or torque)\n";
+                return 1;
+            }
+            speedModel = *named;
+        } else if (arg == "--load-model") {
+            auto parsed = LoadModel::parse(argv[i + 1]);
+            if (!parsed) {
+                std::cerr << "Bad load model '" << argv[i + 1]
+                          << "' (expected dyno or propeller:TORQUE_NM:RPM)\n";
+                return 1;
+            }
+            loadModel = *parsed;
+        } else if (arg == "--orders") {
+            auto parsed = parseOrders(argv[i + 1]);
+            if (!parsed) {
+                std::cerr << "Bad order list '" << argv[i + 1] << "' (expected e.g. 0.5,1,2 or off)\n";
+                return 1;
+            }
+            orders = std::move(*parsed);
+        } else if (arg == "--angle-grid") {
+            const std::string_view value(argv[i + 1]);
+            angleGridDeg = value == "off" ? 0.0f : std::strtof(argv[i + 1], nullptr);
+            if (value != "off" && !(angleGridDeg >= 0.1f && angleGridDeg <= 90.0f)) {
+                std::cerr << "Bad angle grid '" << value << "' (expected degrees in 0.1-90 or off)\n";
+                return 1;
+            }
+        } else if (arg == "--capture-samples") {
+            const std::string_view value(argv[i + 1]);
+            const long samples = value == "off" ? 0 : std::strtol(argv[i + 1], nullptr, 10);
+            if (value != "off" && !(samples >= 2 && samples <= (1L << 22))) {
+                std::cerr << "Bad capture size '" << value << "' (expected samples in 2-4194304 or off)\n";
+                return 1;
+            }
+            captureSamples = static_cast<std::size_t>(samples);
+        } else if (arg == "--rainflow") {
+            rainflowPath = argv[i + 1];
+        } else if (arg == "--sandboxes") {
+            const std::string_view value(argv[i + 1]);
+            const long count = value == "off" ? 0 : std::strtol(argv[i + 1], nullptr, 10);
+            if (value != "off" && !(count >= 1 && count <= 1024)) {
+                std::cerr << "Bad sandbox limit '" << value << "' (expected 1-1024 or off)\n";
+                return 1;
+            }
+            maxSandboxes = static_cast<std::size_t>(count);
+        } else if (arg == "--sandbox-threads") {
+            const long threads = std::strtol(argv[i + 1], nullptr, 10);
+            if (!(threads >= 1 && threads <= 256)) {
+                std::cerr << "Bad sandbox thread count '" << argv[i + 1] << "' (expected 1-256)\n";
+                return 1;
+            }
+            sandboxThreads = static_cast<unsigned>(threads);
+        } else if (arg == "--checkpoint") {
+            checkpointPath = argv[i + 1];
+        } else if (arg == "--checkpoint-interval") {
+            checkpointIntervalS = std::strtof(argv[i + 1], nullptr);
+            if (!(checkpointIntervalS >= 0.1f && checkpointIntervalS <= 3600.0f)) {
+                std::cerr << "Bad checkpoint interval '" << argv[i + 1] << "' (expected seconds in 0.1-3600)\n";
+                return 1;
+            }
+        }
+    }
+
+    // Engine holds the history ring buffer; keep it on the heap.
+    std::unique_ptr<TwinEngine> enginePtr = EngineRegistry::create(variant, physicsRateHz, layout, phaseFormat);
+    if (!enginePtr) {
+        auto expected = [](const auto& names) {
+            for (std::size_t k = 0; k < names.size(); ++k) {
+                std::cerr << (k == 0 ? " " : k + 1 == names.size() ? " or " : ", ") << names[k];
+            }
+        };
+        std::cerr << "Unknown variant '" << variant << "' (expected";
+        expected(EngineRegistry::kVariants);
+        std::cerr << ") or phase format '" << phaseFormat << "' (expected";
+        expected(EngineRegistry::kPhaseFormats);
+        std::cerr << ")\n";
+        return 1;
+    }
+    TwinEngine& engine = *enginePtr;
+    engine.setDynamics(speedModel, loadModel);
+    if (assimilate) engine.enableEstimator();
+    if (!orders.empty()) engine.enableOrders(orders);
+    if (angleGridDeg > 0.0f) engine.enableAngleGrid(angleGridDeg * TwinEngine::kTwoPi / 360.0f);
+    if (captureSamples > 0) engine.enableCapture(captureSamples);
+
+    if (!stressBasisPath.empty()) {
+        std::string error;
+        auto basis = StressBasis::fromFile(stressBasisPath, &error);
+        if (!basis) {
+            std::cerr << "Cannot load stress basis: " << error << "\n";
+            return 1;
+        }
+        if (basis->variant() != engine.variant()) {
+            std::cerr << "Stress basis " << stressBasisPath << " was built for variant '"
+                      << basis->variant() << "', engine is '" << engine.variant() << "'\n";
+            return 1;
+        }
+        std::cout << "Crank-web stress field: " << basis->nodes() << " nodes, "
+                  << basis->modes() << " modes\n";
+        engine.setStressBasis(std::make_shared<const StressBasis>(std::move(*basis)));
+    }
+
+    // Warm start: the checkpoint replaces the state the flags set up, its
+    // speed and load model included; the extras stay as configured.
+    std::unique_ptr<CheckpointWriter> checkpoints;
+    if (!checkpointPath.empty()) {
+        if (std::filesystem::exists(checkpointPath)) {
+            const auto start = std::chrono::steady_clock::now();
+            std::vector<uint8_t> checkpoint;
+            std::string error;
+            if (!Checkpoint::read(checkpointPath, checkpoint, &error)
+                || !engine.restoreCheckpoint(checkpoint, &error)) {
+                std::cerr << "Cannot restore checkpoint " << checkpointPath << ": " << error << "\n";
+                return 1;
+            }
+            const auto ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+            std::cout << "Restored checkpoint " << checkpointPath << " (" << checkpoint.size() << " bytes, "
+                      << engine.snapshot().rpm << " rpm, " << engine.revolutions() << " revolutions) in "
+                      << ms.count() << " ms\n";
+        }
+        checkpoints = std::make_unique<CheckpointWriter>(checkpointPath);
+    }
+    // After the warm start, so that counts restored from it carry on.
+    if (!rainflowPath.empty() && !engine.rainflow(FatigueSignal::StressPa)) engine.enableRainflow();
+
 #ifdef _WIN32
     SetConsoleCtrlHandler(consoleHandler, TRUE);
 #else
@@ -264,15 +653,26 @@ int main() {
     constexpr unsigned short kPort = 3001;
     constexpr int kBroadcastIntervalMs = 10;
 
-    PhysicsEngine engine;
     std::set<std::shared_ptr<WsSession>> sessions;
     std::mutex sessionsMtx;
+    SensorIngest ingest;
+    CheckpointRequests liveCheckpoints;   // sandbox forks of the live twin
+
+    // Sandboxes run the live twin's configuration without its extras
+    // (estimator, orders, angle grid, capture, stress field).
+    std::unique_ptr<SandboxPool> sandboxes;
+    if (maxSandboxes > 0) {
+        sandboxes = std::make_unique<SandboxPool>(
+            SandboxConfig{std::string(variant), std::string(phaseFormat), physicsRateHz, layout,
+                          speedModel, loadModel},
+            sandboxThreads, maxSandboxes);
+    }
 
     net::io_context ioc{1};
 
     auto listener = std::make_shared<Listener>(
         ioc, tcp::endpoint{net::ip::make_address("0.0.0.0"), kPort},
-        engine, sessions, sessionsMtx);
+        engine, ingest, sandboxes.get(), liveCheckpoints, sessions, sessionsMtx);
     listener->run();
 
     std::jthread ioThread([&ioc](std::stop_token) {
@@ -281,15 +681,76 @@ int main() {
 
     std::cout << "WebSocket server listening on ws://localhost:" << kPort << "\n";
     std::cout << "Health check: http://localhost:" << kPort << "/health\n";
-
-    BroadcastPool pool;
+    std::cout << "Physics rate: " << engine.physicsRateHz() << " Hz ("
+              << engine.substepsPerTick() << " substeps per tick), "
+              << engine.layout().cylinders() << " cylinder(s), variant "
+              << engine.variant() << ", " << engine.phaseFormat() << " crank phase\n";
+    if (engine.speedModel() == SpeedModel::Torque) {
+        std::cout << "Torque-driven crank speed, inertia " << engine.crankInertiaKgM2() << " kg*m^2, "
+                  << (assimilate ? "estimated load"
+                      : loadModel.kind == LoadModel::Kind::Dyno ? "dyno load" : "propeller load") << "\n";
+    }
+    std::cout << "Sensor frames: subprotocol " << protocol::kSensorSubprotocol
+              << (assimilate ? ", assimilated by the estimator\n" : ", drained (start with --assimilate to use them)\n");
+    if (const OrderTracker* tracked = engine.orders(OrderSignal::EngineTorqueNm)) {
+        std::cout << "Engine orders:";
+        for (std::size_t k = 0; k < tracked->orders(); ++k) std::cout << " " << tracked->order(k);
+        std::cout << " (subscribe to \"orders\")\n";
+    }
+    if (const CrankAngleGrid* grid = engine.angleGrid()) {
+        std::cout << "Crank-angle grid: " << grid->stepRad() * 360.0f / TwinEngine::kTwoPi
+                  << " deg, up to " << grid->capacity() << " points per tick (subscribe to \"angle\")\n";
+    }
+    if (const BurstCapture* capture = engine.capture()) {
+        std::cout << "Burst capture: up to " << capture->capacity() << " substeps ("
+                  << static_cast<float>(capture->capacity()) * capture->dtS() * 1000.0f
+                  << " ms) per capture, " << BurstCapture::kSlots << " kept (subscribe to \"capture\")\n";
+    }
+    if (!rainflowPath.empty()) {
+        std::cout << "Rainflow: stress, rod force and torque cycles to " << rainflowPath << " at shutdown\n";
+    }
+    if (sandboxes) {
+        std::cout << "Sandboxes: up to " << sandboxes->capacity() << " on " << sandboxes->threads()
+                  << " worker thread(s) (send sandbox_create)\n";
+    }
+    if (checkpoints) {
+        std::cout << "Checkpoints: " << checkpointPath << " every " << checkpointIntervalS
+                  << " s and at shutdown\n";
+    }
+    std::cout << "Crankshaft torsional modes: " << engine.torsion().naturalFrequenciesHz()[0]
+              << ", " << engine.torsion().naturalFrequenciesHz()[1] << " Hz\n";
+
+    BroadcastPool<BroadcastSlot> pool;
+    BroadcastPool<BroadcastSlot> ordersPool;
+    BroadcastPool<BroadcastSlot> revolutionsPool;
+    BroadcastPool<FrameSlot> anglePool(
+        engine.angleGrid() ? protocol::angleFrameBytes(engine.angleGrid()->capacity()) : 0);
+    BroadcastPool<BroadcastSlot> capturePool;
+    uint64_t lastRevolutions = 0;
+    uint64_t lastCapture = 0;
     auto lastLogTime = std::chrono::steady_clock::now();
     unsigned broadcastCount = 0;
+    uint64_t lastSensorCount = 0;
+    std::chrono::microseconds maxStepTime{0};
+    const auto checkpointInterval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<float>(checkpointIntervalS));
+    auto nextCheckpoint = std::chrono::steady_clock::now() + checkpointInterval;
 
     while (gRunning.load(std::memory_order_relaxed)) {
         auto tickStart = std::chrono::steady_clock::now();
 
         engine.step();
+        engine.assimilate(ingest.drainTick(TwinEngine::kDt));
+        maxStepTime = std::max(maxStepTime, std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - tickStart));
+
+        // Encoded here between steps; decoded on the I/O thread, or written
+        // on the writer's thread.
+        liveCheckpoints.serve(engine);
+        if (checkpoints && tickStart >= nextCheckpoint) {
+            checkpoints->offer(engine);
+            nextCheckpoint = tickStart + checkpointInterval;
+        }
 
         // Serialize once into the next pool slot; shared_ptr keeps it alive
         // until all async writes complete — no per-client heap allocation.
@@ -300,11 +761,66 @@ int main() {
         if (slot->len > 0) {
             std::lock_guard lk(sessionsMtx);
             for (auto& s : sessions) {
-                s->sendShared(slot);
+                if (s->subscribed(protocol::Topic::State)) s->sendShared(slot);
             }
             ++broadcastCount;
         }
 
+        // Order spectra go only to the sessions that subscribed.
+        if (engine.orders(OrderSignal::EngineTorqueNm)) {
+            auto ordersSlot = ordersPool.next();
+            ordersSlot->len = protocol::serializeOrders(engine.ordersSnapshot(), ordersSlot->data);
+            if (ordersSlot->len > 0) {
+                std::lock_guard lk(sessionsMtx);
+                for (auto& s : sessions) {
+                    if (s->subscribed(protocol::Topic::Orders)) s->sendShared(ordersSlot);
+                }
+            }
+        }
+
+        // Revolution summaries completed during this tick, in one message.
+        if (const uint64_t revolutions = engine.revolutions(); revolutions > lastRevolutions) {
+            const auto& history = engine.revolutionHistory();
+            const std::size_t fresh = static_cast<std::size_t>(std::min<uint64_t>(
+                {revolutions - lastRevolutions, history.size(), protocol::kMaxRevolutionsPerMessage}));
+            std::array<protocol::RevolutionPayload, protocol::kMaxRevolutionsPerMessage> records;
+            for (std::size_t r = 0; r < fresh; ++r) records[r] = history.at(history.size() - fresh + r);
+            lastRevolutions = revolutions;
+
+            auto revolutionsSlot = revolutionsPool.next();
+            revolutionsSlot->len = protocol::serializeRevolutions(records.data(), fresh, revolutionsSlot->data);
+            if (revolutionsSlot->len > 0) {
+                std::lock_guard lk(sessionsMtx);
+                for (auto& s : sessions) {
+                    if (s->subscribed(protocol::Topic::Revolutions)) s->sendShared(revolutionsSlot);
+                }
+            }
+        }
+
+        // The tick's crank-angle grid samples as one binary frame.
+        if (const auto samples = engine.angleSamples(); !samples.empty()) {
+            auto angleSlot = anglePool.next();
+            angleSlot->len = protocol::encodeAngleFrame(state.timestampMs, samples.data(), samples.size(),
+                                                        angleSlot->data.data());
+            std::lock_guard lk(sessionsMtx);
+            for (auto& s : sessions) {
+                if (s->subscribed(protocol::Topic::Angle)) s->sendShared(angleSlot);
+            }
+        }
+
+        // Announce a completed capture; clients fetch it with capture_get.
+        if (const BurstCapture* capture = engine.capture(); capture && capture->completed() > lastCapture) {
+            lastCapture = capture->completed();
+            auto captureSlot = capturePool.next();
+            captureSlot->len = protocol::serializeCaptureInfo(capture->latest(), captureSlot->data);
+            if (captureSlot->len > 0) {
+                std::lock_guard lk(sessionsMtx);
+                for (auto& s : sessions) {
+                    if (s->subscribed(protocol::Topic::Capture)) s->sendShared(captureSlot);
+                }
+            }
+        }
+
         auto now = std::chrono::steady_clock::now();
         auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - lastLogTime).count();
         if (elapsed >= 2) {
@@ -314,10 +830,41 @@ int main() {
                 clientCount = sessions.size();
             }
             double rate = static_cast<double>(broadcastCount) / static_cast<double>(elapsed);
+            const uint64_t sensorCount = ingest.received();
+            double sensorRate = static_cast<double>(sensorCount - lastSensorCount) / static_cast<double>(elapsed);
             std::cout << "[stats] clients=" << clientCount
                       << " broadcast_rate=" << rate << " Hz"
-                      << " rpm=" << state.rpm << "\n";
+                      << " rpm=" << state.rpm
+                      << " max_step_us=" << maxStepTime.count()
+                      << " sensor_rate=" << sensorRate << " Hz"
+                      << " dropped=" << ingest.dropped()
+                      << " malformed=" << ingest.malformed();
+            if (const CrankEstimator* estimator = engine.estimator()) {
+                std::cout << " nis=";
+                for (std::size_t k = 0; k < SensorSample::kKinds; ++k) {
+                    std::cout << (k ? "/" : "") << estimator->stats(static_cast<SensorSample::Kind>(k)).meanNis();
+                }
+            }
+            if (sandboxes) {
+                const SandboxPool::TickStats tick = sandboxes->takeTickStats();
+                std::cout << " sandboxes=" << sandboxes->size()
+                          << " sandbox_tick_us=" << tick.maxTick.count()
+                          << " sandbox_overruns=" << tick.overruns;
+            }
+            if (checkpoints) {
+                std::cout << " checkpoints=" << checkpoints->written()
+                          << " checkpoint_bytes=" << checkpoints->bytes()
+                          << " checkpoint_encode_us=" << checkpoints->encodeUs()
+                          << " checkpoint_write_us=" << checkpoints->writeUs();
+                if (checkpoints->failed() + checkpoints->skipped() > 0) {
+                    std::cout << " checkpoint_failed=" << checkpoints->failed()
+                              << " checkpoint_skipped=" << checkpoints->skipped();
+                }
+            }
+            std::cout << "\n";
+            lastSensorCount = sensorCount;
             broadcastCount = 0;
+            maxStepTime = std::chrono::microseconds{0};
             lastLogTime = now;
         }
 
@@ -330,6 +877,27 @@ int main() {
     }
 
     std::cout << "\nShutting down...\n";
+    sandboxes.reset();   // joins the workers while their sinks can still post
+    if (checkpoints) {
+        std::string error;
+        if (checkpoints->flush(engine, &error)) {
+            std::cout << "Checkpoint written to " << checkpointPath << " (" << checkpoints->bytes() << " bytes)\n";
+        } else {
+            std::cerr << "Checkpoint not written: " << error << "\n";
+        }
+    }
+    if (!rainflowPath.empty()) {
+        std::array<const RainflowCounter*, kFatigueSignals> counters{};
+        for (std::size_t s = 0; s < kFatigueSignals; ++s) {
+            counters[s] = engine.rainflow(static_cast<FatigueSignal>(s));
+        }
+        if (RainflowCounter::writeCsv(rainflowPath, counters, kFatigueSignalNames)) {
+            std::cout << "Rainflow: " << counters[0]->cycles() << " stress, " << counters[1]->cycles()
+                      << " rod force, " << counters[2]->cycles() << " torque cycles to " << rainflowPath << "\n";
+        } else {
+            std::cerr << "Rainflow not written: cannot open " << rainflowPath << "\n";
+        }
+    }
     ioc.stop();
     ioThread.join();
     std::cout << "Clean exit.\n";
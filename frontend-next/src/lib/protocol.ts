@@ -1,5 +1,8 @@
 // ── Protocol types mirroring backend Protocol.h ──
 
+// [min, max, mean] of a force over the physics substeps of one broadcast tick
+export type ForceStats = [number, number, number];
+
 export interface StatePayload {
   rpm: number;
   angle_rad: number;
@@ -11,6 +14,34 @@ export interface StatePayload {
   torque_nm: number;
   side_thrust_n: number;
   timestamp_ms: number;
+  load?: number;
+  cylinder_pressure_pa?: number;
+  engine_torque_nm?: number;
+  shaking_force_n?: [number, number];
+  // [min, max, mean] crank speed over the tick; load model torque
+  rpm_stats?: ForceStats;
+  load_torque_nm?: number;
+  force_stats?: {
+    piston_force_n: ForceStats;
+    rod_force_n: ForceStats;
+    tangential_force_n: ForceStats;
+    torque_nm: ForceStats;
+    side_thrust_n: ForceStats;
+    engine_torque_nm: ForceStats;
+  };
+  // Crankshaft sections pulley → throws → flywheel; twist and journal shear
+  // stress at end of tick, peak shear over the tick
+  torsion?: {
+    twist_rad: number[];
+    shear_pa: number[];
+    max_shear_pa: number;
+  };
+  // Cylinder 1 crank-web peak von Mises stress and its mesh node; only with
+  // a stress basis loaded on the server
+  web_stress?: {
+    max_pa: number;
+    hotspot_node: number;
+  };
 }
 
 export interface StateMessage {
@@ -27,6 +58,15 @@ export interface SetRpmMessage {
   payload: SetRpmPayload;
 }
 
+export interface SetLoadPayload {
+  load: number;
+}
+
+export interface SetLoadMessage {
+  type: 'set_load';
+  payload: SetLoadPayload;
+}
+
 export interface ReplayPayload {
   mode: 'live' | 'freeze' | 'seek';
   t_ms?: number;
@@ -37,8 +77,240 @@ export interface ReplayMessage {
   payload: ReplayPayload;
 }
 
-export type ServerMessage = StateMessage;
-export type ClientMessage = SetRpmMessage | ReplayMessage;
+// ── Subscriptions ──
+// A new connection receives `state` only; binary topics arrive as
+// ArrayBuffer frames (decodeAngleFrame, decodeCaptureFrame).
+export type Topic = 'state' | 'orders' | 'revolutions' | 'angle' | 'capture';
+
+export interface SubscribeMessage {
+  type: 'subscribe' | 'unsubscribe';
+  payload: { topic: Topic };
+}
+
+// ── Engine orders (topic "orders") ──
+// x(φ) ≈ Σ amplitude·cos(order·φ + phase) over the last four-stroke cycle,
+// φ from cylinder 1's firing TDC
+export interface OrderSpectrum {
+  amplitude: number[];
+  phase_rad: number[];
+}
+
+export interface OrdersPayload {
+  timestamp_ms: number;
+  rpm: number;
+  ready: boolean;
+  orders: number[];
+  torque_nm: OrderSpectrum;
+  side_thrust_n: OrderSpectrum;
+}
+
+export interface OrdersMessage {
+  type: 'orders';
+  payload: OrdersPayload;
+}
+
+// ── Revolution summaries (topic "revolutions") ──
+// Whole-engine torque; cylinder 1's peak rod compression and |side thrust|
+export interface RevolutionSummary {
+  index: number;
+  timestamp_ms: number;
+  duration_s: number;
+  rpm: number;
+  torque_nm: { mean: number; rms: number; peak: number };
+  rod_force_max_n: number;
+  side_thrust_max_n: number;
+}
+
+export interface RevolutionsMessage {
+  type: 'revolutions';
+  payload: RevolutionSummary[];
+}
+
+// ── Burst captures (topic "capture") ──
+export type CaptureSignal =
+  | 'cylinder_pressure'
+  | 'piston_force'
+  | 'rod_force'
+  | 'tangential_force'
+  | 'torque'
+  | 'side_thrust'
+  | 'engine_torque'
+  | 'stress'
+  | 'shear_stress';
+export type CaptureKind = 'level' | 'slope' | 'rpm_band';
+
+export interface CaptureArmPayload {
+  kind?: CaptureKind;
+  edge?: 'rising' | 'falling' | 'either';
+  signal?: CaptureSignal;   // not for rpm_band
+  threshold?: number;       // not for rpm_band; units/s for slope
+  rpm_min?: number;
+  rpm_max?: number;
+  pre_samples?: number;
+  post_samples?: number;
+  rearm?: boolean;
+}
+
+export interface CaptureArmMessage {
+  type: 'capture_arm';
+  payload: CaptureArmPayload;
+}
+
+export interface CaptureDisarmMessage {
+  type: 'capture_disarm';
+}
+
+// sequence 0 or omitted: the newest capture
+export interface CaptureGetMessage {
+  type: 'capture_get';
+  payload?: { sequence: number };
+}
+
+export interface CaptureInfoPayload {
+  sequence: number;
+  timestamp_ms: number;
+  samples: number;
+  trigger_index: number;
+  dt_s: number;
+  signal: CaptureSignal | 'rpm';
+  kind: CaptureKind;
+  trigger_value: number;
+  rpm: number;
+}
+
+export interface CaptureInfoMessage {
+  type: 'capture';
+  payload: CaptureInfoPayload;
+}
+
+// ── Sandbox twins ──
+export interface SandboxCreateMessage {
+  type: 'sandbox_create';
+  payload?: { from: 'live' | 'fresh' };
+}
+
+export interface SandboxCloseMessage {
+  type: 'sandbox_close';
+}
+
+export interface SandboxInfoPayload {
+  status: 'open' | 'closed' | 'full' | 'failed' | 'disabled';
+  id: number;
+  worker: number;
+  from: 'live' | 'fresh';
+}
+
+export interface SandboxInfoMessage {
+  type: 'sandbox';
+  payload: SandboxInfoPayload;
+}
+
+// The open sandbox's state, to its own session only
+export interface SandboxStateMessage {
+  type: 'sandbox_state';
+  payload: StatePayload;
+}
+
+// ── Force queries ──
+// Forces at arbitrary (rpm, cycle angle) points, answered by one binary
+// frame (decodeForceFrame); rpm and cycle_angle_rad are parallel, 1–4096 points
+export interface ForceQueryPayload {
+  load?: number;
+  rpm: number[];
+  cycle_angle_rad: number[];
+}
+
+export interface ForceQueryMessage {
+  type: 'force_query';
+  payload: ForceQueryPayload;
+}
+
+export type ServerMessage =
+  | StateMessage
+  | OrdersMessage
+  | RevolutionsMessage
+  | CaptureInfoMessage
+  | SandboxInfoMessage
+  | SandboxStateMessage;
+export type ClientMessage =
+  | SetRpmMessage
+  | SetLoadMessage
+  | ReplayMessage
+  | SubscribeMessage
+  | CaptureArmMessage
+  | CaptureDisarmMessage
+  | CaptureGetMessage
+  | SandboxCreateMessage
+  | SandboxCloseMessage
+  | ForceQueryMessage;
+
+// ── Binary frames (little-endian) ──
+
+// One grid point of a crank-angle frame; forces are cylinder 1 except
+// engine_torque_nm, time_s is from the start of the tick
+export interface AngleSample {
+  time_s: number;
+  cycle_angle_rad: number;
+  omega_rad_s: number;
+  cylinder_pressure_pa: number;
+  piston_force_n: number;
+  rod_force_n: number;
+  tangential_force_n: number;
+  torque_nm: number;
+  side_thrust_n: number;
+  engine_torque_nm: number;
+}
+
+export interface AngleFrame {
+  timestamp_ms: number;
+  samples: AngleSample[];
+}
+
+// One physics substep of a capture; record i lies (i − trigger_index)·dt_s
+// from the trigger
+export interface CaptureSample {
+  cycle_angle_rad: number;
+  omega_rad_s: number;
+  cylinder_pressure_pa: number;
+  piston_force_n: number;
+  rod_force_n: number;
+  tangential_force_n: number;
+  torque_nm: number;
+  side_thrust_n: number;
+  engine_torque_nm: number;
+  stress_pa: number;
+  shear_stress_pa: number;
+}
+
+export interface CaptureFrame {
+  signal: number;   // index into CaptureSignal's order
+  kind: number;     // index into CaptureKind's order
+  trigger_index: number;
+  sequence: number;
+  timestamp_ms: number;
+  dt_s: number;
+  trigger_value: number;
+  samples: CaptureSample[];   // empty for an unknown or overwritten sequence
+}
+
+// One point of a force query reply, in request order; forces are cylinder 1
+// except engine_torque_nm
+export interface ForceSample {
+  rpm: number;
+  cycle_angle_rad: number;
+  cylinder_pressure_pa: number;
+  piston_force_n: number;
+  rod_force_n: number;
+  tangential_force_n: number;
+  torque_nm: number;
+  side_thrust_n: number;
+  engine_torque_nm: number;
+}
+
+export interface ForceFrame {
+  load: number;
+  samples: ForceSample[];
+}
 
 // ── Type guards ──
 
@@ -65,6 +337,91 @@ export function isStateMessage(msg: unknown): msg is StateMessage {
   return true;
 }
 
+export function isServerMessage<T extends ServerMessage['type']>(
+  msg: unknown,
+  type: T,
+): msg is Extract<ServerMessage, { type: T }> {
+  if (typeof msg !== 'object' || msg === null) return false;
+  const m = msg as Record<string, unknown>;
+  return m.type === type && typeof m.payload === 'object' && m.payload !== null;
+}
+
+const kAngleFrameMagic = 0x46415754;     // "TWAF"
+const kCaptureFrameMagic = 0x46435754;   // "TWCF"
+const kForceFrameMagic = 0x51465754;     // "TWFQ"
+
+function readRecords<T>(view: DataView, offset: number, count: number, fields: readonly (keyof T)[]): T[] {
+  const records: T[] = [];
+  for (let i = 0; i < count; ++i) {
+    const record = {} as Record<keyof T, number>;
+    fields.forEach((field, k) => {
+      record[field] = view.getFloat32(offset + (i * fields.length + k) * 4, true);
+    });
+    records.push(record as unknown as T);
+  }
+  return records;
+}
+
+const kAngleFields: readonly (keyof AngleSample)[] = [
+  'time_s', 'cycle_angle_rad', 'omega_rad_s', 'cylinder_pressure_pa', 'piston_force_n',
+  'rod_force_n', 'tangential_force_n', 'torque_nm', 'side_thrust_n', 'engine_torque_nm',
+];
+
+const kCaptureFields: readonly (keyof CaptureSample)[] = [
+  'cycle_angle_rad', 'omega_rad_s', 'cylinder_pressure_pa', 'piston_force_n', 'rod_force_n',
+  'tangential_force_n', 'torque_nm', 'side_thrust_n', 'engine_torque_nm', 'stress_pa', 'shear_stress_pa',
+];
+
+const kForceFields: readonly (keyof ForceSample)[] = [
+  'rpm', 'cycle_angle_rad', 'cylinder_pressure_pa', 'piston_force_n', 'rod_force_n',
+  'tangential_force_n', 'torque_nm', 'side_thrust_n', 'engine_torque_nm',
+];
+
+// null for anything that is not a version-1 angle frame
+export function decodeAngleFrame(buffer: ArrayBuffer): AngleFrame | null {
+  if (buffer.byteLength < 16) return null;
+  const view = new DataView(buffer);
+  if (view.getUint32(0, true) !== kAngleFrameMagic || view.getUint16(4, true) !== 1) return null;
+  const count = view.getUint16(6, true);
+  if (buffer.byteLength < 16 + count * 40) return null;
+  return {
+    timestamp_ms: Number(view.getBigUint64(8, true)),
+    samples: readRecords<AngleSample>(view, 16, count, kAngleFields),
+  };
+}
+
+// null for anything that is not a version-1 capture frame
+export function decodeCaptureFrame(buffer: ArrayBuffer): CaptureFrame | null {
+  if (buffer.byteLength < 40) return null;
+  const view = new DataView(buffer);
+  if (view.getUint32(0, true) !== kCaptureFrameMagic || view.getUint16(4, true) !== 1) return null;
+  const count = view.getUint32(8, true);
+  if (buffer.byteLength < 40 + count * 44) return null;
+  return {
+    signal: view.getUint8(6),
+    kind: view.getUint8(7),
+    trigger_index: view.getUint32(12, true),
+    sequence: Number(view.getBigUint64(16, true)),
+    timestamp_ms: Number(view.getBigUint64(24, true)),
+    dt_s: view.getFloat32(32, true),
+    trigger_value: view.getFloat32(36, true),
+    samples: readRecords<CaptureSample>(view, 40, count, kCaptureFields),
+  };
+}
+
+// null for anything that is not a version-1 force query reply
+export function decodeForceFrame(buffer: ArrayBuffer): ForceFrame | null {
+  if (buffer.byteLength < 12) return null;
+  const view = new DataView(buffer);
+  if (view.getUint32(0, true) !== kForceFrameMagic || view.getUint16(4, true) !== 1) return null;
+  const count = view.getUint16(6, true);
+  if (buffer.byteLength < 12 + count * 36) return null;
+  return {
+    load: view.getFloat32(8, true),
+    samples: readRecords<ForceSample>(view, 12, count, kForceFields),
+  };
+}
+
 export function serializeSetRpm(rpmTarget: number): string {
   return JSON.stringify({
     type: 'set_rpm',
@@ -72,9 +429,44 @@ export function serializeSetRpm(rpmTarget: number): string {
   });
 }
 
+export function serializeSetLoad(load: number): string {
+  return JSON.stringify({
+    type: 'set_load',
+    payload: { load: Math.max(0, Math.min(1, load)) },
+  });
+}
+
 export function serializeReplay(mode: ReplayPayload['mode'], tMs?: number): string {
   return JSON.stringify({
     type: 'replay',
     payload: { mode, ...(tMs !== undefined ? { t_ms: tMs } : {}) },
   });
 }
+
+export function serializeSubscribe(topic: Topic, subscribe = true): string {
+  return JSON.stringify({ type: subscribe ? 'subscribe' : 'unsubscribe', payload: { topic } });
+}
+
+export function serializeCaptureArm(payload: CaptureArmPayload): string {
+  return JSON.stringify({ type: 'capture_arm', payload });
+}
+
+export function serializeCaptureDisarm(): string {
+  return JSON.stringify({ type: 'capture_disarm' });
+}
+
+export function serializeCaptureGet(sequence = 0): string {
+  return JSON.stringify({ type: 'capture_get', payload: { sequence } });
+}
+
+export function serializeSandboxCreate(from: 'live' | 'fresh' = 'live'): string {
+  return JSON.stringify({ type: 'sandbox_create', payload: { from } });
+}
+
+export function serializeSandboxClose(): string {
+  return JSON.stringify({ type: 'sandbox_close' });
+}
+
+export function serializeForceQuery(payload: ForceQueryPayload): string {
+  return JSON.stringify({ type: 'force_query', payload });
+}